@@ -0,0 +1,33 @@
+/**
+ * @file	bench_abstract_class_finder.cpp
+ * @brief	Benchmarks finding the abstract class within the synthetic projects of growing size.
+ */
+#include <benchmark/benchmark.h>
+
+#include "abstract_class_finder/finder.hpp"
+#include "compilation_database_cache.hpp"
+
+#include "synthetic_codebase.hpp"
+
+using namespace Tsepepe::Benchmarks;
+
+#ifdef TSEPEPE_RIPGREP
+//! Each of the concrete classes with the same name as the searched interface is parsed, to find out that it is not
+//! abstract.
+static void BM_find_abstract_class(benchmark::State& state)
+{
+    const auto& codebase{get_synthetic_codebase({.files_count = static_cast<unsigned>(state.range(0)),
+                                                 .interfaces_count = 4,
+                                                 .inheritance_depth = 4,
+                                                 .name_collisions_count = static_cast<unsigned>(state.range(1))})};
+    Tsepepe::AbstractClassFinder::Input input{
+        .compilation_database_ptr = Tsepepe::utils::clang_ast::load_cached_compilation_database(codebase.root),
+        .project_root = codebase.root,
+        .class_name = codebase.searched_interface_name};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Tsepepe::AbstractClassFinder::find(input));
+}
+BENCHMARK(BM_find_abstract_class)
+    ->ArgsProduct({{1000, 10000, 50000}, {0, 10, 100}})
+    ->Unit(benchmark::kMillisecond);
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file	bench_class_index.cpp
+ * @brief	Benchmarks the class index lookup and persistence.
+ */
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "class_index.hpp"
+#include "directory_tree.hpp"
+
+using namespace Tsepepe;
+
+namespace fs = std::filesystem;
+
+static constexpr unsigned classes_per_file{10};
+
+static ClassIndex make_index(const fs::path& root, unsigned files_count)
+{
+    ClassIndex index{root};
+    for (unsigned i{0}; i < files_count; ++i)
+    {
+        std::vector<ClassIndexEntry> entries;
+        for (unsigned j{0}; j < classes_per_file; ++j)
+        {
+            auto name{"Class" + std::to_string(i * classes_per_file + j)};
+            entries.emplace_back(ClassIndexEntry{.name = name,
+                                                 .fully_qualified_name = "project::" + name,
+                                                 .offset = j * 100,
+                                                 .is_abstract = j % 2 == 0});
+        }
+        index.update_file(root / "src" / ("file" + std::to_string(i) + ".hpp"),
+                          FileStamp{.modification_time = i, .size = i},
+                          std::move(entries));
+    }
+    return index;
+}
+
+static void BM_class_index_find(benchmark::State& state)
+{
+    auto files_count{static_cast<unsigned>(state.range(0))};
+    auto index{make_index("/project", files_count)};
+
+    unsigned i{0};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(index.find("Class" + std::to_string(i++ % (files_count * classes_per_file))));
+}
+BENCHMARK(BM_class_index_find)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_class_index_save_and_load(benchmark::State& state)
+{
+    DirectoryTree tree{fs::temp_directory_path() / "tsepepe_bench_class_index"};
+    auto root{tree.get_root_absolute_path()};
+    auto index{make_index(root, static_cast<unsigned>(state.range(0)))};
+
+    for (auto _ : state)
+    {
+        index.save();
+        benchmark::DoNotOptimize(ClassIndex::load(root));
+    }
+}
+BENCHMARK(BM_class_index_save_and_load)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+/**
+ * @file	bench_code_actions.cpp
+ * @brief	Benchmarks the code actions end to end.
+ */
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "generate_function_definitions_code_action.hpp"
+#include "implement_interface_code_action.hpp"
+
+#include "parsed_synthetic_header.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+namespace fs = std::filesystem;
+
+static SyntheticHeaderParameters make_parameters(const benchmark::State& state)
+{
+    return {.methods_count = static_cast<unsigned>(state.range(0)),
+            .namespace_depth = 4,
+            .includes_count = static_cast<unsigned>(state.range(1))};
+}
+
+//! Generates the definitions for all the methods of the class. With the action kept alive between the invocations,
+//! the same way as the daemon does it, only the first invocation parses the included headers.
+static void generate_function_definitions(benchmark::State& state, bool is_action_kept_alive)
+{
+    auto parameters{make_parameters(state)};
+    DirectoryTree tree{fs::temp_directory_path() / "tsepepe_bench_generate_function_definitions"};
+    auto path{create_synthetic_header(tree, parameters)};
+    auto header{make_synthetic_header(parameters)};
+    auto compilation_database{make_synthetic_compilation_database()};
+
+    auto action{std::make_unique<GenerateFunctionDefinitionsCodeActionLibclangBased>(compilation_database)};
+    for (auto _ : state)
+    {
+        if (not is_action_kept_alive)
+            action = std::make_unique<GenerateFunctionDefinitionsCodeActionLibclangBased>(compilation_database);
+        benchmark::DoNotOptimize(action->apply({.source_file_path = path,
+                                                .source_file_content = header.content,
+                                                .selected_line_begin = header.first_method_line,
+                                                .selected_line_end = header.last_method_line}));
+    }
+}
+
+static void BM_generate_function_definitions(benchmark::State& state)
+{
+    generate_function_definitions(state, false);
+}
+BENCHMARK(BM_generate_function_definitions)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {0, 100}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_generate_function_definitions_repeatedly(benchmark::State& state)
+{
+    generate_function_definitions(state, true);
+}
+BENCHMARK(BM_generate_function_definitions_repeatedly)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {0, 100}})
+    ->Unit(benchmark::kMillisecond);
+
+//! Makes an empty class implement the interface with the methods count of pure virtual methods.
+static void BM_implement_interface(benchmark::State& state)
+{
+    auto parameters{make_parameters(state)};
+    DirectoryTree tree{fs::temp_directory_path() / "tsepepe_bench_implement_interface"};
+    create_synthetic_header(tree, parameters);
+    auto root{tree.get_root_absolute_path()};
+    std::string implementor{"#include \"synthetic.hpp\"\n\nclass Implementor\n{\n};\n"};
+    auto compilation_database{make_synthetic_compilation_database()};
+
+    for (auto _ : state)
+    {
+        ImplementIntefaceCodeActionLibclangBased action{compilation_database};
+        benchmark::DoNotOptimize(action.apply({.root_directory = root,
+                                               .source_file_path = root / "implementor.hpp",
+                                               .source_file_content = implementor,
+                                               .inteface_name = "Interface",
+                                               .cursor_position_line = 4}));
+    }
+}
+BENCHMARK(BM_implement_interface)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {0, 100}})
+    ->Unit(benchmark::kMillisecond);
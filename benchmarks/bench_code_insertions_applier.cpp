@@ -0,0 +1,31 @@
+/**
+ * @file	bench_code_insertions_applier.cpp
+ * @brief	Benchmarks applying the code insertions.
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "code_insertions_applier.hpp"
+#include "synthetic_sources.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+//! Appends a comment to each line of the header.
+static void BM_apply_insertions(benchmark::State& state)
+{
+    auto header{make_synthetic_header({.methods_count = static_cast<unsigned>(state.range(0))})};
+
+    std::vector<CodeInsertionByOffset> insertions;
+    for (auto offset{header.content.find('\n')}; offset != std::string::npos;
+         offset = header.content.find('\n', offset + 1))
+        insertions.emplace_back(CodeInsertionByOffset{.code = " // Comment", .offset = static_cast<unsigned>(offset)});
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(apply_insertions(header.content, insertions));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+BENCHMARK(BM_apply_insertions)->RangeMultiplier(10)->Range(10, 10000);
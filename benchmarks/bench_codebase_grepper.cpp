@@ -0,0 +1,91 @@
+/**
+ * @file	bench_codebase_grepper.cpp
+ * @brief	Benchmarks the codebase grepping against spawning ripgrep.
+ */
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#ifdef TSEPEPE_RIPGREP
+#include <boost/process.hpp>
+#endif
+
+#include "codebase_grepper.hpp"
+#include "directory_tree.hpp"
+
+namespace fs = std::filesystem;
+
+//! Every that many files contains the searched class definition.
+static constexpr unsigned file_with_match_interval{100};
+static constexpr unsigned files_per_directory{50};
+static constexpr const char* pattern{"\\b(struct|class)\\s+Symbol\\b"};
+
+static std::string make_file_content(unsigned file_index)
+{
+    std::string content{"#include <vector>\n\nnamespace project\n{\n\n"};
+    for (unsigned i{0}; i < 20; ++i)
+    {
+        auto name{"Class" + std::to_string(file_index) + "_" + std::to_string(i)};
+        content += "struct " + name + "\n{\n    void method(int a, std::vector<int> b);\n    int member;\n};\n\n";
+    }
+    if (file_index % file_with_match_interval == 0)
+        content += "class Symbol\n{\n};\n";
+    content += "} // namespace project\n";
+    return content;
+}
+
+//! Creates the tree once per file count, and keeps it, until the benchmarks finish.
+static const Tsepepe::DirectoryTree& get_codebase(unsigned files_count)
+{
+    static std::map<unsigned, std::unique_ptr<Tsepepe::DirectoryTree>> codebases;
+
+    auto& codebase{codebases[files_count]};
+    if (codebase == nullptr)
+    {
+        codebase = std::make_unique<Tsepepe::DirectoryTree>(fs::temp_directory_path()
+                                                            / ("tsepepe_bench_grep_" + std::to_string(files_count)));
+        for (unsigned i{0}; i < files_count; ++i)
+        {
+            auto directory{"dir" + std::to_string(i / files_per_directory)};
+            codebase->create_file(fs::path{directory} / ("file" + std::to_string(i) + ".hpp"), make_file_content(i));
+        }
+    }
+    return *codebase;
+}
+
+static void BM_codebase_grep(benchmark::State& state)
+{
+    auto root{get_codebase(static_cast<unsigned>(state.range(0))).get_root_absolute_path()};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            Tsepepe::codebase_grep(Tsepepe::RootDirectory{root}, Tsepepe::EcmaScriptPattern{pattern}));
+}
+BENCHMARK(BM_codebase_grep)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+#ifdef TSEPEPE_RIPGREP
+//! The former implementation of the codebase grepping, which spawned ripgrep and parsed its output.
+static void BM_codebase_grep_ripgrep(benchmark::State& state)
+{
+    auto root{get_codebase(static_cast<unsigned>(state.range(0))).get_root_absolute_path()};
+    std::string command{std::string{TSEPEPE_RIPGREP} + " " + pattern + " " + root.string() + " --vimgrep -t cpp"};
+    for (auto _ : state)
+    {
+        using namespace boost::process;
+
+        ipstream pipe_stream;
+        child c{command, std_out > pipe_stream};
+
+        unsigned matches_count{0};
+        std::string line;
+        while (pipe_stream and std::getline(pipe_stream, line) and not line.empty())
+            ++matches_count;
+        c.wait();
+
+        benchmark::DoNotOptimize(matches_count);
+    }
+}
+BENCHMARK(BM_codebase_grep_ripgrep)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+#endif
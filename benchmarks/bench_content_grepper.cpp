@@ -0,0 +1,42 @@
+/**
+ * @file	bench_content_grepper.cpp
+ * @brief	Benchmarks grepping the content loaded into memory.
+ */
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "content_grepper.hpp"
+#include "synthetic_sources.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+static void grep(benchmark::State& state, const char* pattern, bool is_multiline)
+{
+    auto header{make_synthetic_header({.methods_count = static_cast<unsigned>(state.range(0))})};
+    ContentGrepper grepper{EcmaScriptPattern{pattern}, is_multiline};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(grepper.grep(header.content));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+
+static void BM_content_grep_class_definition(benchmark::State& state)
+{
+    grep(state, "\\b(struct|class)\\s+Synthetic\\b", false);
+}
+BENCHMARK(BM_content_grep_class_definition)->RangeMultiplier(10)->Range(10, 10000);
+
+//! Each method declaration matches.
+static void BM_content_grep_method_declarations(benchmark::State& state)
+{
+    grep(state, "\\bint\\s+method_\\d+\\(", false);
+}
+BENCHMARK(BM_content_grep_method_declarations)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_content_grep_multiline(benchmark::State& state)
+{
+    grep(state, "class\\s+Synthetic\\s*\\{", true);
+}
+BENCHMARK(BM_content_grep_multiline)->RangeMultiplier(10)->Range(10, 10000);
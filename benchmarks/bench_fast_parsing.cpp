@@ -0,0 +1,95 @@
+/**
+ * @file	bench_fast_parsing.cpp
+ * @brief	Benchmarks parsing of the template-heavy headers with the function bodies skipped.
+ */
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+
+#include "directory_tree.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+
+namespace fs = std::filesystem;
+
+//! Each class template calls into the previous one, so that using one instantiates the whole chain.
+static std::string make_template_heavy_header(unsigned class_templates_count)
+{
+    std::string content{"#pragma once\n\nnamespace project\n{\n\n"
+                        "template<typename T>\nstruct Storage0\n{\n    T value{};\n    T get() const { return value; }\n};"
+                        "\n\n"};
+    for (unsigned i{1}; i <= class_templates_count; ++i)
+    {
+        auto name{"Storage" + std::to_string(i)};
+        auto previous{"Storage" + std::to_string(i - 1)};
+        content += "template<typename T>\nstruct " + name + "\n{\n"
+                   "    " + previous + "<T> previous;\n"
+                   "    T values[4]{};\n\n"
+                   "    template<typename Fun>\n"
+                   "    T accumulate(Fun fun) const\n"
+                   "    {\n"
+                   "        T result{previous.get()};\n"
+                   "        for (const auto& value : values)\n"
+                   "            result = fun(result, value);\n"
+                   "        auto twice{[&](T v) { return fun(v, v); }};\n"
+                   "        return twice(result);\n"
+                   "    }\n\n"
+                   "    T get() const { return accumulate([](T a, T b) { return a + b; }); }\n"
+                   "};\n\n";
+    }
+    content += "inline int use()\n{\n    return Storage" + std::to_string(class_templates_count)
+               + "<int>{}.get() + Storage" + std::to_string(class_templates_count) + "<double>{}.get();\n}\n\n";
+    content += "struct Interface\n{\n    virtual int fun() = 0;\n    virtual ~Interface() = default;\n};\n\n";
+    content += "} // namespace project\n";
+    return content;
+}
+
+//! Creates the header once per class templates count, and keeps it, until the benchmarks finish.
+static fs::path get_header(unsigned class_templates_count)
+{
+    static std::map<unsigned, std::unique_ptr<Tsepepe::DirectoryTree>> trees;
+
+    auto& tree{trees[class_templates_count]};
+    if (tree == nullptr)
+    {
+        tree = std::make_unique<Tsepepe::DirectoryTree>(
+            fs::temp_directory_path() / ("tsepepe_bench_fast_parsing_" + std::to_string(class_templates_count)));
+        tree->create_file("templates.hpp", make_template_heavy_header(class_templates_count));
+    }
+    return tree->get_root_absolute_path() / "templates.hpp";
+}
+
+static void parse(benchmark::State& state, bool is_fast_parsing_enabled)
+{
+    auto header{get_header(static_cast<unsigned>(state.range(0)))};
+    clang::tooling::FixedCompilationDatabase compilation_database{header.parent_path().string(),
+                                                                  {"-std=c++20", "-xc++"}};
+    for (auto _ : state)
+    {
+        std::vector<std::unique_ptr<clang::ASTUnit>> ast_units;
+        clang::tooling::ClangTool tool{compilation_database, {header.string()}};
+        if (is_fast_parsing_enabled)
+            tool.appendArgumentsAdjuster(Tsepepe::get_fast_parsing_arguments_adjuster());
+        tool.buildASTs(ast_units);
+        benchmark::DoNotOptimize(ast_units);
+    }
+}
+
+static void BM_parse_template_heavy_header(benchmark::State& state)
+{
+    parse(state, false);
+}
+BENCHMARK(BM_parse_template_heavy_header)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
+
+static void BM_parse_template_heavy_header_fast(benchmark::State& state)
+{
+    parse(state, true);
+}
+BENCHMARK(BM_parse_template_heavy_header_fast)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,53 @@
+/**
+ * @file	bench_gitignore.cpp
+ * @brief	Benchmarks matching the paths against the .gitignore rules.
+ */
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "gitignore.hpp"
+
+using namespace Tsepepe;
+
+namespace fs = std::filesystem;
+
+static void BM_gitignore_is_ignored(benchmark::State& state)
+{
+    auto rules_count{static_cast<unsigned>(state.range(0))};
+    std::string content;
+    for (unsigned i{0}; i < rules_count; ++i)
+    {
+        switch (i % 4)
+        {
+        case 0:
+            content += "build_" + std::to_string(i) + "/\n";
+            break;
+        case 1:
+            content += "*.generated_" + std::to_string(i) + ".hpp\n";
+            break;
+        case 2:
+            content += "src/**/module_" + std::to_string(i) + "/*.cpp\n";
+            break;
+        default:
+            content += "!keep_[0-9]_" + std::to_string(i) + ".hpp\n";
+        }
+    }
+
+    fs::path root{"/project"};
+    GitIgnore gitignore{content, root};
+
+    std::vector<fs::path> paths;
+    for (unsigned i{0}; i < 100; ++i)
+        paths.emplace_back(root / "src" / ("dir" + std::to_string(i % 10)) / ("module_" + std::to_string(i))
+                           / ("file_" + std::to_string(i) + ".cpp"));
+
+    for (auto _ : state)
+        for (const auto& path : paths)
+            benchmark::DoNotOptimize(gitignore.is_ignored(path, false));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK(BM_gitignore_is_ignored)->RangeMultiplier(10)->Range(10, 1000);
@@ -0,0 +1,42 @@
+/**
+ * @file	bench_implementor_maker.cpp
+ * @brief	Benchmarks implementing the interface found within the synthetic projects of growing size.
+ */
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "compilation_database_cache.hpp"
+#include "implement_interface_code_action.hpp"
+
+#include "synthetic_codebase.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+//! The action is created anew on each invocation, the same way as the implementor maker does it, when there is no
+//! daemon running.
+static void BM_make_implementor(benchmark::State& state)
+{
+    const auto& codebase{get_synthetic_codebase({.files_count = static_cast<unsigned>(state.range(0)),
+                                                 .interfaces_count = 4,
+                                                 .inheritance_depth = static_cast<unsigned>(state.range(1)),
+                                                 .name_collisions_count = static_cast<unsigned>(state.range(2))})};
+    std::shared_ptr compilation_database{utils::clang_ast::load_cached_compilation_database(codebase.root)};
+    std::string implementor{"#include \"" + codebase.searched_interface_include.string()
+                            + "\"\n\nclass Implementor\n{\n};\n"};
+
+    for (auto _ : state)
+    {
+        ImplementIntefaceCodeActionLibclangBased action{compilation_database};
+        benchmark::DoNotOptimize(action.apply({.root_directory = codebase.root,
+                                               .source_file_path = codebase.root / "src" / "implementor.hpp",
+                                               .source_file_content = implementor,
+                                               .inteface_name = codebase.searched_interface_name,
+                                               .cursor_position_line = 4}));
+    }
+}
+BENCHMARK(BM_make_implementor)
+    ->ArgsProduct({{1000, 10000, 50000}, {1, 8}, {0, 100}})
+    ->Unit(benchmark::kMillisecond);
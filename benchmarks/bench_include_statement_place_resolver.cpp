@@ -0,0 +1,32 @@
+/**
+ * @file	bench_include_statement_place_resolver.cpp
+ * @brief	Benchmarks resolving the place for the include statement.
+ */
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "include_statement_place_resolver.hpp"
+#include "synthetic_sources.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+static void BM_resolve_include_statement_place(benchmark::State& state)
+{
+    auto header{make_synthetic_header({.methods_count = static_cast<unsigned>(state.range(0)),
+                                       .includes_count = static_cast<unsigned>(state.range(1))})};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(resolve_include_statement_place(header.content));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+BENCHMARK(BM_resolve_include_statement_place)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {0}})
+    ->ArgsProduct({{10}, benchmark::CreateRange(10, 10000, 10)});
+
+//! The headers of a few megabytes, generated e.g. from the protocol definitions.
+BENCHMARK(BM_resolve_include_statement_place)
+    ->Name("BM_resolve_include_statement_place_multi_megabyte")
+    ->ArgsProduct({{20000, 50000}, {0, 50000}})
+    ->Unit(benchmark::kMillisecond);
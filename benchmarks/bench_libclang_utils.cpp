@@ -0,0 +1,164 @@
+/**
+ * @file	bench_libclang_utils.cpp
+ * @brief	Benchmarks the components working on the Clang AST.
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <regex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Lex/Lexer.h>
+
+#include "libclang_utils/base_specifier_resolver.hpp"
+#include "libclang_utils/class_indexer.hpp"
+#include "libclang_utils/full_function_declaration_expander.hpp"
+#include "libclang_utils/match_queries.hpp"
+#include "libclang_utils/misc_utils.hpp"
+#include "libclang_utils/pure_virtual_functions_extractor.hpp"
+#include "libclang_utils/suitable_place_in_class_finder.hpp"
+
+#include "parsed_synthetic_header.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+static const ParsedSyntheticHeader& get_header(const benchmark::State& state)
+{
+    return get_parsed_synthetic_header({.methods_count = static_cast<unsigned>(state.range(0)),
+                                        .namespace_depth = static_cast<unsigned>(state.range(1))});
+}
+
+static void BM_fully_expand_function_declaration(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    const auto& source_manager{header.ast_unit->getSourceManager()};
+
+    for (auto _ : state)
+        for (auto method : header.class_methods)
+            benchmark::DoNotOptimize(fully_expand_function_declaration(
+                method, source_manager, {.ignore_attribute_specifiers = true, .remove_scope_from_parameters = true}));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * header.class_methods.size()));
+}
+BENCHMARK(BM_fully_expand_function_declaration)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+//! The former implementation of the source_range_content_to_string(), which collapsed the whitespaces with a regex.
+static std::string source_range_content_to_string_with_regex(const clang::SourceRange& source_range,
+                                                             const clang::SourceManager& source_manager,
+                                                             const clang::LangOptions& lang_options)
+{
+    auto end{clang::Lexer::getLocForEndOfToken(source_range.getEnd(), 0, source_manager, lang_options)};
+    std::string result(source_manager.getCharacterData(source_range.getBegin()), source_manager.getCharacterData(end));
+    result = std::regex_replace(result, std::regex{"\\s\\s+"}, " ");
+
+    auto is_space{[](unsigned char c) {
+        return std::isspace(c);
+    }};
+    result.erase(result.begin(), std::find_if_not(result.begin(), result.end(), is_space));
+    result.erase(std::find_if_not(result.rbegin(), result.rend(), is_space).base(), result.end());
+    return result;
+}
+
+static void BM_source_range_content_to_string(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    const auto& source_manager{header.ast_unit->getSourceManager()};
+
+    for (auto _ : state)
+        for (auto method : header.class_methods)
+            benchmark::DoNotOptimize(
+                source_range_content_to_string(method->getSourceRange(), source_manager, method->getLangOpts()));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * header.class_methods.size()));
+}
+BENCHMARK(BM_source_range_content_to_string)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+static void BM_source_range_content_to_string_regex(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    const auto& source_manager{header.ast_unit->getSourceManager()};
+
+    for (auto _ : state)
+        for (auto method : header.class_methods)
+            benchmark::DoNotOptimize(source_range_content_to_string_with_regex(
+                method->getSourceRange(), source_manager, method->getLangOpts()));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * header.class_methods.size()));
+}
+BENCHMARK(BM_source_range_content_to_string_regex)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+static void BM_pure_virtual_functions_to_override_declarations(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    auto implementor_name{get_synthetic_namespace(static_cast<unsigned>(state.range(1))) + "::Synthetic"};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pure_virtual_functions_to_override_declarations(
+            header.interface_node, implementor_name, header.ast_unit->getSourceManager()));
+}
+BENCHMARK(BM_pure_virtual_functions_to_override_declarations)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_find_suitable_place_in_class_for_public_method(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(find_suitable_place_in_class_for_public_method(
+            header.content, header.class_node, header.ast_unit->getSourceManager()));
+}
+BENCHMARK(BM_find_suitable_place_in_class_for_public_method)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1}});
+
+static void BM_resolve_base_specifier(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    ClangClassRecord deriving_class{.node = header.class_node, .source_manager = &header.ast_unit->getSourceManager()};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(resolve_base_specifier(header.content, deriving_class, header.interface_node));
+}
+BENCHMARK(BM_resolve_base_specifier)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+//! The queries run when the interface is looked for within a file, which is to be indexed.
+static std::vector<clang::ast_matchers::DeclarationMatcher> get_interface_lookup_matchers()
+{
+    using namespace clang::ast_matchers;
+    return {cxxRecordDecl(hasName("Interface")).bind("abstract class"), get_class_definition_matcher()};
+}
+
+static void BM_match_queries_in_single_traversal(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    auto& context{header.ast_unit->getASTContext()};
+
+    MatchQueries queries;
+    for (auto& matcher : get_interface_lookup_matchers())
+        queries.add(std::move(matcher));
+
+    for (auto _ : state)
+    {
+        queries.run(context);
+        benchmark::DoNotOptimize(queries.get_matches(0).size());
+    }
+}
+BENCHMARK(BM_match_queries_in_single_traversal)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_match_queries_in_separate_traversals(benchmark::State& state)
+{
+    const auto& header{get_header(state)};
+    auto& context{header.ast_unit->getASTContext()};
+    auto matchers{get_interface_lookup_matchers()};
+
+    for (auto _ : state)
+        for (const auto& matcher : matchers)
+            benchmark::DoNotOptimize(clang::ast_matchers::match(matcher, context).size());
+}
+BENCHMARK(BM_match_queries_in_separate_traversals)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1}})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,60 @@
+/**
+ * @file	bench_paired_cpp_file_finder.cpp
+ * @brief	Benchmarks finding the paired C++ file within the synthetic projects of growing size.
+ */
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "paired_cpp_file_finder/finder.hpp"
+#include "stem_index.hpp"
+
+#include "synthetic_codebase.hpp"
+
+using namespace Tsepepe::Benchmarks;
+
+//! The header paired with the source is located within the other subtree, so the whole project is walked.
+static void BM_find_paired_cpp_file(benchmark::State& state)
+{
+    const auto& codebase{get_synthetic_codebase({.files_count = static_cast<unsigned>(state.range(0)),
+                                                 .directory_depth = static_cast<unsigned>(state.range(1))})};
+    const auto& source{codebase.sources[codebase.sources.size() / 2]};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Tsepepe::PairedCppFileFinder::find({codebase.root, source}));
+}
+BENCHMARK(BM_find_paired_cpp_file)
+    ->ArgsProduct({{1000, 10000, 50000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+//! The walk stops at the first paired file found.
+static void BM_find_first_paired_cpp_file(benchmark::State& state)
+{
+    const auto& codebase{get_synthetic_codebase({.files_count = static_cast<unsigned>(state.range(0)),
+                                                 .directory_depth = static_cast<unsigned>(state.range(1))})};
+    const auto& source{codebase.sources[codebase.sources.size() / 2]};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            Tsepepe::PairedCppFileFinder::find({.project_directory = codebase.root,
+                                                .cpp_file = source,
+                                                .max_matches_count = 1}));
+}
+BENCHMARK(BM_find_first_paired_cpp_file)
+    ->ArgsProduct({{1000, 10000, 50000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+//! Only the directory stamps are compared to the stored ones, and the paired files are looked up within the index.
+static void BM_find_paired_cpp_file_with_stem_index(benchmark::State& state)
+{
+    const auto& codebase{get_synthetic_codebase({.files_count = static_cast<unsigned>(state.range(0)),
+                                                 .directory_depth = static_cast<unsigned>(state.range(1))})};
+    const auto& source{codebase.sources[codebase.sources.size() / 2]};
+    Tsepepe::StemIndex::build(codebase.root).save();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Tsepepe::PairedCppFileFinder::find({codebase.root, source}));
+
+    // The synthetic codebase is shared with the other benchmarks, which shall walk it.
+    std::filesystem::remove(Tsepepe::StemIndex::get_storage_path(codebase.root));
+}
+BENCHMARK(BM_find_paired_cpp_file_with_stem_index)
+    ->ArgsProduct({{1000, 10000, 50000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
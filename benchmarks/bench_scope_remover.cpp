@@ -0,0 +1,86 @@
+/**
+ * @file	bench_scope_remover.cpp
+ * @brief	Benchmarks removing the scopes from the C++ code.
+ */
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "scope_remover.hpp"
+#include "synthetic_sources.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Benchmarks;
+
+static SyntheticHeader make_header(const benchmark::State& state)
+{
+    return make_synthetic_header({.methods_count = static_cast<unsigned>(state.range(0)),
+                                  .namespace_depth = static_cast<unsigned>(state.range(1))});
+}
+
+//! The former implementation of the ScopeRemover, which replaced the unescaped name as a regex.
+static std::string remove_scope_with_regex(const std::string& cpp_code, const std::string& scope)
+{
+    return std::regex_replace(cpp_code, std::regex{scope}, "");
+}
+
+//! The former implementation of the AllScopeRemover, which replaced each nesting scope, from the longest one.
+static std::string remove_all_scopes_with_regex(std::string cpp_code, const std::string& fully_qualified_name)
+{
+    std::vector<std::string> nesting_scopes{fully_qualified_name + "::"};
+    for (auto position{fully_qualified_name.rfind("::")}; position != std::string::npos;
+         position = position == 0 ? std::string::npos : fully_qualified_name.rfind("::", position - 1))
+        nesting_scopes.push_back(fully_qualified_name.substr(0, position + 2));
+
+    for (const auto& scope : nesting_scopes)
+        cpp_code = remove_scope_with_regex(cpp_code, scope);
+    return cpp_code;
+}
+
+static void BM_scope_remover(benchmark::State& state)
+{
+    auto header{make_header(state)};
+    ScopeRemover remover{FullyQualifiedName{get_synthetic_namespace(static_cast<unsigned>(state.range(1)))}};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(remover.remove_from(header.content));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+BENCHMARK(BM_scope_remover)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+static void BM_scope_remover_regex(benchmark::State& state)
+{
+    auto header{make_header(state)};
+    auto scope{get_synthetic_namespace(static_cast<unsigned>(state.range(1))) + "::"};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(remove_scope_with_regex(header.content, scope));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+BENCHMARK(BM_scope_remover_regex)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+static void BM_all_scope_remover(benchmark::State& state)
+{
+    auto header{make_header(state)};
+    AllScopeRemover remover{
+        FullyQualifiedName{get_synthetic_namespace(static_cast<unsigned>(state.range(1))) + "::Synthetic"}};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(remover.remove_from(header.content));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+BENCHMARK(BM_all_scope_remover)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
+
+static void BM_all_scope_remover_regex(benchmark::State& state)
+{
+    auto header{make_header(state)};
+    auto fully_qualified_name{get_synthetic_namespace(static_cast<unsigned>(state.range(1))) + "::Synthetic"};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(remove_all_scopes_with_regex(header.content, fully_qualified_name));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * header.content.size()));
+}
+BENCHMARK(BM_all_scope_remover_regex)->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {1, 16}});
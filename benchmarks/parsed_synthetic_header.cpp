@@ -0,0 +1,77 @@
+/**
+ * @file	parsed_synthetic_header.cpp
+ * @brief	Implements parsing the synthetic header.
+ */
+
+#include "parsed_synthetic_header.hpp"
+
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Tooling/Tooling.h>
+
+namespace fs = std::filesystem;
+using namespace clang::ast_matchers;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static const clang::CXXRecordDecl* find_class(clang::ASTUnit&, const std::string& name);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<clang::tooling::CompilationDatabase> Tsepepe::Benchmarks::make_synthetic_compilation_database()
+{
+    return std::make_shared<clang::tooling::FixedCompilationDatabase>(fs::temp_directory_path().string(),
+                                                                      std::vector<std::string>{"-std=c++20", "-xc++"});
+}
+
+const Tsepepe::Benchmarks::ParsedSyntheticHeader&
+Tsepepe::Benchmarks::get_parsed_synthetic_header(const SyntheticHeaderParameters& parameters)
+{
+    static std::map<std::tuple<unsigned, unsigned, unsigned>, ParsedSyntheticHeader> parsed_headers;
+
+    auto key{std::make_tuple(parameters.methods_count, parameters.namespace_depth, parameters.includes_count)};
+    if (auto it{parsed_headers.find(key)}; it != std::end(parsed_headers))
+        return it->second;
+
+    ParsedSyntheticHeader result;
+    result.tree = std::make_unique<DirectoryTree>(
+        fs::temp_directory_path()
+        / ("tsepepe_bench_parsed_" + std::to_string(parameters.methods_count) + "_"
+           + std::to_string(parameters.namespace_depth) + "_" + std::to_string(parameters.includes_count)));
+    auto path{create_synthetic_header(*result.tree, parameters)};
+    result.content = make_synthetic_header(parameters).content;
+
+    auto compilation_database{make_synthetic_compilation_database()};
+    std::vector<std::unique_ptr<clang::ASTUnit>> ast_units;
+    clang::tooling::ClangTool tool{*compilation_database, {path.string()}};
+    tool.buildASTs(ast_units);
+    if (ast_units.empty())
+        throw std::runtime_error{"Failed to parse: " + path.string()};
+    result.ast_unit = std::move(ast_units.back());
+
+    result.interface_node = find_class(*result.ast_unit, "Interface");
+    result.class_node = find_class(*result.ast_unit, "Synthetic");
+    for (auto method : result.class_node->methods())
+        if (not method->isImplicit())
+            result.class_methods.push_back(method);
+
+    return parsed_headers.emplace(key, std::move(result)).first->second;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static const clang::CXXRecordDecl* find_class(clang::ASTUnit& ast_unit, const std::string& name)
+{
+    auto matches{match(cxxRecordDecl(hasName(name), isDefinition()).bind("class"), ast_unit.getASTContext())};
+    if (matches.empty())
+        throw std::runtime_error{"Failed to find the class: " + name};
+    return matches.front().getNodeAs<clang::CXXRecordDecl>("class");
+}
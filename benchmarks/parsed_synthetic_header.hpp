@@ -0,0 +1,40 @@
+/**
+ * @file        parsed_synthetic_header.hpp
+ * @brief       Parses the synthetic header, to benchmark the components working on the Clang AST.
+ */
+#ifndef PARSED_SYNTHETIC_HEADER_HPP
+#define PARSED_SYNTHETIC_HEADER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "directory_tree.hpp"
+#include "synthetic_sources.hpp"
+
+namespace Tsepepe::Benchmarks
+{
+
+//! The compile commands for the synthetic sources, which need no compilation database on disk.
+std::shared_ptr<clang::tooling::CompilationDatabase> make_synthetic_compilation_database();
+
+struct ParsedSyntheticHeader
+{
+    std::unique_ptr<DirectoryTree> tree;
+    std::string content;
+    std::unique_ptr<clang::ASTUnit> ast_unit;
+    const clang::CXXRecordDecl* interface_node;
+    const clang::CXXRecordDecl* class_node;
+    std::vector<const clang::CXXMethodDecl*> class_methods;
+};
+
+//! Parses the header once per parameters, and keeps it, until the benchmarks finish.
+const ParsedSyntheticHeader& get_parsed_synthetic_header(const SyntheticHeaderParameters&);
+
+} // namespace Tsepepe::Benchmarks
+
+#endif /* PARSED_SYNTHETIC_HEADER_HPP */
@@ -0,0 +1,205 @@
+/**
+ * @file	synthetic_codebase.cpp
+ * @brief	Implements generating the synthetic C++ projects.
+ */
+
+#include "synthetic_codebase.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+
+namespace fs = std::filesystem;
+
+using namespace Tsepepe::Benchmarks;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static fs::path get_directory(unsigned file_index, unsigned directory_depth);
+static std::string get_interface_name(unsigned hierarchy, unsigned level, unsigned inheritance_depth);
+static fs::path get_interface_include(unsigned hierarchy, unsigned level);
+static std::string make_interface(unsigned hierarchy, unsigned level, unsigned inheritance_depth);
+static std::string make_class_header(unsigned file_index, const SyntheticCodebaseParameters&, bool has_collision);
+static std::string make_class_source(unsigned file_index, const fs::path& header_include, unsigned methods_count);
+static std::string make_compilation_database(const fs::path& root, const std::vector<fs::path>& sources);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper variables
+// --------------------------------------------------------------------------------------------------------------------
+static constexpr unsigned files_per_directory{16};
+static constexpr unsigned subdirectories_per_directory{8};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+SyntheticCodebase Tsepepe::Benchmarks::create_synthetic_codebase(DirectoryTree& tree,
+                                                                 const SyntheticCodebaseParameters& parameters)
+{
+    auto inheritance_depth{std::max(parameters.inheritance_depth, 1u)};
+    auto root{tree.get_root_absolute_path()};
+
+    SyntheticCodebase result{.root = root,
+                             .searched_interface_name = get_interface_name(0, inheritance_depth - 1, inheritance_depth),
+                             .searched_interface_include = get_interface_include(0, inheritance_depth - 1)};
+
+    for (unsigned hierarchy{0}; hierarchy < parameters.interfaces_count; ++hierarchy)
+        for (unsigned level{0}; level < inheritance_depth; ++level)
+            result.headers.push_back(tree.create_file(fs::path{"include"} / get_interface_include(hierarchy, level),
+                                                      make_interface(hierarchy, level, inheritance_depth)));
+
+    auto collisions_count{std::min(parameters.name_collisions_count, parameters.files_count)};
+    auto collision_interval{collisions_count > 0 ? parameters.files_count / collisions_count : 0};
+    for (unsigned i{0}; i < parameters.files_count; ++i)
+    {
+        auto has_collision{collisions_count > 0 and i % collision_interval == 0
+                           and i / collision_interval < collisions_count};
+        auto directory{get_directory(i, parameters.directory_depth)};
+        auto name{"class_" + std::to_string(i)};
+        auto header_include{directory / (name + ".hpp")};
+        auto methods_count{parameters.interfaces_count > 0 ? inheritance_depth : 0};
+
+        result.headers.push_back(tree.create_file(fs::path{"include"} / header_include,
+                                                  make_class_header(i, parameters, has_collision)));
+        result.sources.push_back(tree.create_file(fs::path{"src"} / directory / (name + ".cpp"),
+                                                  make_class_source(i, header_include, methods_count)));
+    }
+
+    tree.create_file("compile_commands.json", make_compilation_database(root, result.sources));
+    return result;
+}
+
+const SyntheticCodebase& Tsepepe::Benchmarks::get_synthetic_codebase(const SyntheticCodebaseParameters& parameters)
+{
+    using Key = std::tuple<unsigned, unsigned, unsigned, unsigned, unsigned>;
+    static std::map<Key, std::pair<std::unique_ptr<DirectoryTree>, SyntheticCodebase>> codebases;
+
+    Key key{parameters.files_count,
+            parameters.directory_depth,
+            parameters.interfaces_count,
+            parameters.inheritance_depth,
+            parameters.name_collisions_count};
+    if (auto it{codebases.find(key)}; it != std::end(codebases))
+        return it->second.second;
+
+    auto name{std::apply(
+        [](auto... values) { return ("tsepepe_bench_codebase" + ... + ("_" + std::to_string(values))); }, key)};
+    auto tree{std::make_unique<DirectoryTree>(fs::temp_directory_path() / name)};
+    auto codebase{create_synthetic_codebase(*tree, parameters)};
+    return codebases.emplace(key, std::make_pair(std::move(tree), std::move(codebase))).first->second.second;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static fs::path get_directory(unsigned file_index, unsigned directory_depth)
+{
+    if (directory_depth == 0)
+        return {};
+
+    auto directory_index{file_index / files_per_directory};
+    std::vector<unsigned> levels(directory_depth);
+    for (auto it{levels.rbegin()}; it != std::prev(levels.rend()); ++it)
+    {
+        *it = directory_index % subdirectories_per_directory;
+        directory_index /= subdirectories_per_directory;
+    }
+    levels.front() = directory_index;
+
+    fs::path result;
+    for (auto level : levels)
+        result /= "dir" + std::to_string(level);
+    return result;
+}
+
+static std::string get_interface_name(unsigned hierarchy, unsigned level, unsigned inheritance_depth)
+{
+    auto name{"Interface" + std::to_string(hierarchy)};
+    return level + 1 == inheritance_depth ? name : name + "Base" + std::to_string(level);
+}
+
+static fs::path get_interface_include(unsigned hierarchy, unsigned level)
+{
+    return fs::path{"interfaces"} / ("interface_" + std::to_string(hierarchy) + "_" + std::to_string(level) + ".hpp");
+}
+
+//! Each interface within the hierarchy derives from the previous one, and adds a single pure virtual method.
+static std::string make_interface(unsigned hierarchy, unsigned level, unsigned inheritance_depth)
+{
+    auto name{get_interface_name(hierarchy, level, inheritance_depth)};
+    auto method_index{std::to_string(level)};
+
+    std::string content{"#pragma once\n\n"};
+    if (level > 0)
+        content += "#include \"" + get_interface_include(hierarchy, level - 1).string() + "\"\n\n";
+    content += "namespace project::interfaces\n{\n\n";
+    content += "class " + name;
+    if (level > 0)
+        content += " : public " + get_interface_name(hierarchy, level - 1, inheritance_depth);
+    content += "\n{\n  public:\n";
+    if (level == 0)
+        content += "    virtual ~" + name + "() = default;\n";
+    content += "    virtual int method_" + method_index + "(int value) = 0;\n";
+    content += "};\n\n} // namespace project::interfaces\n";
+    return content;
+}
+
+//! The class implements the interface, and the collision is a concrete class with the same name as the searched
+//! interface, defined within the namespace of the class.
+static std::string
+make_class_header(unsigned file_index, const SyntheticCodebaseParameters& parameters, bool has_collision)
+{
+    auto inheritance_depth{std::max(parameters.inheritance_depth, 1u)};
+    auto index{std::to_string(file_index)};
+    auto is_implementing_interface{parameters.interfaces_count > 0};
+    auto hierarchy{is_implementing_interface ? file_index % parameters.interfaces_count : 0};
+
+    std::string content{"#pragma once\n\n"};
+    if (is_implementing_interface)
+        content += "#include \"" + get_interface_include(hierarchy, inheritance_depth - 1).string() + "\"\n\n";
+    content += "namespace project::unit" + index + "\n{\n\n";
+
+    if (has_collision)
+        content += "class " + get_interface_name(0, inheritance_depth - 1, inheritance_depth)
+                   + "\n{\n  public:\n    int method_0(int value);\n};\n\n";
+
+    content += "class Class" + index;
+    if (is_implementing_interface)
+        content += " : public ::project::interfaces::"
+                   + get_interface_name(hierarchy, inheritance_depth - 1, inheritance_depth);
+    content += "\n{\n  public:\n";
+    if (is_implementing_interface)
+        for (unsigned level{0}; level < inheritance_depth; ++level)
+            content += "    int method_" + std::to_string(level) + "(int value) override;\n";
+    content += "    int get() const;\n\n  private:\n    int member;\n};\n\n";
+    content += "} // namespace project::unit" + index + "\n";
+    return content;
+}
+
+static std::string make_class_source(unsigned file_index, const fs::path& header_include, unsigned methods_count)
+{
+    auto class_name{"project::unit" + std::to_string(file_index) + "::Class" + std::to_string(file_index)};
+
+    std::string content{"#include \"" + header_include.string() + "\"\n\n"};
+    for (unsigned i{0}; i < methods_count; ++i)
+        content += "int " + class_name + "::method_" + std::to_string(i) + "(int value)\n{\n    return value + "
+                   + std::to_string(i) + " + member;\n}\n\n";
+    content += "int " + class_name + "::get() const\n{\n    return member;\n}\n";
+    return content;
+}
+
+static std::string make_compilation_database(const fs::path& root, const std::vector<fs::path>& sources)
+{
+    std::string result{"[\n"};
+    for (const auto& source : sources)
+    {
+        if (result.size() > 2)
+            result += ",\n";
+        result += R"(  {"directory": ")" + root.string() + R"(", "file": ")" + source.string()
+                  + R"(", "arguments": ["c++", "-std=c++20", "-I)" + (root / "include").string() + R"(", "-c", ")"
+                  + source.string() + R"("]})";
+    }
+    result += "\n]\n";
+    return result;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file        synthetic_codebase.hpp
+ * @brief       Generates the synthetic C++ projects of growing size, used as the inputs of the finder benchmarks.
+ */
+#ifndef SYNTHETIC_CODEBASE_HPP
+#define SYNTHETIC_CODEBASE_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "directory_tree.hpp"
+
+namespace Tsepepe::Benchmarks
+{
+
+struct SyntheticCodebaseParameters
+{
+    //! The number of the header and source file pairs, each defining a single class.
+    unsigned files_count;
+    //! The number of the nested directories, under "include/" and "src/", the files are spread over.
+    unsigned directory_depth{2};
+    //! The number of the interface hierarchies, which the classes implement in turns.
+    unsigned interfaces_count{1};
+    //! The number of the interfaces within a hierarchy, each one deriving from the previous one.
+    unsigned inheritance_depth{1};
+    //! The number of the concrete classes with the same name as the searched interface, defined within other
+    //! namespaces.
+    unsigned name_collisions_count{0};
+};
+
+struct SyntheticCodebase
+{
+    std::filesystem::path root;
+    //! The name of the most derived interface within the first hierarchy, the one which is looked for.
+    std::string searched_interface_name;
+    //! The path to the header with the searched interface, relative to the "include/" directory.
+    std::filesystem::path searched_interface_include;
+    std::vector<std::filesystem::path> headers;
+    std::vector<std::filesystem::path> sources;
+};
+
+/** @brief Creates the project under the tree root, together with its compile_commands.json.
+ *
+ * The headers are placed under "include/", and the sources under the mirrored directories within "src/", so that
+ * the file paired with any of them is located in the other subtree. The interfaces are kept under
+ * "include/interfaces/". The generator is deterministic: the same parameters always result in the same project.
+ */
+SyntheticCodebase create_synthetic_codebase(DirectoryTree&, const SyntheticCodebaseParameters&);
+
+//! Creates the project once per parameters, within the temporary directory, and keeps it, until the benchmarks finish.
+const SyntheticCodebase& get_synthetic_codebase(const SyntheticCodebaseParameters&);
+
+} // namespace Tsepepe::Benchmarks
+
+#endif /* SYNTHETIC_CODEBASE_HPP */
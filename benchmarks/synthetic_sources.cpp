@@ -0,0 +1,71 @@
+/**
+ * @file	synthetic_sources.cpp
+ * @brief	Implements generating the synthetic C++ sources.
+ */
+
+#include "synthetic_sources.hpp"
+
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+std::string Tsepepe::Benchmarks::get_synthetic_namespace(unsigned namespace_depth)
+{
+    std::string result;
+    for (unsigned i{0}; i < namespace_depth; ++i)
+    {
+        if (i > 0)
+            result += "::";
+        result += "ns" + std::to_string(i);
+    }
+    return result;
+}
+
+Tsepepe::Benchmarks::SyntheticHeader
+Tsepepe::Benchmarks::make_synthetic_header(const SyntheticHeaderParameters& parameters)
+{
+    auto parameter_type{get_synthetic_namespace(parameters.namespace_depth) + "::Parameter"};
+
+    std::string content{"#ifndef SYNTHETIC_HPP\n#define SYNTHETIC_HPP\n\n"};
+    for (unsigned i{0}; i < parameters.includes_count; ++i)
+        content += "#include \"include_" + std::to_string(i) + ".hpp\"\n";
+    content += "\n";
+
+    for (unsigned i{0}; i < parameters.namespace_depth; ++i)
+        content += "namespace ns" + std::to_string(i) + "\n{\n";
+    content += "\nstruct Parameter\n{\n    int value;\n};\n\n";
+
+    content += "class Interface\n{\n  public:\n    virtual ~Interface() = default;\n";
+    for (unsigned i{0}; i < parameters.methods_count; ++i)
+        content += "    virtual int method_" + std::to_string(i) + "(const " + parameter_type
+                   + "& parameter, unsigned count) = 0;\n";
+    content += "};\n\n";
+
+    content += "class Synthetic\n{\n  public:\n";
+    auto first_method_line{static_cast<unsigned>(std::ranges::count(content, '\n')) + 1};
+    for (unsigned i{0}; i < parameters.methods_count; ++i)
+        content += "    [[nodiscard]] int method_" + std::to_string(i) + "(const " + parameter_type
+                   + "& parameter, unsigned count = 0) const;\n";
+    auto last_method_line{static_cast<unsigned>(std::ranges::count(content, '\n'))};
+    content += "\n  private:\n    int member;\n};\n\n";
+
+    for (unsigned i{parameters.namespace_depth}; i > 0; --i)
+        content += "} // namespace ns" + std::to_string(i - 1) + "\n";
+    content += "\n#endif /* SYNTHETIC_HPP */\n";
+
+    return SyntheticHeader{
+        .content = std::move(content), .first_method_line = first_method_line, .last_method_line = last_method_line};
+}
+
+fs::path Tsepepe::Benchmarks::create_synthetic_header(DirectoryTree& tree, const SyntheticHeaderParameters& parameters)
+{
+    for (unsigned i{0}; i < parameters.includes_count; ++i)
+    {
+        auto name{"include_" + std::to_string(i)};
+        tree.create_file(name + ".hpp", "#pragma once\n\nstruct Included_" + std::to_string(i) + "\n{\n};\n");
+    }
+    return tree.create_file("synthetic.hpp", make_synthetic_header(parameters).content);
+}
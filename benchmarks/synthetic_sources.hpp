@@ -0,0 +1,47 @@
+/**
+ * @file        synthetic_sources.hpp
+ * @brief       Generates the synthetic C++ sources of growing size, used as the benchmark inputs.
+ */
+#ifndef SYNTHETIC_SOURCES_HPP
+#define SYNTHETIC_SOURCES_HPP
+
+#include <filesystem>
+#include <string>
+
+#include "directory_tree.hpp"
+
+namespace Tsepepe::Benchmarks
+{
+
+struct SyntheticHeaderParameters
+{
+    unsigned methods_count;
+    unsigned namespace_depth{1};
+    unsigned includes_count{0};
+};
+
+struct SyntheticHeader
+{
+    std::string content;
+    //! The lines, counted from 1, of the first and the last method declaration within the class "Synthetic".
+    unsigned first_method_line;
+    unsigned last_method_line;
+};
+
+//! The names of the classes are "Interface" and "Synthetic", within the namespaces "ns0::ns1::...".
+std::string get_synthetic_namespace(unsigned namespace_depth);
+
+/** @brief Makes the header with the interface and the class, each having the methods count of methods.
+ *
+ * The classes are nested within the namespaces, and the method parameters refer to the types with their fully
+ * qualified names. The header includes the headers "include_<N>.hpp", placed next to it.
+ */
+SyntheticHeader make_synthetic_header(const SyntheticHeaderParameters&);
+
+//! Creates the header, "synthetic.hpp", together with the headers included by it, under the tree root. Returns the
+//! absolute path to the header.
+std::filesystem::path create_synthetic_header(DirectoryTree&, const SyntheticHeaderParameters&);
+
+} // namespace Tsepepe::Benchmarks
+
+#endif /* SYNTHETIC_SOURCES_HPP */
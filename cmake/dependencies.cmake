@@ -21,3 +21,16 @@ function(ProvideNamedType)
 endfunction()
 
 include(FetchContent)
+
+function(ProvideGoogleBenchmark)
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    FetchContent_Declare(
+        benchmark
+        URL https://github.com/google/benchmark/archive/refs/tags/v1.8.3.tar.gz
+    )
+    FetchContent_MakeAvailable(benchmark)
+
+endfunction()
@@ -3,6 +3,7 @@
  * @brief	Implements the command line parsing for the abstract class finder.
  */
 
+#include <cstring>
 #include <iostream>
 
 #include "clang_ast_utils.hpp"
@@ -19,6 +20,11 @@ using namespace Tsepepe::AbstractClassFinder;
 // --------------------------------------------------------------------------------------------------------------------
 static void print_usage(int argc, const char** argv);
 
+// --------------------------------------------------------------------------------------------------------------------
+// Private variables
+// --------------------------------------------------------------------------------------------------------------------
+static constexpr const char* index_flag{"--index"};
+
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
 // --------------------------------------------------------------------------------------------------------------------
@@ -30,6 +36,14 @@ std::variant<Input, ReturnCode> Tsepepe::AbstractClassFinder::parse_cmd(int argc
         return ReturnCode{0};
     }
 
+    auto is_class_index_created{argc > 1 and std::strcmp(argv[1], index_flag) == 0};
+    // The flag precedes the same arguments.
+    if (is_class_index_created)
+    {
+        --argc;
+        ++argv;
+    }
+
     if (argc != 4)
     {
         print_usage(argc, argv);
@@ -39,6 +53,7 @@ std::variant<Input, ReturnCode> Tsepepe::AbstractClassFinder::parse_cmd(int argc
     try
     {
         Input result;
+        result.is_class_index_created = is_class_index_created;
         result.compilation_database_ptr = Tsepepe::utils::clang_ast::parse_compilation_database(argv[1]);
         result.project_root = Tsepepe::utils::fs::parse_and_validate_path(argv[2]);
         result.class_name = argv[3];
@@ -56,11 +71,14 @@ std::variant<Input, ReturnCode> Tsepepe::AbstractClassFinder::parse_cmd(int argc
 static void print_usage(int argc, const char** argv)
 {
     auto program_path{argv[0]};
-    std::cout << "USAGE:\n\t" << program_path << " COMP_DB_DIR PROJECT_ROOT_DIR CLASS_NAME\n\n";
+    std::cout << "USAGE:\n\t" << program_path << " [--index] COMP_DB_DIR PROJECT_ROOT_DIR CLASS_NAME\n\n";
     std::cout << "DESCRIPTION:\n\tTries to find an abstract class with the name CLASS_NAME, under the root directory "
                  "PROJECT_ROOT_DIR.\n\t"
                  "Requires compilation database (compile_commands.json) put in COMP_DB_DIR directory.\n\t"
                  "On success, prints out the header file where the abstract class is located.\n\n"
+                 "\tWhen the class index is stored under PROJECT_ROOT_DIR (see tsepepe_class_indexer), the files,\n\t"
+                 "which haven't changed since they've been indexed, are not parsed at all; the other ones are\n\t"
+                 "indexed on the way. With --index, the class index is created, when there is none yet.\n\n"
                  "NOTE:\n\tripgrep tool is used to find the abstract class, thus the .gitignore patterns are used to"
                  " skip git-ignored directories.\n"
               << std::endl;
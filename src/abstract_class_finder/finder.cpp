@@ -2,7 +2,9 @@
  * @file	finder.cpp
  * @brief	Defines the Abstract Class Finder.
  */
-#include <ranges>
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <string>
 
 #include <clang/ASTMatchers/ASTMatchFinder.h>
@@ -11,15 +13,17 @@
 
 #include <boost/process.hpp>
 
-#include <range/v3/range/conversion.hpp>
-
 #include "finder.hpp"
 
+#include "class_index.hpp"
+#include "libclang_utils/class_indexer.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "trace.hpp"
+
 using namespace clang;
 using namespace clang::tooling;
 
 namespace fs = std::filesystem;
-namespace views = std::ranges::views;
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper AST definitions
@@ -38,6 +42,18 @@ namespace Tsepepe::AbstractClassFinder
 static std::vector<fs::path> ripgrep_for_class_name(const fs::path& root, const std::string& class_name);
 static bool has_abstract_class(const fs::path& header, const CompilationDatabase&, const std::string& class_name);
 
+//! The file is parsed only when the index is not up to date with it, and then it's indexed again, or when the class
+//! has bases, since they may have changed in the meantime. The file is never parsed twice.
+static bool has_abstract_class(const fs::path& header,
+                               ClassIndex&,
+                               const CompilationDatabase&,
+                               const std::string& class_name);
+
+static std::optional<ClassIndex> load_class_index(const Input&);
+
+//! Ignores the failures, like the code actions do.
+static void save_class_index(const ClassIndex&);
+
 // --------------------------------------------------------------------------------------------------------------------
 // Helper templates
 // --------------------------------------------------------------------------------------------------------------------
@@ -49,11 +65,22 @@ static bool has_abstract_class(const fs::path& header, const CompilationDatabase
 std::vector<fs::path> find(const Input& input)
 {
     auto files_having_searched_class{ripgrep_for_class_name(input.project_root, input.class_name)};
-    auto files_having_abstract_class{files_having_searched_class | views::filter([&](const fs::path& header) {
-                                         return has_abstract_class(
-                                             header, *input.compilation_database_ptr, input.class_name);
-                                     })
-                                     | ranges::to_vector};
+
+    auto class_index{load_class_index(input)};
+
+    // A loop, rather than a filter view, since the check indexes, or parses, the file, so it shall be done only once.
+    std::vector<fs::path> files_having_abstract_class;
+    for (auto& header : files_having_searched_class)
+    {
+        auto has_abstract_class_found{
+            class_index ? has_abstract_class(header, *class_index, *input.compilation_database_ptr, input.class_name)
+                        : has_abstract_class(header, *input.compilation_database_ptr, input.class_name)};
+        if (has_abstract_class_found)
+            files_having_abstract_class.push_back(std::move(header));
+    }
+
+    if (class_index)
+        save_class_index(*class_index);
     return files_having_abstract_class;
 }
 
@@ -67,6 +94,7 @@ static std::vector<fs::path> ripgrep_for_class_name(const fs::path& root, const
 
     std::vector<fs::path> result;
 
+    TraceSpan span{"ripgrep", command};
     using namespace boost::process;
     ipstream pipe_stream;
     child c{std::move(command), std_out > pipe_stream};
@@ -89,12 +117,57 @@ has_abstract_class(const fs::path& header, const CompilationDatabase& comp_db, c
     finder.addMatcher(abstract_class_matcher, &validator);
 
     ClangTool tool{comp_db, {header}};
+    tool.appendArgumentsAdjuster(Tsepepe::get_fast_parsing_arguments_adjuster());
     IgnoringDiagConsumer diagnostic_consumer;
     tool.setDiagnosticConsumer(&diagnostic_consumer);
 
-    tool.run(newFrontendActionFactory(&finder).get());
+    {
+        TraceSpan span{"ClangTool::run", header.string()};
+        tool.run(newFrontendActionFactory(&finder).get());
+    }
     return validator.is_match_found();
 }
 
+static bool has_abstract_class(const fs::path& header,
+                               ClassIndex& class_index,
+                               const CompilationDatabase& comp_db,
+                               const std::string& class_name)
+{
+    auto path{fs::absolute(header).lexically_normal()};
+    auto is_indexed_now{not class_index.is_up_to_date(path)};
+    if (is_indexed_now and not index_file(class_index, comp_db, path))
+        return false;
+
+    std::vector<ClassIndexEntry> entries;
+    std::ranges::copy_if(class_index.find(class_name), std::back_inserter(entries), [&](const ClassIndexEntry& entry) {
+        return entry.path == path;
+    });
+    // The entries just indexed come from the current state of the bases.
+    if (not is_indexed_now and std::ranges::any_of(entries, &ClassIndexEntry::has_bases))
+        return has_abstract_class(header, comp_db, class_name);
+    return std::ranges::any_of(entries, &ClassIndexEntry::is_abstract);
+}
+
+static std::optional<ClassIndex> load_class_index(const Input& input)
+{
+    auto class_index{ClassIndex::load(input.project_root)};
+    if (not class_index and input.is_class_index_created)
+        class_index.emplace(input.project_root);
+    return class_index;
+}
+
+static void save_class_index(const ClassIndex& class_index)
+{
+    if (not class_index.is_modified())
+        return;
+
+    try
+    {
+        class_index.save();
+    } catch (const std::exception&)
+    {
+    }
+}
+
 } // namespace Tsepepe::AbstractClassFinder
 
@@ -7,6 +7,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <string>
 
 #include <clang/Tooling/CompilationDatabase.h>
 
@@ -18,6 +19,8 @@ struct Input
     std::unique_ptr<clang::tooling::CompilationDatabase> compilation_database_ptr;
     std::filesystem::path project_root;
     std::string class_name;
+    //! The class index is used whenever it is stored under the project root, but it is created only on demand.
+    bool is_class_index_created{false};
 };
 
 } // namespace Tsepepe::AbstractClassFinder
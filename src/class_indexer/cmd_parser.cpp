@@ -0,0 +1,68 @@
+/**
+ * @file	cmd_parser.cpp
+ * @brief	Implements the command line parsing for the class indexer.
+ */
+
+#include <iostream>
+
+#include "clang_ast_utils.hpp"
+#include "cmd_utils.hpp"
+#include "error.hpp"
+#include "filesystem_utils.hpp"
+
+#include "cmd_parser.hpp"
+
+using namespace Tsepepe::ClassIndexer;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private declarations
+// --------------------------------------------------------------------------------------------------------------------
+static void print_usage(int argc, const char** argv);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+std::variant<Input, ReturnCode> Tsepepe::ClassIndexer::parse_cmd(int argc, const char** argv)
+{
+    if (Tsepepe::utils::cmd::is_command_help_requested(argc, argv))
+    {
+        print_usage(argc, argv);
+        return ReturnCode{0};
+    }
+
+    if (argc != 3)
+    {
+        print_usage(argc, argv);
+        return ReturnCode{1};
+    }
+
+    try
+    {
+        Input result;
+        result.compilation_database_ptr = Tsepepe::utils::clang_ast::parse_compilation_database(argv[1]);
+        result.project_root = Tsepepe::utils::fs::parse_and_validate_path(argv[2]);
+        return result;
+    } catch (const Tsepepe::Error& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return ReturnCode{1};
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+static void print_usage(int argc, const char** argv)
+{
+    auto program_path{argv[0]};
+    std::cout << "USAGE:\n\t" << program_path << " COMP_DB_DIR PROJECT_ROOT_DIR\n\n";
+    std::cout << "DESCRIPTION:\n\tBuilds, or brings up to date, the index of the class definitions found within the "
+                 "project\n\tunder PROJECT_ROOT_DIR. The index is stored in PROJECT_ROOT_DIR/.tsepepe/class_index.\n\t"
+                 "Requires compilation database (compile_commands.json) put in COMP_DB_DIR directory.\n\n\t"
+                 "Only the files, which have changed since they've been indexed, are parsed again.\n\n\t"
+                 "When the index exists, the implementor maker looks for the interface within the files\n\t"
+                 "pointed by the index, instead of parsing each file mentioning the interface name.\n\n"
+                 "NOTE:\n\tripgrep tool is used to find the files with class definitions, thus the .gitignore"
+                 " patterns are used to\n\tskip git-ignored directories.\n"
+              << std::endl;
+}
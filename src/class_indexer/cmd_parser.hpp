@@ -0,0 +1,20 @@
+/**
+ * @file        cmd_parser.hpp
+ * @brief       Command line parser for the class indexer.
+ */
+#ifndef CMD_PARSER_HPP
+#define CMD_PARSER_HPP
+
+#include <variant>
+
+#include "input.hpp"
+
+namespace Tsepepe::ClassIndexer
+{
+
+using ReturnCode = int;
+std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv);
+
+} // namespace Tsepepe::ClassIndexer
+
+#endif /* CMD_PARSER_HPP */
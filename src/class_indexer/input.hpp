@@ -0,0 +1,24 @@
+/**
+ * @file        input.hpp
+ * @brief       Input for the class indexer.
+ */
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <filesystem>
+#include <memory>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+namespace Tsepepe::ClassIndexer
+{
+
+struct Input
+{
+    std::unique_ptr<clang::tooling::CompilationDatabase> compilation_database_ptr;
+    std::filesystem::path project_root;
+};
+
+} // namespace Tsepepe::ClassIndexer
+
+#endif /* INPUT_HPP */
@@ -0,0 +1,36 @@
+/**
+ * @file	tool.cpp
+ * @brief	Entry point for the class indexer tool.
+ */
+
+#include <iostream>
+
+#include "cmd_parser.hpp"
+
+#include "base_error.hpp"
+#include "class_index.hpp"
+#include "libclang_utils/class_indexer.hpp"
+
+using namespace Tsepepe::ClassIndexer;
+
+int main(int argc, const char* argv[])
+{
+    auto input_or_return_code{parse_cmd(argc, argv)};
+    if (std::holds_alternative<ReturnCode>(input_or_return_code))
+        return std::get<ReturnCode>(input_or_return_code);
+
+    const auto& input{std::get<Input>(input_or_return_code)};
+
+    try
+    {
+        auto class_index{Tsepepe::ClassIndex::load(input.project_root)
+                             .value_or(Tsepepe::ClassIndex{input.project_root})};
+        Tsepepe::update_class_index(class_index, *input.compilation_database_ptr);
+        class_index.save();
+        return 0;
+    } catch (const Tsepepe::BaseError& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file	cmd_parser.cpp
+ * @brief	Implements command parsing for the daemon.
+ */
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+#include "cmd_parser.hpp"
+
+#include "cmd_utils.hpp"
+#include "error.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private declarations
+// --------------------------------------------------------------------------------------------------------------------
+static void print_usage(int argc, const char** argv);
+static fs::path parse_and_validate_socket_path(const char*);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private variables
+// --------------------------------------------------------------------------------------------------------------------
+static constexpr std::string_view watch_flag{"--watch"};
+static constexpr std::string_view memory_budget_flag{"--memory-budget"};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+namespace Tsepepe::Daemon
+{
+
+std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
+{
+    if (Tsepepe::utils::cmd::is_command_help_requested(argc, argv))
+    {
+        print_usage(argc, argv);
+        return ReturnCode{0};
+    }
+
+    try
+    {
+        Input result;
+        // The options precede the socket path.
+        int argument_index{1};
+        for (; argument_index < argc; ++argument_index)
+        {
+            std::string_view argument{argv[argument_index]};
+            if (argument == watch_flag)
+                result.is_file_watching_enabled = true;
+            else if (argument == memory_budget_flag and argument_index + 1 < argc)
+                result.ast_unit_cache_memory_budget_mib =
+                    Tsepepe::utils::cmd::parse_and_validate_number(argv[++argument_index]);
+            else
+                break;
+        }
+
+        if (argc - argument_index > 1)
+        {
+            std::cerr << "ERROR: Wrong number of arguments provided!\n" << std::endl;
+            print_usage(argc, argv);
+            return ReturnCode{1};
+        }
+
+        if (argument_index < argc)
+            result.socket_path = parse_and_validate_socket_path(argv[argument_index]);
+        return result;
+    } catch (const Tsepepe::Error& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return ReturnCode{1};
+    }
+}
+
+} // namespace Tsepepe::Daemon
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+static void print_usage(int argc, const char** argv)
+{
+    auto program_path{argv[0]};
+    std::cout << "USAGE:\n\t" << program_path << " [--watch] [--memory-budget MIB] [SOCKET_PATH]\n\n";
+    std::cout << "DESCRIPTION:"
+                 "\n\tServes the code actions: implementing an interface and generating function definitions,"
+                 "\n\tkeeping the compilation databases and the ASTs in memory between the requests. The files,"
+                 "\n\twhich haven't changed since the last request, are not parsed again."
+                 "\n\n\tWhen SOCKET_PATH is specified, listens on the Unix domain socket under that path."
+                 "\n\tOtherwise, reads the requests from the standard input and writes the responses to the"
+                 "\n\tstandard output."
+                 "\n\n\tWith --watch, the project root directories are watched with inotify, so the files aren't"
+                 "\n\tchecked for the changes on every request. The changes are read in a batch, before each"
+                 "\n\trequest, and only the ASTs depending on the changed files are dropped. The files outside"
+                 "\n\tthe project root directories, e.g. the system headers, are not watched then."
+                 "\n\n\tWith --memory-budget, the ASTs kept in memory take up to MIB mebibytes, 2048 by default."
+                 "\n\tThe least recently used ASTs are dropped beyond that."
+                 "\n\n\tEach request and response is a single line JSON object. A request:"
+                 "\n\n\t\t{\"method\": \"implement_interface\","
+                 "\n\t\t \"compilation_database_directory\": \"<PROJECT_ROOT>/build\","
+                 "\n\t\t \"params\": {\"root_directory\": \"<PROJECT_ROOT>\","
+                 "\n\t\t            \"source_file_path\": \"<PROJECT_ROOT>/src/implementor.hpp\","
+                 "\n\t\t            \"source_file_content\": \"struct Implementor { };\","
+                 "\n\t\t            \"interface_name\": \"YoloInterface\","
+                 "\n\t\t            \"cursor_position_line\": 1}}"
+                 "\n\n\tThe \"generate_function_definitions\" method takes \"source_file_path\","
+                 "\n\t\"source_file_content\", \"selected_line_begin\" and \"selected_line_end\" parameters."
+                 "\n\tThe \"shutdown\" method stops the daemon. The \"statistics\" method results with the AST"
+                 "\n\tcache hits, misses, evictions, invalidations and memory usage, as a JSON object."
+                 "\n\n\tA response contains either the \"result\" or the \"error\" string."
+                 "\n\n\tThe tsepepe_implementor_maker and tsepepe_function_definition_generator delegate"
+                 "\n\tthe work to the daemon, when the TSEPEPE_DAEMON_SOCKET environment variable is set"
+                 "\n\tto the SOCKET_PATH."
+                 "\n\n"
+              << std::endl;
+}
+
+static fs::path parse_and_validate_socket_path(const char* path_raw)
+{
+    fs::path path{path_raw};
+    auto parent_path{fs::absolute(path).parent_path()};
+    if (not fs::is_directory(parent_path))
+        throw Tsepepe::Error{"Parent path: " + parent_path.string() + " of the socket path: " + path.string()
+                             + " does not exist!"};
+    return path;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file        input.hpp
+ * @brief       Input for the daemon.
+ */
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <filesystem>
+#include <optional>
+
+namespace Tsepepe::Daemon
+{
+
+struct Input
+{
+    //! When not set, the requests are read from the standard input, and the responses are written to the standard
+    //! output.
+    std::optional<std::filesystem::path> socket_path;
+    bool is_file_watching_enabled{false};
+    //! When not set, the default budget of the AST cache is used.
+    std::optional<unsigned> ast_unit_cache_memory_budget_mib;
+};
+
+} // namespace Tsepepe::Daemon
+
+#endif /* INPUT_HPP */
@@ -0,0 +1,47 @@
+/**
+ * @file	tool.cpp
+ * @brief	The main app entry for the daemon.
+ */
+#include <iostream>
+
+#include "cmd_parser.hpp"
+
+#include "base_error.hpp"
+#include "clang_ast_utils.hpp"
+#include "code_action_server.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::Daemon;
+
+int main(int argc, const char** argv)
+{
+    auto input_or_return_code{parse_cmd(argc, argv)};
+    if (std::holds_alternative<ReturnCode>(input_or_return_code))
+        return std::get<ReturnCode>(input_or_return_code);
+
+    auto input{std::move(std::get<Input>(input_or_return_code))};
+
+    CodeActionServerOptions options{.is_file_watching_enabled = input.is_file_watching_enabled};
+    if (input.ast_unit_cache_memory_budget_mib)
+        options.ast_unit_cache_memory_budget = std::size_t{*input.ast_unit_cache_memory_budget_mib} << 20;
+
+    CodeActionServer server{
+        [](const std::filesystem::path& compilation_database_directory) {
+            return std::shared_ptr{
+                Tsepepe::utils::clang_ast::parse_compilation_database(compilation_database_directory)};
+        },
+        options};
+
+    try
+    {
+        if (input.socket_path)
+            server.serve(*input.socket_path);
+        else
+            server.serve(std::cin, std::cout);
+        return 0;
+    } catch (const Tsepepe::BaseError& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
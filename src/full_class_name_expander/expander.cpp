@@ -12,6 +12,8 @@
 #include "expander.hpp"
 
 #include "clang_ast_utils.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "trace.hpp"
 
 using namespace clang;
 using namespace clang::tooling;
@@ -49,11 +51,15 @@ std::string Tsepepe::FullClassNameExpander::expand(const Input& input)
     finder.addMatcher(class_matcher, &expander);
 
     ClangTool tool{*input.compilation_database_ptr, {input.header_file}};
+    tool.appendArgumentsAdjuster(Tsepepe::get_fast_parsing_arguments_adjuster());
 
     IgnoringDiagConsumer diagnostic_consumer;
     tool.setDiagnosticConsumer(&diagnostic_consumer);
 
-    tool.run(newFrontendActionFactory(&finder).get());
+    {
+        TraceSpan span{"ClangTool::run", input.header_file.string()};
+        tool.run(newFrontendActionFactory(&finder).get());
+    }
 
     return expander.get_result();
 }
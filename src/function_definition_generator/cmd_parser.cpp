@@ -2,12 +2,14 @@
  * @file	cmd_parser.cpp
  * @brief	Implements command parsing for the function definition generator.
  */
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 
 #include "cmd_parser.hpp"
 
-#include "clang_ast_utils.hpp"
 #include "cmd_utils.hpp"
 #include "error.hpp"
 #include "filesystem_utils.hpp"
@@ -19,6 +21,14 @@ namespace fs = std::filesystem;
 // --------------------------------------------------------------------------------------------------------------------
 static void print_usage(int argc, const char** argv);
 static fs::path parse_and_validate_temporary_file_path(const char*);
+static bool is_batch_mode_requested(int argc, const char** argv);
+static Tsepepe::FunctionDefinitionGenerator::BatchModeParameters parse_batch_mode_parameters(const char** args);
+static void validate_is_header_file(const fs::path&);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private variables
+// --------------------------------------------------------------------------------------------------------------------
+static constexpr const char* batch_mode_flag{"--batch"};
 
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
@@ -34,7 +44,8 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
         return ReturnCode{0};
     }
 
-    if (argc != 5 and argc != 6)
+    auto is_batch_mode{is_batch_mode_requested(argc, argv)};
+    if (is_batch_mode ? argc != 6 : (argc != 5 and argc != 6))
     {
         std::cerr << "ERROR: Wrong number of arguments provided!\n" << std::endl;
         print_usage(argc, argv);
@@ -44,7 +55,17 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
     try
     {
         Input result;
-        result.compilation_database_ptr = Tsepepe::utils::clang_ast::parse_compilation_database(argv[1]);
+        // The batch mode flag precedes the same leading arguments.
+        if (is_batch_mode)
+            ++argv;
+        result.compilation_database_directory = Tsepepe::utils::fs::parse_and_validate_path(argv[1]);
+        Tsepepe::utils::fs::parse_and_validate_path(result.compilation_database_directory / "compile_commands.json");
+
+        if (is_batch_mode)
+        {
+            result.parameters = parse_batch_mode_parameters(argv + 2);
+            return result;
+        }
 
         GenerateFunctionDefinitionsCodeActionParameters params;
         params.source_file_path = parse_and_validate_temporary_file_path(argv[2]);
@@ -78,6 +99,13 @@ static void print_usage(int argc, const char** argv)
                  " SOURCE_FILE_CONTENT"
                  " CURSOR_POSITION_LINE_BEGIN"
                  " [CURSOR_POSITION_LINE_END]"
+                 "\n\t"
+              << program_path
+              << " --batch"
+                 " COMP_DB_DIR"
+                 " PROJECT_ROOT"
+                 " HEADER_FILE_PATH"
+                 " HEADER_FILE_CONTENT"
                  " \n\n";
     std::cout << "DESCRIPTION:"
                  "\n\tTakes the entire source file (SOURCE_FILE_CONTENT) and generates function definitions"
@@ -90,6 +118,13 @@ static void print_usage(int argc, const char** argv)
                  "\n\twith the SOURCE_FILE_CONTENT parameter. Ideally, the newline separator should be '\\n 'character."
                  "\n\n\tWe need the path to the directory containing compile_commands.json as well,"
                  "\n\twhich shall be supplied with COMP_DB_DIR parameter."
+                 "\n\n\tIn the batch mode (--batch), the definitions are generated for all the functions declared"
+                 "\n\twithin the header (HEADER_FILE_CONTENT), which are not yet defined within the source file"
+                 "\n\tpaired with the header. The paired source file is looked for under PROJECT_ROOT, and must"
+                 "\n\tinclude the header. The entire header is parsed only once. Prints a JSON object:"
+                 "\n\t{\"file\": <paired source file path>, \"insertions\": [{\"offset\": <byte offset>,"
+                 " \"code\": <definitions>}]},"
+                 "\n\twith no insertions, when all the functions are defined already."
                  "\n\n"
               << std::endl;
 }
@@ -103,3 +138,25 @@ static fs::path parse_and_validate_temporary_file_path(const char* path_raw)
                              + " does not exist!"};
     return path;
 }
+
+static bool is_batch_mode_requested(int argc, const char** argv)
+{
+    return argc > 1 and std::strcmp(argv[1], batch_mode_flag) == 0;
+}
+
+static Tsepepe::FunctionDefinitionGenerator::BatchModeParameters parse_batch_mode_parameters(const char** args)
+{
+    auto project_root{fs::absolute(Tsepepe::utils::fs::parse_and_validate_path(args[0])).lexically_normal()};
+    auto header_file_path{fs::absolute(parse_and_validate_temporary_file_path(args[1])).lexically_normal()};
+    validate_is_header_file(header_file_path);
+    return {.project_root = std::move(project_root),
+            .header_file_path = std::move(header_file_path),
+            .header_file_content = args[2]};
+}
+
+static void validate_is_header_file(const fs::path& path)
+{
+    static constexpr std::array<const char*, 4> header_file_extensions{".hpp", ".hxx", ".h", ".hh"};
+    if (std::ranges::find(header_file_extensions, path.extension()) == std::end(header_file_extensions))
+        throw Tsepepe::Error{"Not a header file: " + path.string()};
+}
@@ -7,16 +7,27 @@
 
 #include <filesystem>
 #include <string>
+#include <variant>
 
 #include "generate_function_definitions_code_action.hpp"
 
 namespace Tsepepe::FunctionDefinitionGenerator
 {
 
+//! In the batch mode, the definitions are generated for all the functions declared within the header, and not yet
+//! defined within the paired source file.
+struct BatchModeParameters
+{
+    std::filesystem::path project_root;
+    std::filesystem::path header_file_path;
+    std::string header_file_content;
+};
+
 struct Input
 {
-    std::unique_ptr<clang::tooling::CompilationDatabase> compilation_database_ptr;
-    GenerateFunctionDefinitionsCodeActionParameters parameters;
+    //! The compilation database is parsed only when the code action is not delegated to the daemon.
+    std::filesystem::path compilation_database_directory;
+    std::variant<GenerateFunctionDefinitionsCodeActionParameters, BatchModeParameters> parameters;
 };
 
 } // namespace Tsepepe::FunctionDefinitionGenerator
@@ -0,0 +1,25 @@
+/**
+ * @file	paired_source_file.cpp
+ * @brief	Implements finding the source file paired with the header.
+ */
+#include <algorithm>
+
+#include "paired_source_file.hpp"
+
+#include "error.hpp"
+#include "paired_cpp_file_finder/finder.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+fs::path Tsepepe::FunctionDefinitionGenerator::find_paired_source_file(const fs::path& project_root,
+                                                                       const fs::path& header_file_path)
+{
+    auto matches{PairedCppFileFinder::find({.project_directory = project_root, .cpp_file = header_file_path})};
+    if (matches.empty())
+        throw Tsepepe::Error{"No paired source file found for: " + header_file_path.string()
+                             + ", under directory: " + project_root.string()};
+    return std::ranges::min(matches);
+}
@@ -0,0 +1,20 @@
+/**
+ * @file        paired_source_file.hpp
+ * @brief       Finds the source file paired with the header, to which the function definitions are generated.
+ */
+#ifndef PAIRED_SOURCE_FILE_HPP
+#define PAIRED_SOURCE_FILE_HPP
+
+#include <filesystem>
+
+namespace Tsepepe::FunctionDefinitionGenerator
+{
+
+//! Uses the paired C++ file finder. When many source files are found, the first one in the lexicographical order is
+//! taken. Throws Tsepepe::Error, when there is none.
+std::filesystem::path find_paired_source_file(const std::filesystem::path& project_root,
+                                              const std::filesystem::path& header_file_path);
+
+} // namespace Tsepepe::FunctionDefinitionGenerator
+
+#endif /* PAIRED_SOURCE_FILE_HPP */
@@ -5,13 +5,57 @@
 #include <iostream>
 
 #include "cmd_parser.hpp"
+#include "paired_source_file.hpp"
 
 #include "base_error.hpp"
+#include "clang_ast_utils.hpp"
+#include "code_action_client.hpp"
+#include "code_action_protocol.hpp"
+#include "error.hpp"
 #include "generate_function_definitions_code_action.hpp"
 
 using namespace Tsepepe;
 using namespace Tsepepe::FunctionDefinitionGenerator;
 
+static int print_result(const std::string& result)
+{
+    if (result.empty())
+    {
+        std::cerr << "ERROR: No valid declaration found!\n" << std::endl;
+        return 1;
+    }
+
+    std::cout << result;
+    return 0;
+}
+
+//! The batch mode is never delegated to the daemon, since it parses the header only once anyway.
+static int run_batch_mode(const std::filesystem::path& compilation_database_directory, BatchModeParameters params)
+{
+    try
+    {
+        auto paired_source_file_path{find_paired_source_file(params.project_root, params.header_file_path)};
+        auto compilation_database{utils::clang_ast::parse_compilation_database(compilation_database_directory)};
+        auto insertions{GenerateFunctionDefinitionsCodeActionLibclangBased{std::move(compilation_database)}.apply(
+            GenerateMissingFunctionDefinitionsCodeActionParameters{
+                .header_file_path = std::move(params.header_file_path),
+                .header_file_content = std::move(params.header_file_content),
+                .paired_source_file_path = paired_source_file_path})};
+        std::cout << serialize(FileCodeInsertions{.path = std::move(paired_source_file_path),
+                                                  .insertions = std::move(insertions)})
+                  << '\n';
+        return 0;
+    } catch (const Tsepepe::BaseError& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    } catch (const Tsepepe::Error& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
 int main(int argc, const char** argv)
 {
     auto input_or_return_code{parse_cmd(argc, argv)};
@@ -20,20 +64,33 @@ int main(int argc, const char** argv)
 
     auto input{std::move(std::get<Input>(input_or_return_code))};
 
-    try
-    {
-        auto result{GenerateFunctionDefinitionsCodeActionLibclangBased{std::move(input.compilation_database_ptr)}.apply(
-            std::move(input.parameters))};
+    if (std::holds_alternative<BatchModeParameters>(input.parameters))
+        return run_batch_mode(input.compilation_database_directory,
+                              std::get<BatchModeParameters>(std::move(input.parameters)));
 
-        if (result.empty())
+    auto parameters{std::get<GenerateFunctionDefinitionsCodeActionParameters>(std::move(input.parameters))};
+    if (auto response{try_delegating_to_daemon(
+            {.compilation_database_directory = input.compilation_database_directory, .parameters = parameters})})
+    {
+        if (response->is_error)
         {
-            std::cerr << "ERROR: No valid declaration found!\n" << std::endl;
+            std::cerr << "ERROR: " << response->content << std::endl;
             return 1;
         }
+        return print_result(response->content);
+    }
 
-        std::cout << result;
-        return 0;
+    try
+    {
+        auto compilation_database{utils::clang_ast::parse_compilation_database(input.compilation_database_directory)};
+        auto result{GenerateFunctionDefinitionsCodeActionLibclangBased{std::move(compilation_database)}.apply(
+            std::move(parameters))};
+        return print_result(result);
     } catch (const Tsepepe::BaseError& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    } catch (const Tsepepe::Error& e)
     {
         std::cerr << "ERROR: " << e.what() << std::endl;
         return 1;
@@ -2,12 +2,12 @@
  * @file	cmd_parser.cpp
  * @brief	Implements command parsing for pure virtual functions extractor.
  */
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 
 #include "cmd_parser.hpp"
 
-#include "clang_ast_utils.hpp"
 #include "cmd_utils.hpp"
 #include "error.hpp"
 #include "filesystem_utils.hpp"
@@ -19,6 +19,13 @@ namespace fs = std::filesystem;
 // --------------------------------------------------------------------------------------------------------------------
 static void print_usage(int argc, const char** argv);
 static fs::path parse_and_validate_temporary_file_path(const char*);
+static bool is_flag(int argc, const char** argv, int index, const char* flag);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private variables
+// --------------------------------------------------------------------------------------------------------------------
+static constexpr const char* batch_mode_flag{"--batch"};
+static constexpr const char* in_place_flag{"--in-place"};
 
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
@@ -34,17 +41,32 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
         return ReturnCode{0};
     }
 
-    if (argc != 7)
+    auto is_batch_mode{is_flag(argc, argv, 1, batch_mode_flag)};
+    auto is_in_place{is_batch_mode and is_flag(argc, argv, 2, in_place_flag)};
+    // The flags precede the same leading arguments.
+    auto flags_count{static_cast<int>(is_batch_mode) + static_cast<int>(is_in_place)};
+    if (is_batch_mode ? argc - flags_count != 4 : argc != 7)
     {
         std::cerr << "ERROR: Wrong number of arguments provided!\n" << std::endl;
         print_usage(argc, argv);
         return ReturnCode{1};
     }
+    argv += flags_count;
 
     try
     {
         Input result;
-        result.compilation_database_ptr = Tsepepe::utils::clang_ast::parse_compilation_database(argv[1]);
+        result.compilation_database_directory = Tsepepe::utils::fs::parse_and_validate_path(argv[1]);
+        Tsepepe::utils::fs::parse_and_validate_path(result.compilation_database_directory / "compile_commands.json");
+
+        if (is_batch_mode)
+        {
+            result.parameters = BatchModeParameters{
+                .parameters = {.root_directory = Tsepepe::utils::fs::parse_and_validate_path(argv[2]),
+                               .interface_name = argv[3]},
+                .is_in_place = is_in_place};
+            return result;
+        }
 
         ImplementInterfaceCodeActionParameters params;
         params.root_directory = Tsepepe::utils::fs::parse_and_validate_path(argv[2]);
@@ -77,6 +99,13 @@ static void print_usage(int argc, const char** argv)
                  " SOURCE_FILE_CONTENT"
                  " INTERFACE_NAME"
                  " CURSOR_POSITION_LINE"
+                 "\n\t"
+              << program_path
+              << " --batch"
+                 " [--in-place]"
+                 " COMP_DB_DIR"
+                 " ROOT_DIRECTORY"
+                 " INTERFACE_NAME"
                  " \n\n";
     std::cout << "DESCRIPTION:"
                  "\n\tTakes the entire source file (SOURCE_FILE_CONTENT) with a class definition,"
@@ -91,6 +120,12 @@ static void print_usage(int argc, const char** argv)
                  "\n\tmust be specified (e.g. for 'Namespace::Interface' simply pass 'Interface')."
                  "\n\n\tWe need the path to the directory containing compile_commands.json as well,"
                  "\n\twhich shall be supplied with COMP_DB_DIR parameter."
+                 "\n\n\tIn the batch mode (--batch), the overrides of the pure virtual functions are declared"
+                 "\n\tin all the classes under ROOT_DIRECTORY, which derive from INTERFACE_NAME, and miss any of"
+                 "\n\tthe overrides. The interface is parsed only once, and the implementors are parsed in parallel."
+                 "\n\tPrints a JSON object per each file to be modified, one per line:"
+                 "\n\t{\"file\": <path>, \"insertions\": [{\"offset\": <byte offset>, \"code\": <overrides>}]}."
+                 "\n\tWith --in-place, the insertions are applied to the files, and nothing is printed."
                  "\n\n"
                  "EXAMPLE:"
                  "\n\tHaving a project under path <PROJECT_ROOT>, and an interface defined within a file "
@@ -130,3 +165,8 @@ static fs::path parse_and_validate_temporary_file_path(const char* path_raw)
                              + " does not exist!"};
     return path;
 }
+
+static bool is_flag(int argc, const char** argv, int index, const char* flag)
+{
+    return argc > index and std::strcmp(argv[index], flag) == 0;
+}
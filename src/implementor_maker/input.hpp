@@ -7,16 +7,27 @@
 
 #include <filesystem>
 #include <string>
+#include <variant>
 
 #include "implement_interface_code_action.hpp"
+#include "implement_missing_overrides_code_action.hpp"
 
 namespace Tsepepe::ImplementorMaker
 {
 
+//! In the batch mode, the missing overrides are declared in all the implementors of the interface.
+struct BatchModeParameters
+{
+    ImplementMissingOverridesCodeActionParameters parameters;
+    //! Whether the insertions shall be applied to the files, instead of being printed.
+    bool is_in_place{false};
+};
+
 struct Input
 {
-    std::unique_ptr<clang::tooling::CompilationDatabase> compilation_database_ptr;
-    ImplementInterfaceCodeActionParameters parameters;
+    //! The compilation database is parsed only when the code action is not delegated to the daemon.
+    std::filesystem::path compilation_database_directory;
+    std::variant<ImplementInterfaceCodeActionParameters, BatchModeParameters> parameters;
 };
 
 } // namespace Tsepepe::ImplementorMaker
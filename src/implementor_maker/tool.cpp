@@ -6,13 +6,45 @@
 #include <iostream>
 
 #include "base_error.hpp"
+#include "clang_ast_utils.hpp"
 #include "cmd_parser.hpp"
+#include "error.hpp"
 #include "input.hpp"
 
+#include "code_action_client.hpp"
+#include "code_action_protocol.hpp"
+#include "code_insertions_applier.hpp"
 #include "implement_interface_code_action.hpp"
+#include "implement_missing_overrides_code_action.hpp"
 
 using namespace Tsepepe::ImplementorMaker;
 
+//! The batch mode is never delegated to the daemon, since it parses the interface only once anyway.
+static int run_batch_mode(const std::filesystem::path& compilation_database_directory, BatchModeParameters params)
+{
+    try
+    {
+        auto compilation_database{
+            Tsepepe::utils::clang_ast::parse_compilation_database(compilation_database_directory)};
+        auto result{Tsepepe::ImplementMissingOverridesCodeActionLibclangBased{std::move(compilation_database)}.apply(
+            std::move(params.parameters))};
+        for (auto& file_insertions : result)
+            if (params.is_in_place)
+                Tsepepe::apply_insertions_in_place(std::move(file_insertions));
+            else
+                std::cout << Tsepepe::serialize(file_insertions) << '\n';
+        return 0;
+    } catch (const Tsepepe::BaseError& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    } catch (const Tsepepe::Error& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
 int main(int argc, const char* argv[])
 {
     auto input_or_return_code{parse_cmd(argc, argv)};
@@ -21,13 +53,36 @@ int main(int argc, const char* argv[])
 
     auto input{std::move(std::get<Input>(input_or_return_code))};
 
+    if (std::holds_alternative<BatchModeParameters>(input.parameters))
+        return run_batch_mode(input.compilation_database_directory,
+                              std::get<BatchModeParameters>(std::move(input.parameters)));
+
+    auto parameters{std::get<Tsepepe::ImplementInterfaceCodeActionParameters>(std::move(input.parameters))};
+    if (auto response{Tsepepe::try_delegating_to_daemon(
+            {.compilation_database_directory = input.compilation_database_directory, .parameters = parameters})})
+    {
+        if (response->is_error)
+        {
+            std::cerr << "ERROR: " << response->content << std::endl;
+            return 1;
+        }
+        std::cout << response->content;
+        return 0;
+    }
+
     try
     {
-        auto result{Tsepepe::ImplementIntefaceCodeActionLibclangBased{std::move(input.compilation_database_ptr)}.apply(
-            std::move(input.parameters))};
+        auto compilation_database{
+            Tsepepe::utils::clang_ast::parse_compilation_database(input.compilation_database_directory)};
+        auto result{Tsepepe::ImplementIntefaceCodeActionLibclangBased{std::move(compilation_database)}.apply(
+            std::move(parameters))};
         std::cout << result;
         return 0;
     } catch (const Tsepepe::BaseError& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    } catch (const Tsepepe::Error& e)
     {
         std::cerr << "ERROR: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,156 @@
+/**
+ * @file        ast_unit_cache.hpp
+ * @brief       Cache of the ASTs built from the files on disk.
+ */
+#ifndef AST_UNIT_CACHE_HPP
+#define AST_UNIT_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "file_stamp.hpp"
+#include "include_graph.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+
+namespace Tsepepe
+{
+
+struct AstUnitCacheStatistics
+{
+    std::uint64_t hits;
+    std::uint64_t misses;
+    //! The ASTs dropped to fit within the memory budget.
+    std::uint64_t evictions;
+    //! The ASTs dropped, because a file they depend on has changed.
+    std::uint64_t invalidations;
+    //! The memory allocated by the ASTs kept in the cache, in bytes.
+    std::size_t memory_usage;
+};
+
+/** @brief Keeps the ASTs alive between the code action invocations, so that the files, which haven't changed, are not
+ * parsed again.
+ *
+ * The ASTs are keyed by the file, the compile command, and the content of the unsaved files, if any, so that the
+ * cache may be shared by the code actions of multiple projects. Once the memory allocated by the ASTs exceeds the
+ * budget, the least recently used ones are dropped. The memory is measured with the allocator statistics of the AST
+ * context and the source manager. The ASTs still used by a code action are released once it's done with them.
+ */
+class AstUnitCache
+{
+  public:
+    explicit AstUnitCache(std::size_t memory_budget = std::numeric_limits<std::size_t>::max());
+
+    //! Returns the AST of the file under the path. The AST is built again only if the file, or any file included by
+    //! it, has changed on disk since the last build. By default, the function bodies are skipped, since mostly the
+    //! declarations are looked at. The ASTs built with, and without, the function bodies are cached separately.
+    std::shared_ptr<clang::ASTUnit> get(const clang::tooling::CompilationDatabase&,
+                                        const std::filesystem::path&,
+                                        bool skip_function_bodies = true);
+
+    //! Same as above, but with the content of the unsaved files overlaid over the files on disk. The AST is reused
+    //! only when the content of the unsaved files is the same.
+    //!
+    //! When the file itself is the only unsaved file, e.g. the one being edited, its preamble, i.e. the leading block
+    //! of the preprocessor directives, is precompiled. Then, the AST built from its previous content is reparsed,
+    //! unless it's still used elsewhere, so that only the content past the unchanged preamble is parsed again.
+    std::shared_ptr<clang::ASTUnit> get(const clang::tooling::CompilationDatabase&,
+                                        const std::filesystem::path&,
+                                        const std::vector<UnsavedFile>&,
+                                        bool skip_function_bodies = true);
+
+    //! Removes the ASTs, which depend on any of the files, i.e. the ones built from the files, or including them,
+    //! directly or not. When a path points to a directory, any file within it is treated as changed. Only the
+    //! affected ASTs are looked at, so the ASTs of the files, which don't include a changed header, are kept.
+    void evict(const std::vector<std::filesystem::path>& changed_paths);
+
+    void clear();
+
+    //! Tells whether the changes of the file are told with evict(), e.g. by a FileWatcher.
+    using WatchedFilePredicate = std::function<bool(const std::filesystem::path&)>;
+
+    //! The dependencies of an AST, which are all watched, when it's built, are not checked on every get(). The other
+    //! ASTs, e.g. the ones including the generated headers, or the files outside of the watched directories, are still
+    //! checked. The predicate is called from multiple threads at once.
+    void set_watched_file_predicate(WatchedFilePredicate);
+
+    AstUnitCacheStatistics get_statistics() const;
+
+  private:
+    struct Dependency
+    {
+        std::string path;
+        //! Not set, when the file might have been modified while it was parsed, so that the AST is built again.
+        std::optional<FileStamp> stamp;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<clang::ASTUnit> ast_unit;
+        std::vector<Dependency> dependencies;
+        //! Set, when all the dependencies are watched, so they don't need to be checked.
+        bool is_fully_watched;
+        //! Only the hashes of the unsaved contents make a part of the key, so the contents are compared on a hit.
+        std::vector<std::string> unsaved_contents;
+        std::size_t memory_usage;
+        //! Identifies the file and its compile command, without the unsaved content. Empty, when the AST is not to be
+        //! reparsed.
+        std::string reparse_key;
+        std::size_t preamble_hash;
+        //! Points to the key within the recently used keys.
+        std::list<std::string>::iterator recent_use;
+    };
+
+    //! The AST built with the reparse key may be reparsed later, see: take_reparsable_ast_unit().
+    template<typename AstUnitBuilder>
+    std::shared_ptr<clang::ASTUnit> get(const std::string& key,
+                                        const AstUnitBuilder&,
+                                        const std::vector<UnsavedFile>& unsaved_files = {},
+                                        const std::string& reparse_key = {});
+
+    //! Takes the AST out of the cache, when it's been built with the same reparse key and the same preamble, and it's
+    //! not used elsewhere. Returns nullptr otherwise.
+    std::shared_ptr<clang::ASTUnit> take_reparsable_ast_unit(const std::string& reparse_key, std::string_view content);
+
+    //! Shall be called with the mutex locked.
+    void insert(const std::string& key, Entry);
+    void erase(const std::string& key);
+
+    static bool is_built_from(const Entry&, const std::vector<UnsavedFile>&);
+    static bool is_up_to_date(const Entry&);
+    //! The unsaved files are skipped, since their content is a part of the key. The build start time is in
+    //! nanoseconds since the epoch, as the file stamps.
+    static std::vector<Dependency> collect_dependencies(const clang::ASTUnit&,
+                                                        const std::vector<UnsavedFile>&,
+                                                        std::int64_t build_start_time);
+
+    const std::size_t memory_budget;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    //! The most recently used keys come first.
+    std::list<std::string> recently_used_keys;
+    //! Filled with the files entered by the preprocessor, when each AST is built.
+    IncludeGraph include_graph;
+    //! Maps the reparse key to the key of the latest AST built with it.
+    std::unordered_map<std::string, std::string> reparsable_keys;
+    WatchedFilePredicate is_watched;
+    AstUnitCacheStatistics statistics{};
+};
+
+} // namespace Tsepepe
+
+#endif /* AST_UNIT_CACHE_HPP */
@@ -0,0 +1,93 @@
+/**
+ * @file        class_index.hpp
+ * @brief       Persistent index of the class definitions found within a project.
+ */
+#ifndef CLASS_INDEX_HPP
+#define CLASS_INDEX_HPP
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_stamp.hpp"
+
+namespace Tsepepe
+{
+
+struct ClassIndexEntry
+{
+    std::string name;
+    std::string fully_qualified_name;
+    std::filesystem::path path;
+    //! Offset of the class name within the file.
+    unsigned offset;
+    //! Of a class with bases, it depends also on the bases, which may be defined in other files, and change without
+    //! the file with the class being changed.
+    bool is_abstract;
+    bool has_bases;
+
+    auto operator<=>(const ClassIndexEntry&) const = default;
+};
+
+//! Maps class names to the class definitions. The definitions are grouped by the files they are found in, and each
+//! file is stamped, when indexed, so that only the files, which have changed since, need to be indexed again.
+class ClassIndex
+{
+  public:
+    explicit ClassIndex(std::filesystem::path project_root);
+
+    //! Returns std::nullopt, when there is no index stored under the project root, or it has been stored with an
+    //! incompatible version.
+    static std::optional<ClassIndex> load(const std::filesystem::path& project_root);
+
+    //! Stores the index under the project root, in the '.tsepepe' directory.
+    void save() const;
+
+    static std::filesystem::path get_storage_path(const std::filesystem::path& project_root);
+
+    const std::filesystem::path& get_project_root() const;
+
+    //! Returns the definitions of the classes with the specified name (not fully qualified).
+    std::vector<ClassIndexEntry> find(const std::string& class_name) const;
+
+    //! Replaces the definitions previously found within the file. The stamp shall be taken before the file is read
+    //! to be indexed, so that the changes made in the meantime are detected.
+    void update_file(const std::filesystem::path&, FileStamp, std::vector<ClassIndexEntry>);
+
+    void remove_file(const std::filesystem::path&);
+
+    //! Tells whether the file is indexed and it hasn't changed since.
+    bool is_up_to_date(const std::filesystem::path&) const;
+
+    std::vector<std::filesystem::path> get_indexed_files() const;
+
+    //! Takes the files from the other index of the same project, which are not indexed here, or which are up to date
+    //! there, but not here. Allows a long living index not to overwrite the updates stored by another process.
+    void merge(const ClassIndex&);
+
+    //! Tells whether the index has changed since it has been loaded or saved.
+    bool is_modified() const;
+
+  private:
+    struct IndexedFile
+    {
+        FileStamp stamp;
+        std::vector<ClassIndexEntry> entries;
+    };
+
+    void add_to_lookup(const std::filesystem::path&, const std::vector<ClassIndexEntry>&);
+    void remove_from_lookup(const std::filesystem::path&, const std::vector<ClassIndexEntry>&);
+
+    std::filesystem::path project_root;
+    std::map<std::filesystem::path, IndexedFile> files;
+    std::unordered_map<std::string, std::set<std::filesystem::path>> files_by_class_name;
+    mutable bool modified{false};
+};
+
+} // namespace Tsepepe
+
+#endif /* CLASS_INDEX_HPP */
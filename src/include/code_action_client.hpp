@@ -0,0 +1,28 @@
+/**
+ * @file        code_action_client.hpp
+ * @brief       Delegates the code actions to the daemon.
+ */
+#ifndef CODE_ACTION_CLIENT_HPP
+#define CODE_ACTION_CLIENT_HPP
+
+#include <filesystem>
+#include <optional>
+
+#include "code_action_protocol.hpp"
+
+namespace Tsepepe
+{
+
+//! Name of the environment variable, which holds the path to the socket, on which the daemon listens.
+inline constexpr const char* daemon_socket_environment_variable{"TSEPEPE_DAEMON_SOCKET"};
+
+//! Throws BaseError, when the daemon can't be reached.
+CodeActionResponse send_code_action_request(const std::filesystem::path& socket_path, const CodeActionRequest&);
+
+//! Returns std::nullopt, when the daemon socket environment variable is not set, or no daemon listens on the socket,
+//! so that the caller can run the code action on its own.
+std::optional<CodeActionResponse> try_delegating_to_daemon(const CodeActionRequest&);
+
+} // namespace Tsepepe
+
+#endif /* CODE_ACTION_CLIENT_HPP */
@@ -0,0 +1,67 @@
+/**
+ * @file        code_action_protocol.hpp
+ * @brief       Serialization of the code action requests and responses, exchanged with the daemon.
+ */
+#ifndef CODE_ACTION_PROTOCOL_HPP
+#define CODE_ACTION_PROTOCOL_HPP
+
+#include <filesystem>
+#include <string>
+#include <variant>
+
+#include "ast_unit_cache.hpp"
+#include "common_types.hpp"
+#include "generate_function_definitions_code_action.hpp"
+#include "implement_interface_code_action.hpp"
+
+namespace Tsepepe
+{
+
+struct ShutdownParameters
+{
+};
+
+//! Asks for the AST cache statistics, serialized as the result.
+struct StatisticsParameters
+{
+};
+
+using CodeActionParameters = std::variant<ImplementInterfaceCodeActionParameters,
+                                          GenerateFunctionDefinitionsCodeActionParameters,
+                                          ShutdownParameters,
+                                          StatisticsParameters>;
+
+struct CodeActionRequest
+{
+    std::filesystem::path compilation_database_directory;
+    CodeActionParameters parameters;
+};
+
+struct CodeActionResponse
+{
+    //! The code action result, or the error message, when is_error is set.
+    std::string content;
+    bool is_error{false};
+};
+
+//! Serializes to a single line JSON object, so that the requests and responses can be delimited with newlines.
+std::string serialize(const CodeActionRequest&);
+std::string serialize(const CodeActionResponse&);
+
+//! Serializes to: {"file": <path>, "insertions": [{"offset": <byte offset>, "code": <code>}, ...]}, used by the tools
+//! which modify the files other than the one being edited.
+std::string serialize(const FileCodeInsertions&);
+
+//! Serializes to: {"hits": <count>, "misses": <count>, "evictions": <count>, "invalidations": <count>,
+//! "memory_usage": <bytes>}.
+std::string serialize(const AstUnitCacheStatistics&);
+
+//! Throws BaseError when the input is not a valid request.
+CodeActionRequest deserialize_code_action_request(const std::string&);
+
+//! Throws BaseError when the input is not a valid response.
+CodeActionResponse deserialize_code_action_response(const std::string&);
+
+} // namespace Tsepepe
+
+#endif /* CODE_ACTION_PROTOCOL_HPP */
@@ -0,0 +1,84 @@
+/**
+ * @file        code_action_server.hpp
+ * @brief       Serves the code actions, keeping the compilation databases and the ASTs warm between the requests.
+ */
+#ifndef CODE_ACTION_SERVER_HPP
+#define CODE_ACTION_SERVER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "ast_unit_cache.hpp"
+#include "code_action_protocol.hpp"
+#include "file_watcher.hpp"
+#include "generate_function_definitions_code_action.hpp"
+#include "implement_interface_code_action.hpp"
+
+namespace Tsepepe
+{
+
+//! Loads the compilation database from the directory, which contains compile_commands.json.
+using CompilationDatabaseLoader =
+    std::function<std::shared_ptr<clang::tooling::CompilationDatabase>(const std::filesystem::path&)>;
+
+struct CodeActionServerOptions
+{
+    //! When the file watching is enabled, the root directory of each project is watched, once a request refers to it,
+    //! and the ASTs, and the class indexes, are updated with the changes read before each request, instead of checking
+    //! each file for the changes.
+    bool is_file_watching_enabled{false};
+    //! The memory, in bytes, the ASTs shared by the code actions of all the projects may take. The least recently used
+    //! ones are dropped beyond that.
+    std::size_t ast_unit_cache_memory_budget{std::size_t{2} << 30};
+};
+
+class CodeActionServer
+{
+  public:
+    explicit CodeActionServer(CompilationDatabaseLoader, CodeActionServerOptions = {});
+
+    //! Handles a single request, serialized with the code action protocol, and returns the serialized response.
+    std::string handle(const std::string& request);
+
+    //! Serves the requests, one per line, until the input ends, or the shutdown is requested.
+    void serve(std::istream&, std::ostream&);
+
+    //! Listens on a Unix domain socket, until the shutdown is requested. Each connection may send multiple requests,
+    //! one per line, and receives a response line for each of them.
+    void serve(const std::filesystem::path& socket_path);
+
+    bool is_shutdown_requested() const;
+
+  private:
+    struct Project
+    {
+        std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database;
+        ImplementIntefaceCodeActionLibclangBased implement_interface_code_action;
+        GenerateFunctionDefinitionsCodeActionLibclangBased generate_function_definitions_code_action;
+    };
+
+    CodeActionResponse handle(CodeActionRequest);
+    Project& get_project(const std::filesystem::path& compilation_database_directory);
+
+    void watch(const std::filesystem::path& root_directory);
+    void apply_file_changes();
+    void disable_file_watching();
+
+    CompilationDatabaseLoader load_compilation_database;
+    std::shared_ptr<AstUnitCache> ast_unit_cache;
+    std::map<std::filesystem::path, Project> projects;
+    bool is_file_watching_enabled;
+    std::map<std::filesystem::path, std::unique_ptr<FileWatcher>> file_watchers;
+    bool shutdown_requested{false};
+};
+
+} // namespace Tsepepe
+
+#endif /* CODE_ACTION_SERVER_HPP */
@@ -15,6 +15,9 @@ namespace Tsepepe
 
 std::string apply_insertions(const std::string& input, std::vector<CodeInsertionByOffset> insertions);
 
+//! Applies the insertions to the file on disk. Throws BaseError, when the file can't be read, or written.
+void apply_insertions_in_place(FileCodeInsertions);
+
 }
 
 #endif /* CODE_INSERTIONS_APPLIER_HPP */
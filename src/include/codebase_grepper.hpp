@@ -6,6 +6,7 @@
 #define CODEBASE_GREPPER_HPP
 
 #include <filesystem>
+#include <functional>
 #include <vector>
 
 #include "common_types.hpp"
@@ -22,9 +23,30 @@ struct GrepMatch
     auto operator<=>(const GrepMatch&) const = default;
 };
 
-// FIXME: actually RustRegexPattern is used here!
+//! Searches the C++ files under the root directory, line by line, skipping the hidden files and the ones ignored by
+//! .gitignore, the way ripgrep does. The matches are sorted. Rethrows the exceptions thrown while searching a file,
+//! e.g. std::regex_error, when the pattern is too complex to match a line.
 std::vector<GrepMatch> codebase_grep(RootDirectory, EcmaScriptPattern);
 
+//! Returns false to stop the walk.
+using CodebaseVisitor = std::function<bool(const std::filesystem::path&)>;
+
+//! Called before the directory is read. Returns false to skip the directory, together with its subdirectories.
+using CodebaseDirectoryVisitor = std::function<bool(const std::filesystem::path&)>;
+
+/** @brief Walks the same C++ files, as the ones searched by codebase_grep(), with multiple threads.
+ *
+ * The visitors are called from multiple threads at once, in no particular order, but a directory is always visited
+ * before the files within it. Once the file visitor returns false, no new files are visited, but the ones being
+ * visited by the other threads at that moment are finished. The same happens, when a visitor throws: the first
+ * exception thrown is rethrown, once all the threads are done.
+ */
+void walk_codebase(RootDirectory, const CodebaseVisitor&, const CodebaseDirectoryVisitor& = {});
+
+//! Tells whether walk_codebase() skips the directory, when it walks any of the parent directories, i.e. when it's
+//! hidden, or ignored by .gitignore. Allows to tell whether a directory created after the walk belongs to the codebase.
+bool is_directory_skipped_by_codebase_walk(const std::filesystem::path&);
+
 } // namespace Tsepepe
 
 #endif /* CODEBASE_GREPPER_HPP */
@@ -6,6 +6,8 @@
 #define COMMON_TYPES_HPP
 
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include <NamedType/named_type.hpp>
 
@@ -24,6 +26,14 @@ struct CodeInsertionByOffset
     auto operator<=>(const CodeInsertionByOffset&) const = default;
 };
 
+struct FileCodeInsertions
+{
+    std::filesystem::path path;
+    std::vector<CodeInsertionByOffset> insertions;
+
+    auto operator<=>(const FileCodeInsertions&) const = default;
+};
+
 } // namespace Tsepepe
 
 #endif /* COMMON_TYPES_HPP */
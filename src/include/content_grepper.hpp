@@ -0,0 +1,59 @@
+/**
+ * @file        content_grepper.hpp
+ * @brief       Greps the content already loaded into memory.
+ */
+#ifndef CONTENT_GREPPER_HPP
+#define CONTENT_GREPPER_HPP
+
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common_types.hpp"
+
+namespace Tsepepe
+{
+
+struct ContentGrepMatch
+{
+    unsigned line;
+    unsigned column;
+    //! Differs from the line only for the matches spanning multiple lines.
+    unsigned last_line;
+
+    auto operator<=>(const ContentGrepMatch&) const = default;
+};
+
+//! Compiles the pattern once, so that it can be matched against many contents, also from multiple threads.
+//!
+//! The lines and columns are counted from 1, and the columns are byte offsets. The matches don't overlap.
+class ContentGrepper
+{
+  public:
+    //! In the multiline mode the matches may span multiple lines, and '^' and '$' match at the line boundaries.
+    //! Otherwise, each line is matched separately, the same way as ripgrep does it.
+    explicit ContentGrepper(EcmaScriptPattern, bool is_multiline = false);
+
+    std::vector<ContentGrepMatch> grep(std::string_view content) const;
+
+  private:
+    void grep_lines(std::string_view content, std::vector<ContentGrepMatch>& result) const;
+    void grep_multiline(std::string_view content, std::vector<ContentGrepMatch>& result) const;
+
+    //! Returns the position, such that no line before the one containing it has a match, or nullptr, when there is
+    //! no match within the range at all.
+    const char* find_candidate(const char* begin, const char* end) const;
+
+    std::regex regex;
+    //! Each match contains it, so only the content containing it is run through the regex.
+    std::string required_literal;
+    //! Tells whether the line-by-line regex may be run over the entire content, to quickly find the first line with
+    //! a match.
+    bool can_search_entire_content;
+    bool is_multiline;
+};
+
+} // namespace Tsepepe
+
+#endif /* CONTENT_GREPPER_HPP */
@@ -5,6 +5,7 @@
 #ifndef FILE_GREPPER_HPP
 #define FILE_GREPPER_HPP
 
+#include <string>
 #include <vector>
 
 #include "common_types.hpp"
@@ -20,6 +21,8 @@ struct GrepOptions
     unsigned enable_multiline_regex : 1 {0};
 };
 
+//! Returns the numbers of the lines with a match, in the ascending order. With the multiline regex enabled, all the
+//! lines spanned by a match are returned.
 FileGrepMatches grep_file(const std::string& file_content, RustRegexPattern, GrepOptions options = {});
 
 } // namespace Tsepepe
@@ -0,0 +1,29 @@
+/**
+ * @file        file_stamp.hpp
+ * @brief       Allows to tell whether a file has changed.
+ */
+#ifndef FILE_STAMP_HPP
+#define FILE_STAMP_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace Tsepepe
+{
+
+struct FileStamp
+{
+    //! In nanoseconds, since the epoch.
+    std::int64_t modification_time;
+    std::uint64_t size;
+
+    auto operator<=>(const FileStamp&) const = default;
+};
+
+//! Returns std::nullopt, when the file doesn't exist.
+std::optional<FileStamp> get_file_stamp(const std::filesystem::path&);
+
+} // namespace Tsepepe
+
+#endif /* FILE_STAMP_HPP */
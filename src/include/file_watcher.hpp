@@ -0,0 +1,77 @@
+/**
+ * @file        file_watcher.hpp
+ * @brief       Watches the project directories for the file changes, with inotify.
+ */
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Tsepepe
+{
+
+struct FileChanges
+{
+    //! The files created, modified, removed or renamed, including the ones found within the new directories.
+    std::set<std::filesystem::path> files;
+    //! The directories, which have got any entry created, removed or renamed.
+    std::set<std::filesystem::path> directories;
+    //! The directories removed, or moved away, together with everything within them.
+    std::set<std::filesystem::path> removed_directories;
+    //! Set, when the kernel has dropped some events, so any file might have changed.
+    bool is_overflowed{false};
+
+    bool empty() const
+    {
+        return files.empty() and directories.empty() and removed_directories.empty() and not is_overflowed;
+    }
+};
+
+/** @brief Watches the same directories, as the ones walked by walk_codebase(), so that the caches built from the
+ * files are updated only with the files, which have changed, without checking each file on every lookup.
+ *
+ * The new directories are watched, as soon as their creation is read, and the files found within them are reported
+ * as changed, since they might have been created before the directory has been watched, unless they are ignored by
+ * .gitignore. The hidden files are not reported. Throws BaseError, when inotify fails, e.g. when the limit of the
+ * watches is reached.
+ */
+class FileWatcher
+{
+  public:
+    explicit FileWatcher(std::filesystem::path root);
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    ~FileWatcher();
+
+    //! Waits, up to the timeout, for the first change, and then collects all the changes read so far in a single
+    //! batch, so that a burst of the events, e.g. the one caused by switching a git branch, is handled at once.
+    FileChanges read_changes(std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+    //! Tells whether the changes of the file are reported, i.e. it's not hidden, and it's within a watched directory.
+    //! The path shall be canonical. May be called from multiple threads at once, but not during read_changes().
+    bool is_watched(const std::filesystem::path& file) const;
+
+  private:
+    //! Watches the directory and all the subdirectories. The files found within them are added to the changes, if
+    //! any are supplied.
+    void watch_directory_tree(const std::filesystem::path&, FileChanges* = nullptr);
+    void unwatch_directory_tree(const std::filesystem::path&);
+
+    //! Returns false, when there are no more events to read.
+    bool read_events(FileChanges&);
+
+    std::filesystem::path root;
+    int fd;
+    std::unordered_map<int, std::filesystem::path> watched_directories;
+    std::unordered_set<std::string> watched_directory_paths;
+};
+
+} // namespace Tsepepe
+
+#endif /* FILE_WATCHER_HPP */
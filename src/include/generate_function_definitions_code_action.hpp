@@ -6,10 +6,14 @@
 #define GENERATE_FUNCTION_DEFINITIONS_CODE_ACTION_HPP
 
 #include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <clang/Tooling/CompilationDatabase.h>
 
-#include "directory_tree.hpp"
+#include "ast_unit_cache.hpp"
+#include "common_types.hpp"
 
 namespace Tsepepe
 {
@@ -22,23 +26,40 @@ struct GenerateFunctionDefinitionsCodeActionParameters
     unsigned selected_line_end;
 };
 
+struct GenerateMissingFunctionDefinitionsCodeActionParameters
+{
+    std::filesystem::path header_file_path;
+    std::string header_file_content;
+    //! The source file, which includes the header, and to which the definitions are appended.
+    std::filesystem::path paired_source_file_path;
+};
+
 class GenerateFunctionDefinitionsCodeActionLibclangBased
 {
   public:
-    explicit GenerateFunctionDefinitionsCodeActionLibclangBased(std::shared_ptr<clang::tooling::CompilationDatabase>);
+    //! The AST cache may be shared with the other code actions. Otherwise, the action keeps its own one.
+    explicit GenerateFunctionDefinitionsCodeActionLibclangBased(std::shared_ptr<clang::tooling::CompilationDatabase>,
+                                                                std::shared_ptr<AstUnitCache> = nullptr);
 
     std::string apply(GenerateFunctionDefinitionsCodeActionParameters);
 
+    /** @brief Generates the definitions of all the functions declared within the header, but not defined anywhere.
+     *
+     * The paired source file is parsed from disk, with the header content taken from memory, so that a single AST
+     * tells both the declarations and the definitions, which already exist. The pure virtual functions, the friends,
+     * and the inline, constexpr, or templated functions, are skipped, since their definitions don't belong to the
+     * source file. Results with the insertion of all the definitions at the end of the source file, or with no
+     * insertions, when nothing is missing. Throws BaseError, when the source file doesn't include the header.
+     */
+    std::vector<CodeInsertionByOffset> apply(GenerateMissingFunctionDefinitionsCodeActionParameters);
+
   private:
     void validate_selected_range(const GenerateFunctionDefinitionsCodeActionParameters&) const;
 
-    std::filesystem::path make_temporary_source_file(const std::filesystem::path& path,
-                                                     const std::string& file_content);
-
     std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database;
-
-    DirectoryTree tsepepe_temp_directory_tree;
-    DirectoryTree this_code_action_directory_tree;
+    //! The action is usually applied repeatedly on the same file, with only the function declarations changing, so
+    //! the AST of the file is reparsed, with its preamble reused.
+    std::shared_ptr<AstUnitCache> ast_unit_cache;
 };
 
 } // namespace Tsepepe
@@ -0,0 +1,51 @@
+/**
+ * @file        gitignore.hpp
+ * @brief       Matches paths against the rules read from .gitignore files.
+ */
+#ifndef GITIGNORE_HPP
+#define GITIGNORE_HPP
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Tsepepe
+{
+
+//! Holds the rules read from a single .gitignore file, which apply to the paths under the directory the file is
+//! located in. The .gitignore files found in the parent directories are chained, so that when none of the rules
+//! matches the path, then the rules from the parent directory decide.
+class GitIgnore
+{
+  public:
+    GitIgnore(const std::string& content,
+              std::filesystem::path directory,
+              std::shared_ptr<const GitIgnore> parent = nullptr);
+
+    //! The path shall be expressed the same way as the directory passed on construction, e.g. both absolute and
+    //! normalized.
+    bool is_ignored(const std::filesystem::path&, bool is_directory) const;
+
+  private:
+    struct Rule
+    {
+        std::string pattern;
+        bool is_negated;
+        bool is_directory_only;
+        //! Anchored rules are matched against the path relative to the directory, others against the file name only.
+        bool is_anchored;
+    };
+
+    //! Returns std::nullopt, when none of the rules from this file matches the path.
+    std::optional<bool> match(const std::filesystem::path&, bool is_directory) const;
+
+    std::filesystem::path directory;
+    std::vector<Rule> rules;
+    std::shared_ptr<const GitIgnore> parent;
+};
+
+} // namespace Tsepepe
+
+#endif /* GITIGNORE_HPP */
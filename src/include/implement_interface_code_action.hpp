@@ -6,10 +6,15 @@
 #define IMPLEMENT_INTERFACE_CODE_ACTION_HPP
 
 #include <filesystem>
+#include <map>
 #include <string>
 
 #include <clang/Tooling/CompilationDatabase.h>
 
+#include "ast_unit_cache.hpp"
+#include "class_index.hpp"
+#include "file_watcher.hpp"
+
 namespace Tsepepe
 {
 
@@ -27,12 +32,28 @@ struct ImplementInterfaceCodeActionParameters
 class ImplementIntefaceCodeActionLibclangBased
 {
   public:
-    explicit ImplementIntefaceCodeActionLibclangBased(std::shared_ptr<clang::tooling::CompilationDatabase>);
+    //! When the AST unit cache is supplied, the ASTs of the files, within which the interface is looked for, and the
+    //! AST of the implementor, built from the unsaved content, are kept in it, between the invocations.
+    //!
+    //! When the project root contains the class index, the interface is looked for within the files pointed by the
+    //! index first. The index is kept in memory between the invocations, and updated with the files parsed on the
+    //! way.
+    explicit ImplementIntefaceCodeActionLibclangBased(std::shared_ptr<clang::tooling::CompilationDatabase>,
+                                                      std::shared_ptr<AstUnitCache> = nullptr);
 
     NewFileContent apply(ImplementInterfaceCodeActionParameters);
 
+    //! Drops the removed files from the class index kept in memory for the project. The modified files are indexed
+    //! again, once they are parsed, since their stamps are checked then anyway.
+    void update_class_index(const std::filesystem::path& project_root, const FileChanges&);
+
   private:
+    //! Returns nullptr, when there is no class index stored under the project root.
+    ClassIndex* get_class_index(const std::filesystem::path& project_root);
+
     std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database;
+    std::shared_ptr<AstUnitCache> ast_unit_cache;
+    std::map<std::filesystem::path, ClassIndex> class_indexes;
 };
 
 }; // namespace Tsepepe
@@ -0,0 +1,55 @@
+/**
+ * @file        implement_missing_overrides_code_action.hpp
+ * @brief       Code action which implements the missing overrides in all the implementors of an interface.
+ */
+#ifndef IMPLEMENT_MISSING_OVERRIDES_CODE_ACTION_HPP
+#define IMPLEMENT_MISSING_OVERRIDES_CODE_ACTION_HPP
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "ast_unit_cache.hpp"
+#include "common_types.hpp"
+
+namespace Tsepepe
+{
+
+struct ImplementMissingOverridesCodeActionParameters
+{
+    std::filesystem::path root_directory;
+    std::string interface_name;
+};
+
+/** @brief Declares the overrides of the pure virtual functions, which are missing in the implementors of an interface.
+ *
+ * Meant to be used, when a pure virtual function is added to an interface, which is implemented across the project.
+ * The interface is parsed once, and its AST is shared by all the implementors. The files, which mention the interface
+ * name, are parsed in parallel, and each class defined within them, which derives from the interface, directly or
+ * not, gets the overrides of the pure virtual functions it doesn't override yet. The classes, which declare the pure
+ * virtual functions on their own, are skipped, since they are the interfaces as well.
+ */
+class ImplementMissingOverridesCodeActionLibclangBased
+{
+  public:
+    //! When the AST unit cache is supplied, the ASTs of the interface, and of the implementors, are kept in it.
+    explicit ImplementMissingOverridesCodeActionLibclangBased(std::shared_ptr<clang::tooling::CompilationDatabase>,
+                                                              std::shared_ptr<AstUnitCache> = nullptr,
+                                                              unsigned max_workers_count = 0);
+
+    //! Returns the insertions for each file with an implementor, which misses any override, sorted by the paths.
+    //! Throws BaseError, when no interface with the name is found under the root directory.
+    std::vector<FileCodeInsertions> apply(ImplementMissingOverridesCodeActionParameters);
+
+  private:
+    std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database;
+    std::shared_ptr<AstUnitCache> ast_unit_cache;
+    const unsigned max_workers_count;
+};
+
+} // namespace Tsepepe
+
+#endif /* IMPLEMENT_MISSING_OVERRIDES_CODE_ACTION_HPP */
@@ -0,0 +1,49 @@
+/**
+ * @file        include_graph.hpp
+ * @brief       Tells which translation units depend on a header.
+ */
+#ifndef INCLUDE_GRAPH_HPP
+#define INCLUDE_GRAPH_HPP
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tsepepe
+{
+
+/** @brief Maps each file to the translation units, which include it, directly or not, so that the caches built from
+ * the translation units can drop only the ones affected by a change.
+ *
+ * The lookup takes the time proportional to the number of the affected translation units, rather than to the number
+ * of all of them. The paths are compared as they are, so they shall be normalized the same way by the callers. Not
+ * thread safe.
+ */
+class IncludeGraph
+{
+  public:
+    //! Replaces the files previously included by the translation unit. The main file of the translation unit may be
+    //! among them.
+    void set_included_files(const std::string& translation_unit, const std::vector<std::string>& included_files);
+
+    void remove_translation_unit(const std::string& translation_unit);
+
+    //! Returns the translation units built from the file, or including it, directly or not. When the path points to a
+    //! directory, the ones depending on any file within it are returned.
+    std::set<std::string> get_dependent_translation_units(const std::string& path) const;
+
+    std::vector<std::string> get_included_files(const std::string& translation_unit) const;
+
+    void clear();
+
+  private:
+    std::unordered_map<std::string, std::vector<std::string>> included_files_by_translation_unit;
+    //! Ordered, so that the files within a directory are next to each other.
+    std::map<std::string, std::set<std::string>> translation_units_by_file;
+};
+
+} // namespace Tsepepe
+
+#endif /* INCLUDE_GRAPH_HPP */
@@ -0,0 +1,54 @@
+/**
+ * @file        class_indexer.hpp
+ * @brief       Fills the class index from the Clang ASTs.
+ */
+#ifndef CLASS_INDEXER_HPP
+#define CLASS_INDEXER_HPP
+
+#include <filesystem>
+#include <vector>
+
+#include <clang/AST/ASTContext.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "class_index.hpp"
+#include "libclang_utils/match_queries.hpp"
+
+namespace Tsepepe
+{
+
+//! Collects the class definitions, which are located within the main file of the AST.
+std::vector<ClassIndexEntry> collect_class_definitions(clang::ASTContext&);
+
+//! Matches the class definitions, which are located within the main file of the AST. Allows to collect the class
+//! definitions within the same traversal, as the other queries, see: MatchQueries.
+clang::ast_matchers::DeclarationMatcher get_class_definition_matcher();
+
+//! Makes the entries out of the matches of the class definition matcher.
+std::vector<ClassIndexEntry> to_class_index_entries(const MatchQueries::Matches&, const clang::SourceManager&);
+
+//! Indexes the main file of the AST, unless the index is already up to date with it. The stamp shall be taken before
+//! the file is parsed, see: ClassIndex::update_file().
+void index_main_file(ClassIndex&, const std::filesystem::path& main_file_path, FileStamp, clang::ASTContext&);
+
+//! Indexes the file with the class definitions collected already, unless the index is already up to date with it.
+void index_main_file(ClassIndex&,
+                     const std::filesystem::path& main_file_path,
+                     FileStamp,
+                     std::vector<ClassIndexEntry>);
+
+//! Parses the file, and replaces the definitions found within it before. Returns false, when the file can't be parsed.
+bool index_file(ClassIndex&, const clang::tooling::CompilationDatabase&, const std::filesystem::path&);
+
+/** @brief Brings the entire index up to date with the project.
+ *
+ * The C++ files under the project root, which contain a class definition, are looked for. The files, which are
+ * indexed, but no longer contain a class definition, are removed from the index. Only the files, which have changed
+ * since they've been indexed, or haven't been indexed yet, are parsed.
+ */
+void update_class_index(ClassIndex&, const clang::tooling::CompilationDatabase&);
+
+} // namespace Tsepepe
+
+#endif /* CLASS_INDEXER_HPP */
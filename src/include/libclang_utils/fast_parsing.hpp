@@ -0,0 +1,25 @@
+/**
+ * @file        fast_parsing.hpp
+ * @brief       Speeds up parsing, when only the declarations are looked at.
+ */
+#ifndef FAST_PARSING_HPP
+#define FAST_PARSING_HPP
+
+#include <clang/Tooling/ArgumentsAdjusters.h>
+
+namespace Tsepepe
+{
+
+/** @brief Adjusts the compile commands to parse faster, without affecting the declarations.
+ *
+ * The warnings are disabled. When the function bodies are skipped, the bodies of all the functions, which are not
+ * constexpr and don't have a deduced return type, are not parsed; this includes the inline functions from the
+ * included headers, and the function templates, which are then never instantiated. Such a function is still
+ * a definition, but it ends at its declarator, so the function bodies shall not be skipped, when the source ranges of
+ * the definitions are used.
+ */
+clang::tooling::ArgumentsAdjuster get_fast_parsing_arguments_adjuster(bool skip_function_bodies = true);
+
+} // namespace Tsepepe
+
+#endif /* FAST_PARSING_HPP */
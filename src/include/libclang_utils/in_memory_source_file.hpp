@@ -0,0 +1,65 @@
+/**
+ * @file        in_memory_source_file.hpp
+ * @brief       Allows to parse the unsaved content of a source file, without writing it to disk.
+ */
+#ifndef IN_MEMORY_SOURCE_FILE_HPP
+#define IN_MEMORY_SOURCE_FILE_HPP
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+namespace Tsepepe
+{
+
+//! Returns the file system, over which the files shall be parsed. The real file system would change the working
+//! directory of the whole process to the one of the compile command, which races with the other files parsed at once;
+//! the returned one keeps its own working directory.
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> make_parsing_file_system();
+
+//! Returns the path, under which the content of the source file is parsed. If the path is a directory, then a file
+//! within that directory is assumed: ".tsepepe_<id>_temp.hpp", which never appears on disk.
+std::filesystem::path get_in_memory_source_file_path(const std::filesystem::path&, const std::string& id);
+
+struct InMemoryAstBuildOptions
+{
+    //! Precompiles the preamble - the leading block of the preprocessor directives, with the includes - so that the
+    //! AST may be reparsed later, with a new content, without parsing the included files again.
+    unsigned precompile_preamble : 1 {0};
+    //! See get_fast_parsing_arguments_adjuster().
+    unsigned skip_function_bodies : 1 {0};
+};
+
+//! Builds the AST of the file under the path, with its content taken from memory. The content is overlaid over the
+//! real file system, so the files included by it are still read from disk, but nothing is written there. The file is
+//! parsed in the fast parsing mode.
+std::unique_ptr<clang::ASTUnit> build_ast_from_memory(const clang::tooling::CompilationDatabase&,
+                                                      const std::filesystem::path&,
+                                                      const std::string& content,
+                                                      InMemoryAstBuildOptions = {});
+
+//! The content of a file, e.g. the one being edited, which overrides the content on disk. The content must outlive the
+//! AST build.
+struct UnsavedFile
+{
+    std::filesystem::path path;
+    std::string_view content;
+};
+
+//! Builds the AST of the file under the path, with the content of the unsaved files overlaid over the real file system.
+//! The parsed file itself may be one of the unsaved files. Allows, e.g., to parse a source file from disk, together
+//! with the unsaved content of the header it includes.
+std::unique_ptr<clang::ASTUnit> build_ast_with_unsaved_files(const clang::tooling::CompilationDatabase&,
+                                                             const std::filesystem::path&,
+                                                             const std::vector<UnsavedFile>&,
+                                                             InMemoryAstBuildOptions = {});
+
+} // namespace Tsepepe
+
+#endif /* IN_MEMORY_SOURCE_FILE_HPP */
@@ -0,0 +1,44 @@
+/**
+ * @file        match_queries.hpp
+ * @brief       Runs multiple AST matchers within a single traversal of the AST.
+ */
+#ifndef MATCH_QUERIES_HPP
+#define MATCH_QUERIES_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <clang/AST/ASTContext.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+
+namespace Tsepepe
+{
+
+/** @brief Registers multiple matchers, which are then run within a single traversal of the AST.
+ *
+ * Each ast_matchers::match() call walks the entire AST, so when multiple facts are needed from the same translation
+ * unit, the matchers shall be registered here, and run at once. The matches of each matcher are collected separately,
+ * in the order of the traversal, the same as ast_matchers::match() would return them.
+ */
+class MatchQueries
+{
+  public:
+    using QueryId = std::size_t;
+    using Matches = std::vector<clang::ast_matchers::BoundNodes>;
+
+    //! Returns the id to get the matches of the matcher with, after the run.
+    QueryId add(clang::ast_matchers::DeclarationMatcher);
+
+    //! Traverses the AST once. The matches from the previous run are discarded.
+    void run(clang::ASTContext&);
+
+    const Matches& get_matches(QueryId) const;
+
+  private:
+    std::vector<clang::ast_matchers::DeclarationMatcher> matchers;
+    std::vector<Matches> matches;
+};
+
+} // namespace Tsepepe
+
+#endif /* MATCH_QUERIES_HPP */
@@ -5,6 +5,7 @@
 #ifndef PURE_VIRTUAL_FUNCTIONS_EXTRACTOR_HPP
 #define PURE_VIRTUAL_FUNCTIONS_EXTRACTOR_HPP
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,9 @@ namespace Tsepepe
 
 using OverrideDeclarations = std::vector<std::string>;
 
+//! Tells whether the pure virtual function shall be turned into the override declaration.
+using PureVirtualFunctionFilter = std::function<bool(const clang::CXXMethodDecl*)>;
+
 /** @brief Extract all pure virtual functions from interface_node and turn then into override declarations.
  *
  * This will iterate over each method within the interface (pointed by the interface_node) and all its base classes
@@ -33,12 +37,15 @@ using OverrideDeclarations = std::vector<std::string>;
  * @param interface_node Pointer to the definition of the interface from which the pure virtual functions will be
  *                       extracted.
  * @param implementor_fully_qualified_name Fully qualified name of the implementor. See above for explanation.
+ * @param filter When set, only the pure virtual functions it accepts are turned into the override declarations, e.g.
+ *               the ones, which the implementor doesn't override yet.
  * @returns The override declarations, ready to put straight into the implementor class, line by line.
  */
 OverrideDeclarations pure_virtual_functions_to_override_declarations(
     const clang::CXXRecordDecl* interface_node,
     std::string implementor_fully_qualified_name, // FIXME: use FullyQualifiedName type
-    const clang::SourceManager&);
+    const clang::SourceManager&,
+    const PureVirtualFunctionFilter& filter = {});
 
 } // namespace Tsepepe
 
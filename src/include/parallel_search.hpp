@@ -0,0 +1,153 @@
+/**
+ * @file        parallel_search.hpp
+ * @brief       Runs a search over multiple inputs on a pool of threads.
+ */
+#ifndef PARALLEL_SEARCH_HPP
+#define PARALLEL_SEARCH_HPP
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Tsepepe
+{
+
+//! Calls the job for each of the inputs, on at most max_workers_count threads, and returns the result of the job for
+//! the input with the lowest index, for which the job returned a value. That way the outcome is the same as if the
+//! jobs were called one by one, stopping at the first result. The job throwing for an input, e.g. because the file
+//! fails to be parsed, is treated as no result for it; the exception thrown for the lowest input is rethrown only
+//! when there is no result for any input.
+//!
+//! Once a result is found, the jobs for the inputs with greater indexes are not started anymore; the ones, which are
+//! already running, are let to finish, but their results are discarded.
+//!
+//! The job shall return a type, which converts to bool, telling whether there is a result, e.g. std::optional.
+template<typename Input, typename Job>
+std::invoke_result_t<Job&, const Input&> find_first_in_parallel(const std::vector<Input>& inputs,
+                                                                 Job job,
+                                                                 unsigned max_workers_count = 0)
+{
+    using Result = std::invoke_result_t<Job&, const Input&>;
+
+    if (max_workers_count == 0)
+        max_workers_count = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mutex mutex;
+    std::size_t next_index{0};
+    std::size_t found_index{inputs.size()};
+    Result found_result{};
+    std::size_t failed_index{inputs.size()};
+    std::exception_ptr failed_exception;
+
+    auto work{[&]() {
+        while (true)
+        {
+            std::size_t index;
+            {
+                std::lock_guard lock{mutex};
+                if (next_index >= found_index)
+                    return;
+                index = next_index++;
+            }
+
+            Result result{};
+            try
+            {
+                result = job(inputs[index]);
+            } catch (...)
+            {
+                std::lock_guard lock{mutex};
+                if (index < failed_index)
+                {
+                    failed_index = index;
+                    failed_exception = std::current_exception();
+                }
+                continue;
+            }
+
+            if (not result)
+                continue;
+
+            std::lock_guard lock{mutex};
+            if (index < found_index)
+            {
+                found_index = index;
+                found_result = std::move(result);
+            }
+        }
+    }};
+
+    {
+        auto workers_count{std::min(static_cast<std::size_t>(max_workers_count), inputs.size())};
+        std::vector<std::jthread> workers;
+        for (std::size_t i{1}; i < workers_count; ++i)
+            workers.emplace_back(work);
+        work();
+    }
+
+    if (found_index == inputs.size() and failed_exception)
+        std::rethrow_exception(failed_exception);
+    return found_result;
+}
+
+//! Calls the job for each of the inputs, on at most max_workers_count threads, and returns the results in the order of
+//! the inputs. All the jobs are run, even if some of them throw; then the exception thrown for the input with the
+//! lowest index is rethrown. The result of the job shall be default constructible.
+template<typename Input, typename Job>
+std::vector<std::invoke_result_t<Job&, const Input&>>
+transform_in_parallel(const std::vector<Input>& inputs, Job job, unsigned max_workers_count = 0)
+{
+    using Result = std::invoke_result_t<Job&, const Input&>;
+    // The elements of std::vector<bool> can't be written from multiple threads at once.
+    static_assert(not std::is_same_v<Result, bool>);
+
+    if (max_workers_count == 0)
+        max_workers_count = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mutex mutex;
+    std::size_t next_index{0};
+    std::vector<Result> results(inputs.size());
+    std::vector<std::exception_ptr> exceptions(inputs.size());
+
+    auto work{[&]() {
+        while (true)
+        {
+            std::size_t index;
+            {
+                std::lock_guard lock{mutex};
+                if (next_index >= inputs.size())
+                    return;
+                index = next_index++;
+            }
+
+            // Each job writes to its own slot, so no lock is needed.
+            try
+            {
+                results[index] = job(inputs[index]);
+            } catch (...)
+            {
+                exceptions[index] = std::current_exception();
+            }
+        }
+    }};
+
+    {
+        auto workers_count{std::min(static_cast<std::size_t>(max_workers_count), inputs.size())};
+        std::vector<std::jthread> workers;
+        for (std::size_t i{1}; i < workers_count; ++i)
+            workers.emplace_back(work);
+        work();
+    }
+
+    for (auto& exception : exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
+    return results;
+}
+
+} // namespace Tsepepe
+
+#endif /* PARALLEL_SEARCH_HPP */
@@ -6,6 +6,7 @@
 #define SCOPE_REMOVER_HPP
 
 #include <string>
+#include <vector>
 
 #include <NamedType/named_type.hpp>
 
@@ -17,7 +18,10 @@ using FullyQualifiedName = fluent::NamedType<std::string, struct FullyQualifiedN
 
 /** @brief Replaces any scoped names starting with the fully qualified name, with a unscoped name.
  *
- *  If the cpp_code contains strings with names: "name + ::", they will be removed simply.
+ *  If the cpp_code contains strings with names: "name + ::", they will be removed simply. The name is matched
+ *  literally, on the token boundaries: it isn't matched within a longer identifier, nor when it is nested within
+ *  another scope, e.g. "Namespace::" isn't removed from "MyNamespace::foo()", nor from "Other::Namespace::foo()". The
+ *  global scope qualifier, preceding the name, is removed together with it.
  *
  *  Examples:
  *
@@ -32,23 +36,23 @@ using FullyQualifiedName = fluent::NamedType<std::string, struct FullyQualifiedN
 struct ScopeRemover
 {
     explicit ScopeRemover(FullyQualifiedName);
-    std::string remove_from(const std::string& cpp_code);
+    std::string remove_from(const std::string& cpp_code) const;
 
   private:
     std::string fully_qualified_name;
 };
 
-/** @brief Splits the fully qualified name into multiple scopes, and applies replacement for each of them.
+/** @brief Splits the fully qualified name into multiple scopes, and removes each of them.
  *
- *  Performs similar thing to the ScopeRemover, but applies replacement for each nested scope. Effectively, having a
- *  fully qualified name like: "Namespace::Scope1::Scope2", will run the ScopeRemover three times, for three
- *  different names:
+ *  Performs similar thing to the ScopeRemover, but removes each nested scope. Effectively, having a fully qualified
+ *  name like: "Namespace::Scope1::Scope2", will remove three different names:
  *
  *      - "Namespace::Scope1::Scope2::"
  *      - "Namespace::Scope1::"
  *      - "Namespace::"
  *
- *  in such order.
+ *  The code is traversed once: since each scope is a prefix of the longer ones, the longest scope, which matches on
+ *  the token boundary, is removed.
  *
  *  Example:
  *
@@ -61,22 +65,22 @@ struct ScopeRemover
 struct AllScopeRemover
 {
     explicit AllScopeRemover(FullyQualifiedName);
-    std::string remove_from(std::string cpp_code);
+    std::string remove_from(const std::string& cpp_code) const;
 
   private:
     /**
-     * @brief Creates all the nesting scopes for the fully qualified name.
+     * @brief Finds the sizes of all the nesting scopes of the fully qualified name, ending with "::".
      *
-     * For example, for a fully qualified name "SomeNamespace::SomeTopLevelClass::SomeNestedClass" will return a vector
-     * of values:
-     *              - SomeNamespace::SomeTopLevelClass::SomeNestedClass::
-     *              - SomeNamespace::SomeTopLevelClass::
+     * For example, for a fully qualified name "SomeNamespace::SomeTopLevelClass::SomeNestedClass::" will return
+     * the sizes of:
      *              - SomeNamespace::
+     *              - SomeNamespace::SomeTopLevelClass::
+     *              - SomeNamespace::SomeTopLevelClass::SomeNestedClass::
      */
-    static std::vector<std::string> make_nesting_scopes(const std::string& fully_qualified_name);
+    static std::vector<std::size_t> get_nesting_scope_sizes(const std::string& fully_qualified_name);
 
     std::string fully_qualified_name;
-    std::vector<std::string> nesting_scopes;
+    std::vector<std::size_t> nesting_scope_sizes;
 };
 
 } // namespace Tsepepe
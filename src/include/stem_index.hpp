@@ -0,0 +1,87 @@
+/**
+ * @file        stem_index.hpp
+ * @brief       Persistent index of the C++ files found within a project, by their stems.
+ */
+#ifndef STEM_INDEX_HPP
+#define STEM_INDEX_HPP
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_stamp.hpp"
+
+namespace Tsepepe
+{
+
+/** @brief Maps file stems to the paths of the C++ files, e.g. "foo" to "src/foo.cpp" and "include/foo.hpp".
+ *
+ * Contains the same files, as the ones walked by walk_codebase(). The files are grouped by the directories they are
+ * found in, and each directory is stamped, when read. A file is added to, removed from, or renamed within a directory,
+ * only when the modification time of the directory changes, so that only the changed directories need to be read
+ * again, to bring the index up to date.
+ */
+class StemIndex
+{
+  public:
+    explicit StemIndex(std::filesystem::path project_root);
+
+    //! Walks the entire project, with multiple threads.
+    static StemIndex build(const std::filesystem::path& project_root);
+
+    //! Returns std::nullopt, when there is no index stored under the project root, or it has been stored with an
+    //! incompatible version.
+    static std::optional<StemIndex> load(const std::filesystem::path& project_root);
+
+    //! Stores the index under the project root, in the '.tsepepe' directory.
+    void save() const;
+
+    static std::filesystem::path get_storage_path(const std::filesystem::path& project_root);
+
+    //! Reads again the directories, which have changed since they've been read, together with the new subdirectories,
+    //! and drops the removed ones.
+    void refresh();
+
+    //! Reads again the directories, which are known to have changed, e.g. from a FileWatcher, without checking the
+    //! other ones. The directories, which aren't indexed, are skipped, since they are read together with the parents.
+    void refresh(std::vector<std::filesystem::path> changed_directories);
+
+    //! Returns the paths of the C++ files with the stem, sorted.
+    std::vector<std::filesystem::path> find(const std::string& stem) const;
+
+    //! Tells whether the index has changed since it has been loaded or saved.
+    bool is_modified() const;
+
+  private:
+    struct IndexedDirectory
+    {
+        FileStamp stamp;
+        std::vector<std::string> file_names;
+    };
+
+    //! Reads the directory, and the subdirectories, for which the predicate returns true, and all the ones below them.
+    void index_directory(const std::filesystem::path&,
+                         const std::function<bool(const std::filesystem::path&)>& is_subdirectory_read);
+
+    void update_directory(const std::filesystem::path&, IndexedDirectory);
+
+    //! Removes the directory together with all the subdirectories.
+    void remove_directory(const std::filesystem::path&);
+
+    void add_to_lookup(const std::filesystem::path&, const std::vector<std::string>& file_names);
+    void remove_from_lookup(const std::filesystem::path&, const std::vector<std::string>& file_names);
+
+    std::filesystem::path project_root;
+    std::map<std::filesystem::path, IndexedDirectory> directories;
+    std::unordered_map<std::string, std::set<std::filesystem::path>> paths_by_stem;
+    mutable bool modified{false};
+};
+
+} // namespace Tsepepe
+
+#endif /* STEM_INDEX_HPP */
@@ -7,6 +7,7 @@
 
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Tsepepe::utils
@@ -31,6 +32,46 @@ inline std::string join(const std::vector<std::string>& string_vec, std::string
     return join(std::begin(string_vec), std::end(string_vec), std::move(delim));
 }
 
+/** @brief Strips the whitespaces from both ends, and replaces each run of multiple whitespaces with a single space.
+ *
+ * A single whitespace, e.g. a newline, between two words is kept as it is. The result is built in a single pass.
+ */
+inline std::string strip_and_collapse_whitespaces(std::string_view s)
+{
+    auto is_space{[](char c) {
+        return c == ' ' or (c >= '\t' and c <= '\r');
+    }};
+
+    std::size_t begin{0};
+    while (begin < s.size() and is_space(s[begin]))
+        ++begin;
+    auto end{s.size()};
+    while (end > begin and is_space(s[end - 1]))
+        --end;
+
+    std::string result;
+    result.reserve(end - begin);
+
+    // The stripped string ends with a non-whitespace, so each run of whitespaces is followed by a non-whitespace.
+    auto i{begin};
+    while (i < end)
+    {
+        auto word_begin{i};
+        while (i < end and not is_space(s[i]))
+            ++i;
+        result.append(s.substr(word_begin, i - word_begin));
+        if (i == end)
+            break;
+
+        auto spaces_begin{i};
+        while (is_space(s[i]))
+            ++i;
+        result.push_back(i - spaces_begin == 1 ? s[spaces_begin] : ' ');
+    }
+
+    return result;
+}
+
 } // namespace Tsepepe::utils
 
 #endif /* STRING_UTILS_HPP */
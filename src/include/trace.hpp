@@ -0,0 +1,60 @@
+/**
+ * @file        trace.hpp
+ * @brief       Records the duration of the processing phases, as Chrome trace events.
+ */
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Tsepepe
+{
+
+//! The environment variable with the path to the trace file. When it is not set, nothing is traced.
+inline constexpr const char* trace_environment_variable{"TSEPEPE_TRACE"};
+
+bool is_tracing_enabled() noexcept;
+
+//! Writes the events recorded so far to the trace file, so that the trace of a long running process, e.g. the daemon,
+//! can be looked at without stopping it. Otherwise, the trace is written when the program exits.
+void flush_trace();
+
+/** @brief Records the span of time between the construction and the destruction.
+ *
+ * When the tracing is enabled, the spans are collected from all the threads and written, as the Chrome trace event
+ * JSON, to the file pointed by TSEPEPE_TRACE, when the program exits, or the trace is flushed. Only the most recent
+ * spans are kept, so that a long running process doesn't run out of memory. The file can be loaded with Perfetto, or
+ * with chrome://tracing. When the tracing is disabled, only a single flag is checked.
+ */
+class TraceSpan
+{
+  public:
+    //! The name must outlive the program, e.g. be a string literal. The detail, e.g. the file path, is copied, but
+    //! only when the tracing is enabled.
+    explicit TraceSpan(const char* name, std::string_view detail = {});
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+  private:
+    const char* name;
+    std::string detail;
+    //! Negative, when the tracing is disabled.
+    std::int64_t begin_us;
+};
+
+//! Records the span around the call, e.g. auto matches{traced("ast_matchers::match", [&]() { return match(...); })}.
+template<typename Function>
+decltype(auto) traced(const char* name, Function&& function)
+{
+    TraceSpan span{name};
+    return std::forward<Function>(function)();
+}
+
+} // namespace Tsepepe
+
+#endif /* TRACE_HPP */
@@ -0,0 +1,47 @@
+/**
+ * @file        unix_socket.hpp
+ * @brief       Line oriented Unix domain socket.
+ */
+#ifndef UNIX_SOCKET_HPP
+#define UNIX_SOCKET_HPP
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace Tsepepe
+{
+
+//! Owns a Unix domain stream socket. Throws BaseError on failures.
+class UnixSocket
+{
+  public:
+    //! Removes a stale socket file, left behind under the path, if any.
+    static UnixSocket listen(const std::filesystem::path&);
+    static UnixSocket connect(const std::filesystem::path&);
+
+    UnixSocket(UnixSocket&&) noexcept;
+    UnixSocket& operator=(UnixSocket&&) noexcept;
+    UnixSocket(const UnixSocket&) = delete;
+    UnixSocket& operator=(const UnixSocket&) = delete;
+    ~UnixSocket();
+
+    //! Blocks until a connection arrives on a listening socket.
+    UnixSocket accept();
+
+    //! Returns std::nullopt, when the peer has closed the connection, before sending a full line.
+    std::optional<std::string> read_line();
+
+    //! Appends the newline to the line.
+    void write_line(const std::string&);
+
+  private:
+    explicit UnixSocket(int fd);
+
+    int fd;
+    std::string received;
+};
+
+} // namespace Tsepepe
+
+#endif /* UNIX_SOCKET_HPP */
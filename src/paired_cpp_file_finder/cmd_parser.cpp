@@ -3,9 +3,11 @@
  * @brief	Implements the command line parsing for the C++ paired file finder.
  */
 #include <algorithm>
+#include <charconv>
 #include <exception>
 #include <filesystem>
 #include <iostream>
+#include <optional>
 #include <string_view>
 
 #include "cmd_parser.hpp"
@@ -25,10 +27,17 @@ static bool is_help_requested(int argc, const char** argv);
 static void validate_path_exists(std::string_view name, const fs::path&);
 static void validate_path_in_directory(const fs::path& root, const fs::path& potentially_nested);
 static void validate_is_cpp_file(const fs::path& file);
+static unsigned parse_max_matches_count(std::string_view);
 
 //! Turns relative paths to absolute, and fixes all "..". For absolute paths fixes ".." only.
 static fs::path normalize(const fs::path&);
 
+// --------------------------------------------------------------------------------------------------------------------
+// Helper variables
+// --------------------------------------------------------------------------------------------------------------------
+static constexpr std::string_view max_count_flag{"--max-count"};
+static constexpr std::string_view index_flag{"--index"};
+
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
 // --------------------------------------------------------------------------------------------------------------------
@@ -43,7 +52,22 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
         return ReturnCode{0};
     }
 
-    if (argc != 3)
+    // The options precede the positional arguments.
+    int first_positional_argument_index{1};
+    std::optional<std::string_view> max_matches_count_argument;
+    bool is_stem_index_created{false};
+    for (; first_positional_argument_index < argc; ++first_positional_argument_index)
+    {
+        std::string_view argument{argv[first_positional_argument_index]};
+        if (argument == max_count_flag and first_positional_argument_index + 1 < argc)
+            max_matches_count_argument = argv[++first_positional_argument_index];
+        else if (argument == index_flag)
+            is_stem_index_created = true;
+        else
+            break;
+    }
+
+    if (argc - first_positional_argument_index != 2)
     {
         std::cerr << "ERROR: Invalid number of arguments!\n" << std::endl;
         print_usage(argc, argv);
@@ -52,6 +76,10 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
 
     try
     {
+        unsigned max_matches_count{
+            max_matches_count_argument ? parse_max_matches_count(*max_matches_count_argument) : 0};
+        argv += first_positional_argument_index - 1;
+
         validate_path_exists("Project root directory", argv[1]);
         auto project_root{normalize(argv[1])};
         fs::path cpp_file_path{argv[2]};
@@ -66,7 +94,10 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
             validate_path_exists("C++ file", cpp_file_path);
         }
         validate_is_cpp_file(cpp_file_path);
-        return Input{.project_directory = project_root, .cpp_file = cpp_file_path};
+        return Input{.project_directory = project_root,
+                     .cpp_file = cpp_file_path,
+                     .max_matches_count = max_matches_count,
+                     .is_stem_index_created = is_stem_index_created};
     } catch (const Error& e)
     {
         std::cerr << e.what() << std::endl;
@@ -82,7 +113,7 @@ std::variant<Input, ReturnCode> parse_cmd(int argc, const char** argv)
 static void print_usage(int argc, const char** argv)
 {
     auto program_path{argv[0]};
-    std::cout << "USAGE:\n\t" << program_path << " PROJECT_ROOT_DIR CPP_FILE\n\n";
+    std::cout << "USAGE:\n\t" << program_path << " [--max-count NUM] [--index] PROJECT_ROOT_DIR CPP_FILE\n\n";
     std::cout
         << "DESCRIPTION:\n\tTries to find a corresponding (paired) C++ file for CPP_FILE, under PROJECT_ROOT_DIR.\n\t"
            "Paired C++ files are files with the same stem, e.g.: some_file.cpp/some_file.hpp.\n\n\t"
@@ -90,7 +121,13 @@ static void print_usage(int argc, const char** argv)
            "Otherwise, if the input file is a source file, then a header file is tried to be found.\n\n\t"
            "Firstly, tries to find the paired file in the same directory the input file is located. "
            "Then, traverses the directories recursively under PROJECT_ROOT_DIR. "
-           "If finds multiple matches, then outputs them, each in a separate line.\n\n"
+           "If finds multiple matches, then outputs them, each in a separate line.\n\n\t"
+           "The directories are traversed with multiple threads, skipping the hidden files and directories, "
+           "and the ones ignored by .gitignore, the way ripgrep does. "
+           "With --max-count, the traversal stops, once NUM paired files are found.\n\n\t"
+           "When the stem index is stored under PROJECT_ROOT_DIR/.tsepepe/stem_index, the paired files are looked up "
+           "within it, instead of traversing the directories. Only the directories, which have changed since, "
+           "are read again. With --index, the index is built, when there is none yet.\n\n"
         << std::endl;
     std::cout << "NOTE:\n\tCPP_FILE must be in located in the child directory of the PROJECT_ROOT_DIR.\n" << std::endl;
     std::cout << "EXAMPLE:\n\t1. </root/dir/to/project>\n"
@@ -176,3 +213,15 @@ static void validate_is_cpp_file(const fs::path& file)
         throw Error{std::move(msg)};
     }
 }
+
+static unsigned parse_max_matches_count(std::string_view count)
+{
+    unsigned result{0};
+    auto [end, ec] = std::from_chars(count.data(), count.data() + count.size(), result);
+    if (ec != std::errc{} or end != count.data() + count.size() or result == 0)
+    {
+        auto msg{(std::ostringstream{} << "ERROR: Invalid maximum number of matches: " << count << "!").str()};
+        throw Error{std::move(msg)};
+    }
+    return result;
+}
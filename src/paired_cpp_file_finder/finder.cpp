@@ -4,25 +4,50 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 
 #include "finder.hpp"
 
+#include "codebase_grepper.hpp"
+#include "stem_index.hpp"
+
 namespace fs = std::filesystem;
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper declaration
 // --------------------------------------------------------------------------------------------------------------------
-static std::vector<fs::path> get_potential_paired_file_names(const fs::path&);
+namespace
+{
 
-template<typename Range>
-std::vector<fs::path> to_paths(Range& range)
+//! Allows to look up the file names with std::string_view, without making a std::string out of it.
+struct FileNameHash
 {
-    std::vector<fs::path> result;
-    result.reserve(8);
-    std::ranges::copy(range, std::back_inserter(result));
-    return result;
-}
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view file_name) const
+    {
+        return std::hash<std::string_view>{}(file_name);
+    }
+};
+
+using FileNames = std::unordered_set<std::string, FileNameHash, std::equal_to<>>;
+
+} // namespace
+
+static FileNames get_potential_paired_file_names(const fs::path&);
+
+//! Doesn't make a new path, as fs::path::filename() does.
+static std::string_view get_file_name(const fs::path&);
+
+//! Returns the stored index, refreshed, or a new one, when there is none, and it's requested to be created.
+static std::optional<Tsepepe::StemIndex> load_stem_index(const Tsepepe::PairedCppFileFinder::Input&);
+static void save_stem_index(const Tsepepe::StemIndex&);
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper variables
@@ -35,28 +60,57 @@ static const std::vector<std::string> header_file_extensions{".hpp", ".hxx", ".h
 // --------------------------------------------------------------------------------------------------------------------
 std::vector<std::filesystem::path> Tsepepe::PairedCppFileFinder::find(const Input& input)
 {
-    const auto& [project_root, cpp_file_path] = input;
+    const auto& [project_root, cpp_file_path, max_matches_count, _] = input;
 
     auto paired_file_names{get_potential_paired_file_names(cpp_file_path)};
-    auto is_paired_cpp_file{[&](const fs::path& path) {
-        return std::ranges::find(paired_file_names, path.filename()) != std::end(paired_file_names);
+    auto is_paired_cpp_file{
+        [&](const fs::path& path) { return paired_file_names.contains(get_file_name(path)); }};
+    auto is_limit_reached{[&](const std::vector<fs::path>& matches) {
+        return max_matches_count != 0 and matches.size() >= max_matches_count;
     }};
 
-    auto cpp_file_dir{cpp_file_path.parent_path()};
-    auto same_dir_matches_view{fs::directory_iterator{cpp_file_dir} | std::views::filter(is_paired_cpp_file)};
-    auto same_dir_matches{to_paths(same_dir_matches_view)};
-    if (not same_dir_matches.empty())
-        return same_dir_matches;
+    std::vector<fs::path> result;
+    for (const auto& entry : fs::directory_iterator{cpp_file_path.parent_path()})
+        if (not is_limit_reached(result) and is_paired_cpp_file(entry.path()))
+            result.push_back(entry.path());
+    if (not result.empty())
+    {
+        std::ranges::sort(result);
+        return result;
+    }
+
+    // The index keeps the same files, as the ones walked, so the lookup replaces the walk.
+    if (auto stem_index{load_stem_index(input)})
+    {
+        for (const auto& path : stem_index->find(cpp_file_path.stem().string()))
+            if (not is_limit_reached(result) and is_paired_cpp_file(path))
+                result.push_back(path);
+        save_stem_index(*stem_index);
+        return result;
+    }
+
+    // Only the paired file names are compared, within the visitor, so the walk is dominated by reading the
+    // directories, which is spread over multiple threads.
+    std::mutex result_mutex;
+    walk_codebase(RootDirectory{project_root}, [&](const fs::path& path) {
+        if (not is_paired_cpp_file(path))
+            return true;
 
-    auto project_matches_view{fs::recursive_directory_iterator{project_root} | std::views::filter(is_paired_cpp_file)};
-    auto project_matches{to_paths(project_matches_view)};
-    return project_matches;
+        std::lock_guard lock{result_mutex};
+        if (not is_limit_reached(result))
+            result.push_back(path);
+        return not is_limit_reached(result);
+    });
+
+    // The order, in which the threads find the matches, is not deterministic.
+    std::ranges::sort(result);
+    return result;
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper definition
 // --------------------------------------------------------------------------------------------------------------------
-static std::vector<fs::path> get_potential_paired_file_names(const fs::path& cpp_file_path)
+static FileNames get_potential_paired_file_names(const fs::path& cpp_file_path)
 {
     auto is_source_file{[](const fs::path& cpp_file_path) {
         return std::find(
@@ -64,14 +118,42 @@ static std::vector<fs::path> get_potential_paired_file_names(const fs::path& cpp
                != std::end(source_file_extensions);
     }};
 
-    auto stem{cpp_file_path.stem()};
+    auto stem{cpp_file_path.stem().string()};
     const auto& extensions{is_source_file(cpp_file_path) ? header_file_extensions : source_file_extensions};
 
-    std::vector<fs::path> result;
-    result.reserve(extensions.size());
+    FileNames result;
+    for (const auto& extension : extensions)
+        result.insert(stem + extension);
+    return result;
+}
 
-    std::ranges::transform(
-        extensions, std::back_inserter(result), [&stem](const auto& ext) { return fs::path(stem).concat(ext); });
+static std::string_view get_file_name(const fs::path& path)
+{
+    std::string_view native{path.native()};
+    auto separator_position{native.rfind(fs::path::preferred_separator)};
+    return separator_position == std::string_view::npos ? native : native.substr(separator_position + 1);
+}
 
-    return result;
+static std::optional<Tsepepe::StemIndex> load_stem_index(const Tsepepe::PairedCppFileFinder::Input& input)
+{
+    auto stem_index{Tsepepe::StemIndex::load(input.project_directory)};
+    if (stem_index)
+        stem_index->refresh();
+    else if (input.is_stem_index_created)
+        stem_index = Tsepepe::StemIndex::build(input.project_directory);
+    return stem_index;
+}
+
+static void save_stem_index(const Tsepepe::StemIndex& stem_index)
+{
+    if (not stem_index.is_modified())
+        return;
+
+    // The changed directories are simply read again on the next lookup.
+    try
+    {
+        stem_index.save();
+    } catch (const std::exception&)
+    {
+    }
 }
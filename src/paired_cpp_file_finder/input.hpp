@@ -14,6 +14,10 @@ struct Input
 {
     std::filesystem::path project_directory;
     std::filesystem::path cpp_file;
+    //! The search stops, once that many paired files are found. Zero means no limit.
+    unsigned max_matches_count{0};
+    //! The stem index is used, when it is stored under the project directory. When it's not, it's built, if true.
+    bool is_stem_index_created{false};
 };
 
 }; // namespace Tsepepe::PairedCppFileFinder
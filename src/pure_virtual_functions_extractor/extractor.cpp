@@ -12,6 +12,9 @@
 #include "extractor.hpp"
 
 #include "clang_ast_utils.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "libclang_utils/misc_utils.hpp"
+#include "trace.hpp"
 
 using namespace clang;
 using namespace clang::tooling;
@@ -58,8 +61,8 @@ class MatchCollector : public ast::MatchFinder::MatchCallback
 
     void append_override_declaration(const CXXMethodDecl* method, const SourceManager& source_manager)
     {
-        auto declaration{Tsepepe::utils::clang_ast::source_range_content_to_string(
-            method->getSourceRange(), source_manager, lang_options)};
+        auto declaration{
+            Tsepepe::source_range_content_to_string(method->getSourceRange(), source_manager, lang_options)};
 
         std::regex overrider{"virtual\\s+(.*)(\\s+=\\s+0)"};
         auto override_declaration{std::regex_replace(declaration, overrider, "$1 override;")};
@@ -82,11 +85,15 @@ std::vector<std::string> Tsepepe::PureVirtualFunctionsExtractor::extract(const I
     finder.addMatcher(abstract_class_matcher, &collector);
 
     ClangTool tool{*input.compilation_database_ptr, {input.header_file}};
+    tool.appendArgumentsAdjuster(Tsepepe::get_fast_parsing_arguments_adjuster());
 
     IgnoringDiagConsumer diagnostic_consumer;
     tool.setDiagnosticConsumer(&diagnostic_consumer);
 
-    tool.run(newFrontendActionFactory(&finder).get());
+    {
+        TraceSpan span{"ClangTool::run", input.header_file.string()};
+        tool.run(newFrontendActionFactory(&finder).get());
+    }
 
     return collector.get_result();
 }
@@ -0,0 +1,399 @@
+/**
+ * @file	ast_unit_cache.cpp
+ * @brief	Implements the AstUnitCache.
+ */
+
+#include "ast_unit_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string_view>
+
+#include <clang/AST/ASTContext.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/PrecompiledPreamble.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "base_error.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+#include "trace.hpp"
+
+using namespace clang;
+using namespace clang::tooling;
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static std::unique_ptr<ASTUnit> build_ast_unit(const CompilationDatabase&, const fs::path&, bool skip_function_bodies);
+
+//! The compile command is a part of the key, since the same file may be compiled differently within the projects.
+//! The unsaved content is represented by its hash only, so it shall be compared on a hit.
+static std::string make_key(const CompilationDatabase&,
+                            const std::string& path,
+                            bool skip_function_bodies,
+                            const std::vector<Tsepepe::UnsavedFile>& unsaved_files = {});
+
+//! Reparses the AST of the file with the new content, reusing the precompiled preamble. Returns false on failure.
+static bool reparse(ASTUnit&, const std::string& path, std::string_view content);
+
+static std::size_t compute_preamble_hash(const LangOptions&, std::string_view content);
+
+//! In nanoseconds since the epoch, as the file modification times.
+static std::int64_t get_current_time();
+
+//! The memory allocated by the AST context, and the source manager, with the file contents.
+static std::size_t get_allocated_memory(const ASTUnit&);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::AstUnitCache::AstUnitCache(std::size_t memory_budget_) : memory_budget{memory_budget_}
+{
+}
+
+std::shared_ptr<ASTUnit> Tsepepe::AstUnitCache::get(const CompilationDatabase& compilation_database,
+                                                     const fs::path& path,
+                                                     bool skip_function_bodies)
+{
+    auto normalized_path{fs::absolute(path).lexically_normal().string()};
+    return get(make_key(compilation_database, normalized_path, skip_function_bodies),
+               [&]() { return build_ast_unit(compilation_database, normalized_path, skip_function_bodies); });
+}
+
+std::shared_ptr<ASTUnit> Tsepepe::AstUnitCache::get(const CompilationDatabase& compilation_database,
+                                                     const fs::path& path,
+                                                     const std::vector<UnsavedFile>& unsaved_files,
+                                                     bool skip_function_bodies)
+{
+    auto normalized_path{fs::absolute(path).lexically_normal().string()};
+    auto key{make_key(compilation_database, normalized_path, skip_function_bodies, unsaved_files)};
+
+    auto is_reparsable{unsaved_files.size() == 1
+                       and fs::absolute(unsaved_files.front().path).lexically_normal() == normalized_path};
+    if (not is_reparsable)
+        return get(
+            key,
+            [&]() {
+                return build_ast_with_unsaved_files(compilation_database,
+                                                    normalized_path,
+                                                    unsaved_files,
+                                                    {.skip_function_bodies = skip_function_bodies});
+            },
+            unsaved_files);
+
+    auto reparse_key{make_key(compilation_database, normalized_path, skip_function_bodies)};
+    auto content{unsaved_files.front().content};
+    return get(
+        key,
+        [&]() -> std::shared_ptr<ASTUnit> {
+            if (auto ast_unit{take_reparsable_ast_unit(reparse_key, content)};
+                ast_unit != nullptr and reparse(*ast_unit, normalized_path, content))
+                return ast_unit;
+            return build_ast_with_unsaved_files(compilation_database,
+                                                normalized_path,
+                                                unsaved_files,
+                                                {.precompile_preamble = true,
+                                                 .skip_function_bodies = skip_function_bodies});
+        },
+        unsaved_files,
+        reparse_key);
+}
+
+void Tsepepe::AstUnitCache::evict(const std::vector<fs::path>& changed_paths)
+{
+    std::lock_guard lock{mutex};
+    for (const auto& path : changed_paths)
+    {
+        for (const auto& key :
+             include_graph.get_dependent_translation_units(fs::absolute(path).lexically_normal().string()))
+        {
+            erase(key);
+            ++statistics.invalidations;
+        }
+    }
+}
+
+void Tsepepe::AstUnitCache::clear()
+{
+    std::lock_guard lock{mutex};
+    entries.clear();
+    recently_used_keys.clear();
+    include_graph.clear();
+    reparsable_keys.clear();
+    statistics.memory_usage = 0;
+}
+
+void Tsepepe::AstUnitCache::set_watched_file_predicate(WatchedFilePredicate predicate)
+{
+    std::lock_guard lock{mutex};
+    is_watched = std::move(predicate);
+}
+
+Tsepepe::AstUnitCacheStatistics Tsepepe::AstUnitCache::get_statistics() const
+{
+    std::lock_guard lock{mutex};
+    return statistics;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+template<typename AstUnitBuilder>
+std::shared_ptr<ASTUnit> Tsepepe::AstUnitCache::get(const std::string& key,
+                                                     const AstUnitBuilder& build,
+                                                     const std::vector<UnsavedFile>& unsaved_files,
+                                                     const std::string& reparse_key)
+{
+    {
+        std::lock_guard lock{mutex};
+        if (auto it{entries.find(key)}; it != std::end(entries) and is_built_from(it->second, unsaved_files))
+        {
+            if (it->second.is_fully_watched or is_up_to_date(it->second))
+            {
+                ++statistics.hits;
+                recently_used_keys.splice(std::begin(recently_used_keys), recently_used_keys, it->second.recent_use);
+                return it->second.ast_unit;
+            }
+            erase(key);
+            ++statistics.invalidations;
+        }
+        ++statistics.misses;
+    }
+
+    // The AST is built without holding the lock, so that multiple files may be parsed at once.
+    auto build_start_time{get_current_time()};
+    std::shared_ptr<ASTUnit> ast_unit{build()};
+    auto dependencies{collect_dependencies(*ast_unit, unsaved_files, build_start_time)};
+    auto memory_usage{get_allocated_memory(*ast_unit)};
+    std::size_t preamble_hash{0};
+    if (not reparse_key.empty())
+        preamble_hash = compute_preamble_hash(ast_unit->getLangOpts(), unsaved_files.front().content);
+
+    std::vector<std::string> unsaved_contents;
+    unsaved_contents.reserve(unsaved_files.size());
+    for (const auto& unsaved_file : unsaved_files)
+        unsaved_contents.emplace_back(unsaved_file.content);
+
+    std::lock_guard lock{mutex};
+    auto is_fully_watched{is_watched and std::ranges::all_of(dependencies, [this](const Dependency& dependency) {
+                              return is_watched(dependency.path);
+                          })};
+    insert(key,
+           Entry{.ast_unit = ast_unit,
+                 .dependencies = std::move(dependencies),
+                 .is_fully_watched = is_fully_watched,
+                 .unsaved_contents = std::move(unsaved_contents),
+                 .memory_usage = memory_usage,
+                 .reparse_key = reparse_key,
+                 .preamble_hash = preamble_hash});
+    return ast_unit;
+}
+
+std::shared_ptr<ASTUnit> Tsepepe::AstUnitCache::take_reparsable_ast_unit(const std::string& reparse_key,
+                                                                          std::string_view content)
+{
+    std::lock_guard lock{mutex};
+    auto key_it{reparsable_keys.find(reparse_key)};
+    if (key_it == std::end(reparsable_keys))
+        return nullptr;
+
+    auto key{key_it->second};
+    auto& entry{entries.at(key)};
+    // Reparsing changes the AST in place, so the one still used by someone else is left intact.
+    if (entry.ast_unit.use_count() > 1
+        or compute_preamble_hash(entry.ast_unit->getLangOpts(), content) != entry.preamble_hash)
+        return nullptr;
+
+    auto result{entry.ast_unit};
+    erase(key);
+    return result;
+}
+
+void Tsepepe::AstUnitCache::insert(const std::string& key, Entry entry)
+{
+    // The same AST might have been built by another thread in the meantime.
+    erase(key);
+
+    std::vector<std::string> included_files;
+    included_files.reserve(entry.dependencies.size());
+    for (const auto& dependency : entry.dependencies)
+        included_files.push_back(dependency.path);
+    include_graph.set_included_files(key, included_files);
+
+    if (not entry.reparse_key.empty())
+        reparsable_keys.insert_or_assign(entry.reparse_key, key);
+
+    recently_used_keys.push_front(key);
+    entry.recent_use = std::begin(recently_used_keys);
+    statistics.memory_usage += entry.memory_usage;
+    entries.insert_or_assign(key, std::move(entry));
+
+    // The AST just built is kept, even when it alone exceeds the budget.
+    while (statistics.memory_usage > memory_budget and recently_used_keys.size() > 1)
+    {
+        auto least_recently_used_key{recently_used_keys.back()};
+        erase(least_recently_used_key);
+        ++statistics.evictions;
+    }
+}
+
+void Tsepepe::AstUnitCache::erase(const std::string& key)
+{
+    auto it{entries.find(key)};
+    if (it == std::end(entries))
+        return;
+
+    statistics.memory_usage -= it->second.memory_usage;
+    include_graph.remove_translation_unit(key);
+    if (auto reparsable_it{reparsable_keys.find(it->second.reparse_key)};
+        reparsable_it != std::end(reparsable_keys) and reparsable_it->second == key)
+        reparsable_keys.erase(reparsable_it);
+    recently_used_keys.erase(it->second.recent_use);
+    entries.erase(it);
+}
+
+bool Tsepepe::AstUnitCache::is_built_from(const Entry& entry, const std::vector<UnsavedFile>& unsaved_files)
+{
+    return std::ranges::equal(entry.unsaved_contents,
+                              unsaved_files,
+                              std::equal_to{},
+                              [](const std::string& content) { return std::string_view{content}; },
+                              &UnsavedFile::content);
+}
+
+bool Tsepepe::AstUnitCache::is_up_to_date(const Entry& entry)
+{
+    return std::ranges::all_of(entry.dependencies, [](const Dependency& dependency) {
+        return dependency.stamp and get_file_stamp(dependency.path) == dependency.stamp;
+    });
+}
+
+std::vector<Tsepepe::AstUnitCache::Dependency> Tsepepe::AstUnitCache::collect_dependencies(
+    const ASTUnit& ast_unit, const std::vector<UnsavedFile>& unsaved_files, std::int64_t build_start_time)
+{
+    // The file modification times come from a coarse clock, which may lag behind the current time by a tick.
+    static constexpr std::int64_t clock_tick{std::chrono::nanoseconds{std::chrono::milliseconds{50}}.count()};
+
+    auto is_unsaved{[&](const std::string& path) {
+        auto normalized_path{fs::absolute(path).lexically_normal()};
+        return std::ranges::any_of(unsaved_files, [&](const UnsavedFile& unsaved_file) {
+            return fs::absolute(unsaved_file.path).lexically_normal() == normalized_path;
+        });
+    }};
+
+    const auto& source_manager{ast_unit.getSourceManager()};
+
+    std::vector<Dependency> result;
+    for (auto it{source_manager.fileinfo_begin()}; it != source_manager.fileinfo_end(); ++it)
+    {
+        const FileEntry* file_entry{it->first};
+        if (file_entry == nullptr)
+            continue;
+        auto path{file_entry->tryGetRealPathName()};
+        if (path.empty())
+            path = file_entry->getName();
+        if (not unsaved_files.empty() and is_unsaved(path.str()))
+            continue;
+
+        // The files are stamped after the parse, so a file modified since the parse has started might have been read
+        // before, or after the modification.
+        auto stamp{get_file_stamp(path.str())};
+        if (stamp
+            and (stamp->modification_time >= build_start_time - clock_tick
+                 or stamp->size != static_cast<std::uint64_t>(file_entry->getSize())))
+            stamp.reset();
+        result.emplace_back(Dependency{.path = path.str(), .stamp = stamp});
+    }
+    return result;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static std::unique_ptr<ASTUnit>
+build_ast_unit(const CompilationDatabase& compilation_database, const fs::path& path, bool skip_function_bodies)
+{
+    std::vector<std::unique_ptr<ASTUnit>> ast_units;
+    ClangTool tool{compilation_database,
+                   {path.string()},
+                   std::make_shared<PCHContainerOperations>(),
+                   Tsepepe::make_parsing_file_system()};
+    tool.appendArgumentsAdjuster(Tsepepe::get_fast_parsing_arguments_adjuster(skip_function_bodies));
+    {
+        Tsepepe::TraceSpan span{"ClangTool::buildASTs", path.string()};
+        tool.buildASTs(ast_units);
+    }
+
+    if (ast_units.empty())
+        throw Tsepepe::BaseError{"Failed to parse file: " + path.string()};
+    return std::move(ast_units.back());
+}
+
+static std::string make_key(const CompilationDatabase& compilation_database,
+                            const std::string& path,
+                            bool skip_function_bodies,
+                            const std::vector<Tsepepe::UnsavedFile>& unsaved_files)
+{
+    // The parts are separated with the null characters, which appear neither in the paths, nor in the command lines.
+    std::string result{path};
+    for (const auto& command : compilation_database.getCompileCommands(path))
+    {
+        result += '\0';
+        result += command.Directory;
+        for (const auto& argument : command.CommandLine)
+        {
+            result += '\0';
+            result += argument;
+        }
+    }
+
+    if (not skip_function_bodies)
+    {
+        result += '\0';
+        result += "with function bodies";
+    }
+
+    for (const auto& unsaved_file : unsaved_files)
+    {
+        result += '\0';
+        result += unsaved_file.path.string();
+        result += '\0';
+        result += std::to_string(std::hash<std::string_view>{}(unsaved_file.content));
+    }
+    return result;
+}
+
+static bool reparse(ASTUnit& ast_unit, const std::string& path, std::string_view content)
+{
+    // The AST takes the ownership of the buffer.
+    ASTUnit::RemappedFile remapped_file{path, llvm::MemoryBuffer::getMemBufferCopy(content, path).release()};
+    auto has_failed{traced("ASTUnit::Reparse", [&]() {
+        return ast_unit.Reparse(std::make_shared<PCHContainerOperations>(), remapped_file);
+    })};
+    return not has_failed;
+}
+
+static std::size_t compute_preamble_hash(const LangOptions& lang_options, std::string_view content)
+{
+    auto buffer{llvm::MemoryBuffer::getMemBuffer(content, "", /* RequiresNullTerminator= */ false)};
+    auto bounds{ComputePreambleBounds(lang_options, buffer->getMemBufferRef(), /* MaxLines= */ 0)};
+    return std::hash<std::string_view>{}(content.substr(0, bounds.Size));
+}
+
+static std::int64_t get_current_time()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static std::size_t get_allocated_memory(const ASTUnit& ast_unit)
+{
+    const auto& ast_context{ast_unit.getASTContext()};
+    const auto& source_manager{ast_unit.getSourceManager()};
+    return ast_context.getASTAllocatedMemory() + ast_context.getSideTableAllocatedMemory()
+           + source_manager.getContentCacheSize() + source_manager.getDataStructureSizes();
+}
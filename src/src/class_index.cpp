@@ -0,0 +1,231 @@
+/**
+ * @file	class_index.cpp
+ * @brief	Implements the ClassIndex.
+ */
+
+#include "class_index.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#include "base_error.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+//! Increment, whenever the storage format changes, so that the indexes stored with the older versions are rebuilt.
+static constexpr unsigned storage_format_version{2};
+static constexpr const char* storage_format_header{"tsepepe-class-index"};
+
+static fs::path normalize(const fs::path&);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::ClassIndex::ClassIndex(fs::path root) : project_root{normalize(root)}
+{
+}
+
+std::optional<Tsepepe::ClassIndex> Tsepepe::ClassIndex::load(const fs::path& project_root)
+{
+    std::ifstream ifs{get_storage_path(project_root)};
+    if (not ifs)
+        return std::nullopt;
+
+    std::string header;
+    unsigned version{0};
+    ifs >> header >> version;
+    if (header != storage_format_header or version != storage_format_version)
+        return std::nullopt;
+
+    ClassIndex result{project_root};
+    IndexedFile* current_file{nullptr};
+    fs::path current_path;
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::istringstream iss{line};
+        char kind;
+        iss >> kind;
+        if (kind == 'F')
+        {
+            FileStamp stamp;
+            iss >> stamp.modification_time >> stamp.size;
+            iss.ignore(1);
+
+            std::string relative_path;
+            std::getline(iss, relative_path);
+            if (not iss and not iss.eof())
+                return std::nullopt;
+
+            current_path = normalize(result.project_root / relative_path);
+            current_file = &result.files[current_path];
+            current_file->stamp = stamp;
+        } else if (kind == 'C' and current_file != nullptr)
+        {
+            ClassIndexEntry entry;
+            entry.path = current_path;
+            iss >> entry.offset >> entry.is_abstract >> entry.has_bases >> entry.name;
+            iss.ignore(1);
+            std::getline(iss, entry.fully_qualified_name);
+            if (not iss and not iss.eof())
+                return std::nullopt;
+
+            current_file->entries.emplace_back(std::move(entry));
+        } else
+        {
+            return std::nullopt;
+        }
+    }
+
+    for (const auto& [path, indexed_file] : result.files)
+        result.add_to_lookup(path, indexed_file.entries);
+    return result;
+}
+
+void Tsepepe::ClassIndex::save() const
+{
+    auto storage_path{get_storage_path(project_root)};
+    fs::create_directories(storage_path.parent_path());
+
+    // Written to a temporary file first, so that a reader never observes a partially written index.
+    auto temporary_path{storage_path};
+    temporary_path += ".tmp";
+    {
+        std::ofstream ofs{temporary_path};
+        if (not ofs)
+            throw BaseError{"Failed to store the class index under: " + temporary_path.string()};
+
+        ofs << storage_format_header << ' ' << storage_format_version << '\n';
+        for (const auto& [path, indexed_file] : files)
+        {
+            ofs << "F " << indexed_file.stamp.modification_time << ' ' << indexed_file.stamp.size << ' '
+                << path.lexically_relative(project_root).string() << '\n';
+            for (const auto& entry : indexed_file.entries)
+                ofs << "C " << entry.offset << ' ' << entry.is_abstract << ' ' << entry.has_bases << ' ' << entry.name
+                    << ' ' << entry.fully_qualified_name << '\n';
+        }
+    }
+    fs::rename(temporary_path, storage_path);
+    modified = false;
+}
+
+fs::path Tsepepe::ClassIndex::get_storage_path(const fs::path& project_root)
+{
+    return normalize(project_root) / ".tsepepe" / "class_index";
+}
+
+const fs::path& Tsepepe::ClassIndex::get_project_root() const
+{
+    return project_root;
+}
+
+std::vector<Tsepepe::ClassIndexEntry> Tsepepe::ClassIndex::find(const std::string& class_name) const
+{
+    std::vector<ClassIndexEntry> result;
+
+    auto it{files_by_class_name.find(class_name)};
+    if (it == std::end(files_by_class_name))
+        return result;
+
+    for (const auto& path : it->second)
+        for (const auto& entry : files.at(path).entries)
+            if (entry.name == class_name)
+                result.push_back(entry);
+    return result;
+}
+
+void Tsepepe::ClassIndex::update_file(const fs::path& path, FileStamp stamp, std::vector<ClassIndexEntry> entries)
+{
+    auto key{normalize(path)};
+    remove_file(key);
+
+    for (auto& entry : entries)
+        entry.path = key;
+    add_to_lookup(key, entries);
+    files.emplace(key, IndexedFile{.stamp = stamp, .entries = std::move(entries)});
+    modified = true;
+}
+
+void Tsepepe::ClassIndex::remove_file(const fs::path& path)
+{
+    auto it{files.find(normalize(path))};
+    if (it == std::end(files))
+        return;
+
+    remove_from_lookup(it->first, it->second.entries);
+    files.erase(it);
+    modified = true;
+}
+
+bool Tsepepe::ClassIndex::is_up_to_date(const fs::path& path) const
+{
+    auto it{files.find(normalize(path))};
+    if (it == std::end(files))
+        return false;
+    return get_file_stamp(it->first) == it->second.stamp;
+}
+
+std::vector<fs::path> Tsepepe::ClassIndex::get_indexed_files() const
+{
+    std::vector<fs::path> result;
+    result.reserve(files.size());
+    for (const auto& [path, _] : files)
+        result.push_back(path);
+    return result;
+}
+
+void Tsepepe::ClassIndex::merge(const ClassIndex& other)
+{
+    for (const auto& [path, other_file] : other.files)
+    {
+        auto it{files.find(path)};
+        if (it != std::end(files)
+            and (it->second.stamp == other_file.stamp or is_up_to_date(path) or not other.is_up_to_date(path)))
+            continue;
+
+        update_file(path, other_file.stamp, other_file.entries);
+    }
+}
+
+bool Tsepepe::ClassIndex::is_modified() const
+{
+    return modified;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+void Tsepepe::ClassIndex::add_to_lookup(const fs::path& path, const std::vector<ClassIndexEntry>& entries)
+{
+    for (const auto& entry : entries)
+        files_by_class_name[entry.name].insert(path);
+}
+
+void Tsepepe::ClassIndex::remove_from_lookup(const fs::path& path, const std::vector<ClassIndexEntry>& entries)
+{
+    for (const auto& entry : entries)
+    {
+        auto it{files_by_class_name.find(entry.name)};
+        if (it == std::end(files_by_class_name))
+            continue;
+
+        it->second.erase(path);
+        if (it->second.empty())
+            files_by_class_name.erase(it);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static fs::path normalize(const fs::path& path)
+{
+    return fs::absolute(path).lexically_normal();
+}
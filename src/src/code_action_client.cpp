@@ -0,0 +1,40 @@
+/**
+ * @file	code_action_client.cpp
+ * @brief	Implements delegation of the code actions to the daemon.
+ */
+
+#include "code_action_client.hpp"
+
+#include <cstdlib>
+
+#include "base_error.hpp"
+#include "unix_socket.hpp"
+
+namespace fs = std::filesystem;
+
+Tsepepe::CodeActionResponse Tsepepe::send_code_action_request(const fs::path& socket_path,
+                                                              const CodeActionRequest& request)
+{
+    auto socket{UnixSocket::connect(socket_path)};
+    socket.write_line(serialize(request));
+
+    auto response{socket.read_line()};
+    if (not response)
+        throw BaseError{"The daemon has closed the connection without a response!"};
+    return deserialize_code_action_response(*response);
+}
+
+std::optional<Tsepepe::CodeActionResponse> Tsepepe::try_delegating_to_daemon(const CodeActionRequest& request)
+{
+    auto socket_path{std::getenv(daemon_socket_environment_variable)};
+    if (socket_path == nullptr or *socket_path == '\0')
+        return std::nullopt;
+
+    try
+    {
+        return send_code_action_request(socket_path, request);
+    } catch (const BaseError&)
+    {
+        return std::nullopt;
+    }
+}
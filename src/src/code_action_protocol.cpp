@@ -0,0 +1,231 @@
+/**
+ * @file	code_action_protocol.cpp
+ * @brief	Implements the code action requests and responses (de)serialization.
+ */
+
+#include "code_action_protocol.hpp"
+
+#include <cstdint>
+
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "base_error.hpp"
+
+namespace json = llvm::json;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static json::Value to_json(std::string);
+static json::Object to_json(const Tsepepe::ImplementInterfaceCodeActionParameters&);
+static json::Object to_json(const Tsepepe::GenerateFunctionDefinitionsCodeActionParameters&);
+static json::Object to_json(const Tsepepe::ShutdownParameters&);
+static json::Object to_json(const Tsepepe::StatisticsParameters&);
+
+static const char* get_method_name(const Tsepepe::ImplementInterfaceCodeActionParameters&);
+static const char* get_method_name(const Tsepepe::GenerateFunctionDefinitionsCodeActionParameters&);
+static const char* get_method_name(const Tsepepe::ShutdownParameters&);
+static const char* get_method_name(const Tsepepe::StatisticsParameters&);
+
+static Tsepepe::CodeActionParameters parse_parameters(const std::string& method, const json::Object& params);
+static Tsepepe::ImplementInterfaceCodeActionParameters parse_implement_interface_parameters(const json::Object&);
+static Tsepepe::GenerateFunctionDefinitionsCodeActionParameters
+parse_generate_function_definitions_parameters(const json::Object&);
+
+//! Throws BaseError when the input is not a JSON object.
+static json::Object parse_json_object(const std::string&);
+static std::string get_string(const json::Object&, const char* key);
+static unsigned get_number(const json::Object&, const char* key);
+static std::string dump(const json::Value&);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+std::string Tsepepe::serialize(const CodeActionRequest& request)
+{
+    auto [method, params] = std::visit(
+        [](const auto& params) -> std::pair<const char*, json::Object> {
+            return {get_method_name(params), to_json(params)};
+        },
+        request.parameters);
+
+    const auto& comp_db_dir{request.compilation_database_directory};
+    return dump(json::Object{{"method", method},
+                             {"compilation_database_directory", to_json(comp_db_dir.string())},
+                             {"params", std::move(params)}});
+}
+
+std::string Tsepepe::serialize(const CodeActionResponse& response)
+{
+    return dump(json::Object{{response.is_error ? "error" : "result", to_json(response.content)}});
+}
+
+std::string Tsepepe::serialize(const FileCodeInsertions& file_insertions)
+{
+    json::Array insertions;
+    for (const auto& [code, offset] : file_insertions.insertions)
+        insertions.push_back(json::Object{{"offset", offset}, {"code", to_json(code)}});
+
+    return dump(
+        json::Object{{"file", to_json(file_insertions.path.string())}, {"insertions", std::move(insertions)}});
+}
+
+std::string Tsepepe::serialize(const AstUnitCacheStatistics& statistics)
+{
+    // The JSON numbers are signed.
+    auto to_number{[](auto value) { return static_cast<std::int64_t>(value); }};
+    return dump(json::Object{{"hits", to_number(statistics.hits)},
+                             {"misses", to_number(statistics.misses)},
+                             {"evictions", to_number(statistics.evictions)},
+                             {"invalidations", to_number(statistics.invalidations)},
+                             {"memory_usage", to_number(statistics.memory_usage)}});
+}
+
+Tsepepe::CodeActionRequest Tsepepe::deserialize_code_action_request(const std::string& serialized)
+{
+    auto object{parse_json_object(serialized)};
+    auto method{get_string(object, "method")};
+
+    static const json::Object no_params;
+    auto params{object.getObject("params")};
+
+    CodeActionRequest result;
+    if (auto comp_db_dir{object.getString("compilation_database_directory")})
+        result.compilation_database_directory = comp_db_dir->str();
+    result.parameters = parse_parameters(method, params != nullptr ? *params : no_params);
+    return result;
+}
+
+Tsepepe::CodeActionResponse Tsepepe::deserialize_code_action_response(const std::string& serialized)
+{
+    auto object{parse_json_object(serialized)};
+    if (auto error{object.getString("error")})
+        return {.content = error->str(), .is_error = true};
+    return {.content = get_string(object, "result")};
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static json::Value to_json(std::string str)
+{
+    if (not json::isUTF8(str))
+        str = json::fixUTF8(str);
+    return json::Value(std::move(str));
+}
+
+static json::Object to_json(const Tsepepe::ImplementInterfaceCodeActionParameters& params)
+{
+    return json::Object{{"root_directory", to_json(params.root_directory.string())},
+                        {"source_file_path", to_json(params.source_file_path.string())},
+                        {"source_file_content", to_json(params.source_file_content)},
+                        {"interface_name", to_json(params.inteface_name)},
+                        {"cursor_position_line", params.cursor_position_line}};
+}
+
+static json::Object to_json(const Tsepepe::GenerateFunctionDefinitionsCodeActionParameters& params)
+{
+    return json::Object{{"source_file_path", to_json(params.source_file_path.string())},
+                        {"source_file_content", to_json(params.source_file_content)},
+                        {"selected_line_begin", params.selected_line_begin},
+                        {"selected_line_end", params.selected_line_end}};
+}
+
+static json::Object to_json(const Tsepepe::ShutdownParameters&)
+{
+    return {};
+}
+
+static json::Object to_json(const Tsepepe::StatisticsParameters&)
+{
+    return {};
+}
+
+static const char* get_method_name(const Tsepepe::ImplementInterfaceCodeActionParameters&)
+{
+    return "implement_interface";
+}
+
+static const char* get_method_name(const Tsepepe::GenerateFunctionDefinitionsCodeActionParameters&)
+{
+    return "generate_function_definitions";
+}
+
+static const char* get_method_name(const Tsepepe::ShutdownParameters&)
+{
+    return "shutdown";
+}
+
+static const char* get_method_name(const Tsepepe::StatisticsParameters&)
+{
+    return "statistics";
+}
+
+static Tsepepe::CodeActionParameters parse_parameters(const std::string& method, const json::Object& params)
+{
+    if (method == get_method_name(Tsepepe::ImplementInterfaceCodeActionParameters{}))
+        return parse_implement_interface_parameters(params);
+    if (method == get_method_name(Tsepepe::GenerateFunctionDefinitionsCodeActionParameters{}))
+        return parse_generate_function_definitions_parameters(params);
+    if (method == get_method_name(Tsepepe::ShutdownParameters{}))
+        return Tsepepe::ShutdownParameters{};
+    if (method == get_method_name(Tsepepe::StatisticsParameters{}))
+        return Tsepepe::StatisticsParameters{};
+    throw Tsepepe::BaseError{"Unknown code action request method: " + method};
+}
+
+static Tsepepe::ImplementInterfaceCodeActionParameters parse_implement_interface_parameters(const json::Object& params)
+{
+    return {.root_directory = get_string(params, "root_directory"),
+            .source_file_path = get_string(params, "source_file_path"),
+            .source_file_content = get_string(params, "source_file_content"),
+            .inteface_name = get_string(params, "interface_name"),
+            .cursor_position_line = get_number(params, "cursor_position_line")};
+}
+
+static Tsepepe::GenerateFunctionDefinitionsCodeActionParameters
+parse_generate_function_definitions_parameters(const json::Object& params)
+{
+    return {.source_file_path = get_string(params, "source_file_path"),
+            .source_file_content = get_string(params, "source_file_content"),
+            .selected_line_begin = get_number(params, "selected_line_begin"),
+            .selected_line_end = get_number(params, "selected_line_end")};
+}
+
+static json::Object parse_json_object(const std::string& serialized)
+{
+    auto value{json::parse(serialized)};
+    if (not value)
+        throw Tsepepe::BaseError{"Malformed JSON: " + llvm::toString(value.takeError())};
+
+    auto object{value->getAsObject()};
+    if (object == nullptr)
+        throw Tsepepe::BaseError{"Expected a JSON object: " + serialized};
+    return std::move(*object);
+}
+
+static std::string get_string(const json::Object& object, const char* key)
+{
+    auto value{object.getString(key)};
+    if (not value)
+        throw Tsepepe::BaseError{std::string{"Missing string field: "} + key};
+    return value->str();
+}
+
+static unsigned get_number(const json::Object& object, const char* key)
+{
+    auto value{object.getInteger(key)};
+    if (not value or *value < 0)
+        throw Tsepepe::BaseError{std::string{"Missing non-negative integer field: "} + key};
+    return static_cast<unsigned>(*value);
+}
+
+static std::string dump(const json::Value& value)
+{
+    std::string result;
+    llvm::raw_string_ostream os{result};
+    os << value;
+    os.flush();
+    return result;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file	code_action_server.cpp
+ * @brief	Implements the CodeActionServer.
+ */
+
+#include "code_action_server.hpp"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "base_error.hpp"
+#include "trace.hpp"
+#include "unix_socket.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::CodeActionServer::CodeActionServer(CompilationDatabaseLoader loader, CodeActionServerOptions options) :
+    load_compilation_database{std::move(loader)},
+    ast_unit_cache{std::make_shared<AstUnitCache>(options.ast_unit_cache_memory_budget)},
+    is_file_watching_enabled{options.is_file_watching_enabled}
+{
+}
+
+std::string Tsepepe::CodeActionServer::handle(const std::string& serialized_request)
+{
+    CodeActionResponse response;
+    try
+    {
+        response = handle(deserialize_code_action_request(serialized_request));
+    } catch (const std::exception& e)
+    {
+        response = CodeActionResponse{.content = e.what(), .is_error = true};
+    }
+
+    // The daemon runs until it's shut down, so the trace of each request is written right away.
+    flush_trace();
+    return serialize(response);
+}
+
+void Tsepepe::CodeActionServer::serve(std::istream& is, std::ostream& os)
+{
+    std::string line;
+    while (not shutdown_requested and std::getline(is, line))
+    {
+        if (line.empty())
+            continue;
+        os << handle(line) << std::endl;
+    }
+}
+
+void Tsepepe::CodeActionServer::serve(const fs::path& socket_path)
+{
+    auto listening_socket{UnixSocket::listen(socket_path)};
+
+    while (not shutdown_requested)
+    {
+        auto connection{listening_socket.accept()};
+        try
+        {
+            while (not shutdown_requested)
+            {
+                auto request{connection.read_line()};
+                if (not request)
+                    break;
+                connection.write_line(handle(*request));
+            }
+        } catch (const BaseError&)
+        {
+            // E.g. the client has disconnected in the middle of a request. Only that connection is dropped, so that
+            // the warm caches are kept for the next ones.
+        }
+    }
+
+    fs::remove(socket_path);
+}
+
+bool Tsepepe::CodeActionServer::is_shutdown_requested() const
+{
+    return shutdown_requested;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::CodeActionResponse Tsepepe::CodeActionServer::handle(CodeActionRequest request)
+{
+    if (std::holds_alternative<ShutdownParameters>(request.parameters))
+    {
+        shutdown_requested = true;
+        return {};
+    }
+
+    if (std::holds_alternative<StatisticsParameters>(request.parameters))
+        return {.content = serialize(ast_unit_cache->get_statistics())};
+
+    auto& project{get_project(request.compilation_database_directory)};
+
+    // The changes are read in a single batch, right before they matter.
+    apply_file_changes();
+
+    if (auto params{std::get_if<ImplementInterfaceCodeActionParameters>(&request.parameters)})
+    {
+        watch(params->root_directory);
+        return {.content = project.implement_interface_code_action.apply(std::move(*params))};
+    }
+
+    auto& params{std::get<GenerateFunctionDefinitionsCodeActionParameters>(request.parameters)};
+    return {.content = project.generate_function_definitions_code_action.apply(std::move(params))};
+}
+
+Tsepepe::CodeActionServer::Project& Tsepepe::CodeActionServer::get_project(const fs::path& compilation_database_dir)
+{
+    if (compilation_database_dir.empty())
+        throw BaseError{"Code action request lacks the compilation database directory!"};
+
+    auto key{fs::absolute(compilation_database_dir).lexically_normal()};
+    if (auto it{projects.find(key)}; it != std::end(projects))
+        return it->second;
+
+    auto compilation_database{load_compilation_database(key)};
+    Project project{.compilation_database = compilation_database,
+                    .implement_interface_code_action =
+                        ImplementIntefaceCodeActionLibclangBased{compilation_database, ast_unit_cache},
+                    .generate_function_definitions_code_action =
+                        GenerateFunctionDefinitionsCodeActionLibclangBased{compilation_database, ast_unit_cache}};
+    return projects.emplace(std::move(key), std::move(project)).first->second;
+}
+
+void Tsepepe::CodeActionServer::watch(const fs::path& root_directory)
+{
+    if (not is_file_watching_enabled or root_directory.empty())
+        return;
+
+    auto key{fs::absolute(root_directory).lexically_normal()};
+    if (file_watchers.contains(key))
+        return;
+
+    try
+    {
+        auto file_watcher{std::make_unique<FileWatcher>(key)};
+        file_watchers.emplace(std::move(key), std::move(file_watcher));
+    } catch (const std::exception&)
+    {
+        // E.g. when the limit of the inotify watches is reached. The files are then checked on every request, as
+        // without the watching.
+        disable_file_watching();
+        return;
+    }
+
+    // Only the files within the directories walked by the watchers are reported, so the ASTs depending on any other
+    // file are still checked for the changes on every request.
+    ast_unit_cache->set_watched_file_predicate([this](const fs::path& path) {
+        return std::ranges::any_of(file_watchers, [&](const auto& root_and_watcher) {
+            return root_and_watcher.second->is_watched(path);
+        });
+    });
+}
+
+void Tsepepe::CodeActionServer::apply_file_changes()
+{
+    for (const auto& [root_directory, file_watcher] : file_watchers)
+    {
+        FileChanges changes;
+        try
+        {
+            changes = file_watcher->read_changes();
+        } catch (const std::exception&)
+        {
+            disable_file_watching();
+            return;
+        }
+
+        if (changes.is_overflowed)
+        {
+            ast_unit_cache->clear();
+            continue;
+        }
+
+        std::vector<fs::path> changed_paths{std::begin(changes.files), std::end(changes.files)};
+        changed_paths.insert(
+            std::end(changed_paths), std::begin(changes.removed_directories), std::end(changes.removed_directories));
+        ast_unit_cache->evict(changed_paths);
+
+        for (auto& [_, project] : projects)
+            project.implement_interface_code_action.update_class_index(root_directory, changes);
+    }
+}
+
+void Tsepepe::CodeActionServer::disable_file_watching()
+{
+    // The changes made since the last read are lost, so the ASTs might be outdated.
+    is_file_watching_enabled = false;
+    file_watchers.clear();
+    ast_unit_cache->set_watched_file_predicate({});
+    ast_unit_cache->clear();
+}
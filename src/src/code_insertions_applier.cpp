@@ -5,8 +5,11 @@
 
 #include "code_insertions_applier.hpp"
 #include "base_error.hpp"
+#include "trace.hpp"
 
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <numeric>
 #include <string>
 
@@ -25,6 +28,8 @@ static void validate_insertions_in_bounds(const std::string& input, const CodeIn
 // --------------------------------------------------------------------------------------------------------------------
 std::string Tsepepe::apply_insertions(const std::string& input, std::vector<CodeInsertionByOffset> insertions)
 {
+    TraceSpan span{"apply_insertions"};
+
     validate_insertions_in_bounds(input, insertions);
 
     auto [new_insertions_end_it, insertions_end_it] = std::ranges::remove_if(
@@ -62,6 +67,27 @@ std::string Tsepepe::apply_insertions(const std::string& input, std::vector<Code
     return result;
 }
 
+void Tsepepe::apply_insertions_in_place(FileCodeInsertions file_insertions)
+{
+    const auto& path{file_insertions.path};
+    if (file_insertions.insertions.empty())
+        return;
+
+    std::string content;
+    {
+        std::ifstream ifs{path, std::ios::binary};
+        if (not ifs)
+            throw BaseError{"Failed to read the file: " + path.string()};
+        content.assign(std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{});
+    }
+
+    auto new_content{apply_insertions(content, std::move(file_insertions.insertions))};
+
+    std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+    if (not ofs.write(new_content.data(), static_cast<std::streamsize>(new_content.size())))
+        throw BaseError{"Failed to write the file: " + path.string()};
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // Private definitions
 // --------------------------------------------------------------------------------------------------------------------
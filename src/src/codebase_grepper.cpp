@@ -4,78 +4,332 @@
  */
 
 #include "codebase_grepper.hpp"
-#include "base_error.hpp"
+#include "content_grepper.hpp"
+#include "gitignore.hpp"
+#include "trace.hpp"
 
-#include <boost/process.hpp>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper declarations
 // --------------------------------------------------------------------------------------------------------------------
 namespace fs = std::filesystem;
 
-//! Parses ripgrep --vimgrep output and returns a tuple: matching file, line number and beginning column number.
-static std::tuple<fs::path, unsigned, unsigned> parse_line(const std::string& line);
+namespace
+{
+
+struct PendingPath
+{
+    fs::path path;
+    //! The rules, which apply to the entries of the directory. Unused for regular files.
+    std::shared_ptr<const Tsepepe::GitIgnore> gitignore;
+    bool is_directory;
+};
+
+//! Walks the directory tree with multiple threads. Each thread takes a directory or a file from the shared queue:
+//! directory entries are pushed back to the queue, and files are visited right away. The first exception thrown by any
+//! thread stops the walk, and is rethrown by walk().
+class ParallelCodebaseWalker
+{
+  public:
+    ParallelCodebaseWalker(const Tsepepe::CodebaseVisitor&, const Tsepepe::CodebaseDirectoryVisitor&);
+
+    void walk(const fs::path& root);
+
+  private:
+    void work();
+    void visit_directory(const PendingPath&);
+
+    const Tsepepe::CodebaseVisitor& visitor;
+    const Tsepepe::CodebaseDirectoryVisitor& directory_visitor;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::deque<PendingPath> pending_paths;
+    unsigned busy_workers_count{0};
+    bool is_stopped{false};
+    std::exception_ptr first_exception;
+};
+
+} // namespace
+
+//! Finds the .gitignore files and .git/info/exclude, which apply to the root directory, but are located in the parent
+//! directories. Returns the rules, which apply to the root directory, or nullptr, when the root directory doesn't
+//! belong to a git repository.
+static std::shared_ptr<const Tsepepe::GitIgnore> load_parent_gitignores(const fs::path& root);
+
+//! Loads the .gitignore file from the directory, if there is any, and chains it with the parent rules.
+static std::shared_ptr<const Tsepepe::GitIgnore> load_gitignore(const fs::path& directory,
+                                                                std::shared_ptr<const Tsepepe::GitIgnore> parent);
+
+//! Mimics the ripgrep's "-t cpp" file type filter.
+static bool is_cpp_file(const fs::path&);
+
+static bool is_hidden(const fs::path&);
+
+static std::optional<std::string> read_file(const fs::path&);
+
+static std::vector<Tsepepe::GrepMatch> search_file(const Tsepepe::ContentGrepper&, const fs::path&);
 
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
 // --------------------------------------------------------------------------------------------------------------------
 std::vector<Tsepepe::GrepMatch> Tsepepe::codebase_grep(RootDirectory root_dir_alias, EcmaScriptPattern pattern)
 {
-    const auto& root_dir{root_dir_alias.get()};
-    std::string command{"rg " + pattern.get() + " " + root_dir.string() + " --vimgrep -t cpp"};
+    TraceSpan span{"codebase_grep", root_dir_alias.get().string()};
 
-    std::vector<Tsepepe::GrepMatch> result;
+    const ContentGrepper content_grepper{std::move(pattern)};
+    std::mutex matches_mutex;
+    std::vector<GrepMatch> matches;
+    walk_codebase(std::move(root_dir_alias), [&](const fs::path& path) {
+        auto file_matches{search_file(content_grepper, path)};
+        if (not file_matches.empty())
+        {
+            std::lock_guard lock{matches_mutex};
+            std::ranges::move(file_matches, std::back_inserter(matches));
+        }
+        return true;
+    });
 
-    using namespace boost::process;
+    // The order, in which the threads find the matches, is not deterministic.
+    std::ranges::sort(matches);
+    return matches;
+}
 
-    ipstream pipe_stream;
-    child c{std::move(command), std_out > pipe_stream};
+void Tsepepe::walk_codebase(RootDirectory root_dir_alias,
+                            const CodebaseVisitor& visitor,
+                            const CodebaseDirectoryVisitor& directory_visitor)
+{
+    ParallelCodebaseWalker{visitor, directory_visitor}.walk(fs::absolute(root_dir_alias.get()).lexically_normal());
+}
+
+bool Tsepepe::is_directory_skipped_by_codebase_walk(const fs::path& directory)
+{
+    auto path{fs::absolute(directory).lexically_normal()};
+    if (is_hidden(path))
+        return true;
+
+    // The same rules, as the ones the parent directory entries are checked against, when it's visited.
+    auto gitignore{load_parent_gitignores(path)};
+    return gitignore != nullptr and gitignore->is_ignored(path, /* is_directory= */ true);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+ParallelCodebaseWalker::ParallelCodebaseWalker(const Tsepepe::CodebaseVisitor& visitor_,
+                                               const Tsepepe::CodebaseDirectoryVisitor& directory_visitor_) :
+    visitor{visitor_}, directory_visitor{directory_visitor_}
+{
+}
+
+void ParallelCodebaseWalker::walk(const fs::path& root)
+{
+    pending_paths.push_back(PendingPath{
+        .path = root, .gitignore = load_parent_gitignores(root), .is_directory = fs::is_directory(root)});
 
-    auto current_path{fs::current_path()};
-    std::string line;
-    while (pipe_stream && std::getline(pipe_stream, line) && !line.empty())
+    auto workers_count{std::max(1u, std::thread::hardware_concurrency())};
+    std::vector<std::jthread> workers;
+    workers.reserve(workers_count - 1);
+    for (unsigned i{1}; i < workers_count; ++i)
+        workers.emplace_back([this]() { work(); });
+    work();
+
+    for (auto& worker : workers)
+        worker.join();
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
+void ParallelCodebaseWalker::work()
+{
+    std::unique_lock lock{mutex};
+    while (true)
     {
-        auto [relative_path, line_number, column_begin] = parse_line(line);
-        result.emplace_back(
-            Tsepepe::GrepMatch{.path = current_path / relative_path, .line = line_number, .column = column_begin});
+        work_available.wait(lock, [this]() { return not pending_paths.empty() or busy_workers_count == 0; });
+        if (pending_paths.empty())
+            break;
+
+        auto pending_path{std::move(pending_paths.front())};
+        pending_paths.pop_front();
+        ++busy_workers_count;
+        lock.unlock();
+
+        auto is_stop_requested{false};
+        std::exception_ptr exception;
+        try
+        {
+            if (pending_path.is_directory)
+                visit_directory(pending_path);
+            else
+                is_stop_requested = not visitor(pending_path.path);
+        } catch (...)
+        {
+            // An exception escaping a thread would terminate the process.
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+        if (exception and not first_exception)
+            first_exception = exception;
+        if (is_stop_requested or exception)
+        {
+            // No new paths are taken, once stopped, so the others finish, as soon as they are done with the current
+            // ones.
+            is_stopped = true;
+            pending_paths.clear();
+        }
+        --busy_workers_count;
+        // Wakes up the others, also when there is no work left, so that they finish.
+        work_available.notify_all();
     }
+}
 
-    c.wait();
+void ParallelCodebaseWalker::visit_directory(const PendingPath& directory)
+{
+    if (directory_visitor and not directory_visitor(directory.path))
+        return;
 
-    return result;
+    auto gitignore{load_gitignore(directory.path, directory.gitignore)};
+
+    std::vector<PendingPath> entries;
+    std::error_code ec;
+    for (fs::directory_iterator it{directory.path, ec}, end; not ec and it != end; it.increment(ec))
+    {
+        const auto& entry{*it};
+        const auto& path{entry.path()};
+
+        // Symbolic links are not followed, the same as hidden files are skipped, the way ripgrep does it by default.
+        std::error_code entry_ec;
+        if (is_hidden(path) or entry.is_symlink(entry_ec))
+            continue;
+
+        auto is_directory{entry.is_directory(entry_ec)};
+        if (not is_directory and not(entry.is_regular_file(entry_ec) and is_cpp_file(path)))
+            continue;
+
+        if (gitignore != nullptr and gitignore->is_ignored(path, is_directory))
+            continue;
+
+        entries.emplace_back(PendingPath{.path = path, .gitignore = gitignore, .is_directory = is_directory});
+    }
+
+    if (entries.empty())
+        return;
+
+    std::lock_guard guard{mutex};
+    if (is_stopped)
+        return;
+    std::ranges::move(entries, std::back_inserter(pending_paths));
+    work_available.notify_all();
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper definitions
 // --------------------------------------------------------------------------------------------------------------------
-static std::tuple<fs::path, unsigned, unsigned> parse_line(const std::string& line)
+static std::shared_ptr<const Tsepepe::GitIgnore> load_parent_gitignores(const fs::path& root)
+{
+    std::vector<fs::path> parent_directories;
+    std::optional<fs::path> repository_root;
+    for (auto directory{root}; not directory.empty(); directory = directory.parent_path())
+    {
+        if (fs::exists(directory / ".git"))
+        {
+            repository_root = directory;
+            break;
+        }
+        if (directory == directory.root_path())
+            break;
+        parent_directories.push_back(directory);
+    }
+
+    if (not repository_root)
+        return nullptr;
+
+    // Non-null, even without any rules, to tell that the root directory is within a git repository.
+    std::shared_ptr<const Tsepepe::GitIgnore> result{std::make_shared<const Tsepepe::GitIgnore>(
+        read_file(*repository_root / ".git" / "info" / "exclude").value_or(""), *repository_root)};
+
+    // The root directory itself is skipped, since its .gitignore is loaded, when the root directory is visited.
+    if (*repository_root != root)
+        result = load_gitignore(*repository_root, std::move(result));
+    for (auto it{std::rbegin(parent_directories)}; it != std::rend(parent_directories); ++it)
+        if (*it != root)
+            result = load_gitignore(*it, std::move(result));
+    return result;
+}
+
+static std::shared_ptr<const Tsepepe::GitIgnore> load_gitignore(const fs::path& directory,
+                                                                std::shared_ptr<const Tsepepe::GitIgnore> parent)
+{
+    // Outside of a git repository the .gitignore files are not respected.
+    if (parent == nullptr)
+        return nullptr;
+
+    auto content{read_file(directory / ".gitignore")};
+    if (not content)
+        return parent;
+    return std::make_shared<const Tsepepe::GitIgnore>(*content, directory, std::move(parent));
+}
+
+static bool is_cpp_file(const fs::path& path)
+{
+    static const std::array<std::string, 11> extensions{
+        ".C", ".c", ".H", ".h", ".cc", ".cpp", ".hpp", ".cxx", ".hxx", ".hh", ".inl"};
+
+    auto file_name{path.filename()};
+    auto extension{file_name.extension()};
+    if (extension == ".in")
+        extension = file_name.stem().extension();
+    return std::find(std::begin(extensions), std::end(extensions), extension.native()) != std::end(extensions);
+}
+
+static bool is_hidden(const fs::path& path)
 {
-    auto beg{0};
-    auto end{line.find(':')};
-    if (end == std::string::npos)
-        throw Tsepepe::BaseError{"Unexpected ripgrep output, when parsing path of a file with the match"};
+    return path.filename().native().starts_with('.');
+}
 
-    fs::path relative_path{line.substr(beg, end)};
+static std::optional<std::string> read_file(const fs::path& path)
+{
+    std::ifstream ifs{path, std::ios::binary};
+    if (not ifs)
+        return std::nullopt;
 
-    ++end;
-    beg = end;
-    end = line.find(':', beg);
-    if (end == std::string::npos)
-        throw Tsepepe::BaseError{"Unexpected ripgrep output, when parsing line number with the match"};
+    std::string content;
+    std::error_code ec;
+    auto size{fs::file_size(path, ec)};
+    if (not ec)
+        content.resize(size);
 
-    auto line_number_str{line.substr(beg, end - beg)};
-    auto line_number{std::stoul(line_number_str)};
+    ifs.read(content.data(), static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<std::size_t>(ifs.gcount()));
+    return content;
+}
 
-    ++end;
-    beg = end;
-    end = line.find(':', beg);
-    if (end == std::string::npos)
-        throw Tsepepe::BaseError{"Unexpected ripgrep output, when parsing column begin number where the match begins"};
+static std::vector<Tsepepe::GrepMatch> search_file(const Tsepepe::ContentGrepper& content_grepper, const fs::path& path)
+{
+    auto content{read_file(path)};
+    if (not content)
+        return {};
 
-    auto column_begin_str{line.substr(beg, end - beg)};
-    auto column_begin{std::stoul(column_begin_str)};
+    // Binary files are skipped.
+    if (content->find('\0') != std::string::npos)
+        return {};
 
-    return {relative_path, line_number, column_begin};
+    std::vector<Tsepepe::GrepMatch> result;
+    for (const auto& match : content_grepper.grep(*content))
+        result.emplace_back(Tsepepe::GrepMatch{.path = path, .line = match.line, .column = match.column});
+    return result;
 }
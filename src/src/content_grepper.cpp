@@ -0,0 +1,271 @@
+/**
+ * @file	content_grepper.cpp
+ * @brief	Implements the ContentGrepper.
+ */
+
+#include "content_grepper.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "base_error.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static std::regex compile(const std::string& pattern, bool is_multiline);
+
+//! Finds the longest string, which every match of the pattern contains. Returns an empty string, when the pattern
+//! is too complex to find one.
+static std::string find_required_literal(std::string_view pattern);
+
+//! Returns nullptr, when there is no newline character within the range.
+static const char* find_newline(const char* begin, const char* end);
+
+//! Returns the offsets of all the newline characters.
+static std::vector<std::size_t> find_newlines(std::string_view content);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::ContentGrepper::ContentGrepper(EcmaScriptPattern pattern_alias, bool is_multiline) :
+    regex{compile(pattern_alias.get(), is_multiline)},
+    required_literal{find_required_literal(pattern_alias.get())},
+    // Line anchors and lookaheads behave differently, when the regex is run over the entire content, instead of a
+    // single line. Without them, each match found within a line is also found within the entire content.
+    can_search_entire_content{pattern_alias.get().find_first_of("^$") == std::string::npos
+                              and pattern_alias.get().find("(?") == std::string::npos},
+    is_multiline{is_multiline}
+{
+}
+
+std::vector<Tsepepe::ContentGrepMatch> Tsepepe::ContentGrepper::grep(std::string_view content) const
+{
+    std::vector<ContentGrepMatch> result;
+    if (is_multiline)
+        grep_multiline(content, result);
+    else
+        grep_lines(content, result);
+    return result;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+void Tsepepe::ContentGrepper::grep_lines(std::string_view content, std::vector<ContentGrepMatch>& result) const
+{
+    const char* begin{content.data()};
+    const char* end{begin + content.size()};
+
+    const char* line_begin{begin};
+    unsigned line_number{1};
+    while (line_begin < end)
+    {
+        auto candidate{find_candidate(line_begin, end)};
+        if (candidate == nullptr)
+            return;
+
+        while (auto newline{find_newline(line_begin, candidate)})
+        {
+            line_begin = newline + 1;
+            ++line_number;
+        }
+
+        auto newline{find_newline(candidate, end)};
+        const char* line_end{newline != nullptr ? newline : end};
+
+        for (std::cregex_iterator it{line_begin, line_end, regex}, it_end; it != it_end; ++it)
+            result.emplace_back(ContentGrepMatch{.line = line_number,
+                                                 .column = static_cast<unsigned>(it->position(0)) + 1,
+                                                 .last_line = line_number});
+
+        line_begin = line_end + 1;
+        ++line_number;
+    }
+}
+
+void Tsepepe::ContentGrepper::grep_multiline(std::string_view content, std::vector<ContentGrepMatch>& result) const
+{
+    // A match may begin many lines before the required literal, so it can only tell whether there is any match.
+    if (not required_literal.empty() and content.find(required_literal) == std::string_view::npos)
+        return;
+
+    const char* begin{content.data()};
+    const char* end{begin + content.size()};
+
+    std::vector<std::size_t> newline_offsets;
+    bool are_newlines_found{false};
+
+    auto get_line_index{[&newline_offsets](std::size_t offset) {
+        auto it{std::ranges::lower_bound(newline_offsets, offset)};
+        return static_cast<std::size_t>(it - std::begin(newline_offsets));
+    }};
+
+    for (std::cregex_iterator it{begin, end, regex}, it_end; it != it_end; ++it)
+    {
+        // The content is scanned for the newlines only when there is any match.
+        if (not are_newlines_found)
+        {
+            newline_offsets = find_newlines(content);
+            are_newlines_found = true;
+        }
+
+        auto offset{static_cast<std::size_t>(it->position(0))};
+        auto length{static_cast<std::size_t>(it->length(0))};
+
+        auto line_index{get_line_index(offset)};
+        auto line_begin_offset{line_index == 0 ? 0 : newline_offsets[line_index - 1] + 1};
+        auto last_line_index{length == 0 ? line_index : get_line_index(offset + length - 1)};
+
+        result.emplace_back(ContentGrepMatch{.line = static_cast<unsigned>(line_index) + 1,
+                                             .column = static_cast<unsigned>(offset - line_begin_offset) + 1,
+                                             .last_line = static_cast<unsigned>(last_line_index) + 1});
+    }
+}
+
+const char* Tsepepe::ContentGrepper::find_candidate(const char* begin, const char* end) const
+{
+    if (not required_literal.empty())
+    {
+        std::string_view content{begin, static_cast<std::size_t>(end - begin)};
+        auto position{content.find(required_literal)};
+        return position != std::string_view::npos ? begin + position : nullptr;
+    }
+
+    if (can_search_entire_content)
+    {
+        std::cmatch match;
+        if (not std::regex_search(begin, end, match, regex))
+            return nullptr;
+        return begin + match.position(0);
+    }
+
+    return begin;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static std::regex compile(const std::string& pattern, bool is_multiline)
+{
+    auto flags{std::regex::ECMAScript | std::regex::optimize};
+    if (is_multiline)
+        flags |= std::regex::multiline;
+
+    try
+    {
+        return std::regex{pattern, flags};
+    } catch (const std::regex_error& e)
+    {
+        throw Tsepepe::BaseError{"Invalid grep pattern: " + pattern + ": " + e.what()};
+    }
+}
+
+static std::string find_required_literal(std::string_view pattern)
+{
+    std::string longest_literal;
+    std::string literal;
+
+    auto finish_literal{[&]() {
+        if (literal.size() > longest_literal.size())
+            longest_literal = literal;
+        literal.clear();
+    }};
+
+    // Both return the index of the closing character, minding the escapes.
+    auto skip_to{[&pattern](std::size_t i, char closing) {
+        for (; i < pattern.size() and pattern[i] != closing; ++i)
+            if (pattern[i] == '\\')
+                ++i;
+        return i;
+    }};
+    auto skip_group{[&pattern](std::size_t i) {
+        unsigned depth{0};
+        for (; i < pattern.size(); ++i)
+        {
+            if (pattern[i] == '\\')
+                ++i;
+            else if (pattern[i] == '(')
+                ++depth;
+            else if (pattern[i] == ')' and --depth == 0)
+                break;
+        }
+        return i;
+    }};
+
+    for (std::size_t i{0}; i < pattern.size(); ++i)
+    {
+        auto c{pattern[i]};
+        switch (c)
+        {
+        case '|':
+            // Any of the alternatives may match, so there is no single literal, which every match contains.
+            return "";
+
+        case '*':
+        case '?':
+        case '{':
+            // The preceding character may not appear within the match at all.
+            if (not literal.empty())
+                literal.pop_back();
+            finish_literal();
+            if (c == '{')
+                i = skip_to(i, '}');
+            break;
+
+        case '+':
+            finish_literal();
+            break;
+
+        case '(':
+            finish_literal();
+            i = skip_group(i);
+            break;
+
+        case '[':
+            finish_literal();
+            i = skip_to(i + 1, ']');
+            break;
+
+        case '.':
+        case '^':
+        case '$':
+            finish_literal();
+            break;
+
+        case '\\':
+            if (++i == pattern.size())
+                return "";
+            // Escaped letters and digits are character classes, assertions or back references, while other escaped
+            // characters are matched literally.
+            if (std::isalnum(static_cast<unsigned char>(pattern[i])))
+                finish_literal();
+            else
+                literal.push_back(pattern[i]);
+            break;
+
+        default:
+            literal.push_back(c);
+        }
+    }
+
+    finish_literal();
+    return longest_literal;
+}
+
+static const char* find_newline(const char* begin, const char* end)
+{
+    return static_cast<const char*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+}
+
+static std::vector<std::size_t> find_newlines(std::string_view content)
+{
+    std::vector<std::size_t> result;
+
+    const char* begin{content.data()};
+    const char* end{begin + content.size()};
+    for (const char* position{begin}; auto newline{find_newline(position, end)}; position = newline + 1)
+        result.push_back(static_cast<std::size_t>(newline - begin));
+    return result;
+}
@@ -5,14 +5,8 @@
 
 #include "file_grepper.hpp"
 
-#include <boost/process.hpp>
-
-// --------------------------------------------------------------------------------------------------------------------
-// Helper declarations
-// --------------------------------------------------------------------------------------------------------------------
-
-//! Parses ripgrep --vimgrep output and returns a tuple: matching file, line number and beginning column number.
-// static std::tuple<fs::path, unsigned, unsigned> parse_line(const std::string& line);
+#include "content_grepper.hpp"
+#include "trace.hpp"
 
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
@@ -20,36 +14,19 @@
 Tsepepe::FileGrepMatches
 Tsepepe::grep_file(const std::string& file_content, RustRegexPattern pattern, GrepOptions options)
 {
-    std::string command{"rg " + pattern.get() + " --line-number"};
-    if (options.enable_multiline_regex)
-        command.append(" --multiline");
-    command.append(" -");
+    TraceSpan span{"grep_file"};
 
-    using namespace boost::process;
-
-    ipstream output;
-    opstream input;
-    child c{std::move(command), std_out > output, std_in < input};
-
-    input << file_content;
-    input.close();
-    input.pipe().close();
+    // The patterns used within the project belong to the common subset of the Rust and ECMAScript regex syntax.
+    ContentGrepper grepper{EcmaScriptPattern{std::move(pattern.get())}, options.enable_multiline_regex != 0};
 
     FileGrepMatches result;
     result.reserve(8);
-    std::string line;
 
-    while (output && std::getline(output, line) && !line.empty())
-    {
-        auto colon_idx{line.find(':')};
-        if (colon_idx == std::string::npos)
-            continue;
-        auto line_number_str{line.substr(0, colon_idx)};
-        result.emplace_back(std::stoul(line_number_str));
-    }
-
-    c.wait();
+    // Each line, which any match spans, is reported once, the way ripgrep reports it.
+    for (const auto& match : grepper.grep(file_content))
+        for (auto line{match.line}; line <= match.last_line; ++line)
+            if (result.empty() or result.back() < line)
+                result.push_back(line);
 
     return result;
 }
-
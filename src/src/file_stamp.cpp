@@ -0,0 +1,19 @@
+/**
+ * @file	file_stamp.cpp
+ * @brief	Implements the file stamping.
+ */
+
+#include "file_stamp.hpp"
+
+#include <sys/stat.h>
+
+std::optional<Tsepepe::FileStamp> Tsepepe::get_file_stamp(const std::filesystem::path& path)
+{
+    struct stat status;
+    if (::stat(path.c_str(), &status) != 0)
+        return std::nullopt;
+
+    return FileStamp{.modification_time =
+                         static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1'000'000'000 + status.st_mtim.tv_nsec,
+                     .size = static_cast<std::uint64_t>(status.st_size)};
+}
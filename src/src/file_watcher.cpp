@@ -0,0 +1,224 @@
+/**
+ * @file	file_watcher.cpp
+ * @brief	Implements the FileWatcher.
+ */
+
+#include "file_watcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "base_error.hpp"
+#include "codebase_grepper.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+//! The events on the watched directories themselves are not needed, since the parent directories report them.
+static constexpr std::uint32_t watched_events{IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB
+                                              | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_DONT_FOLLOW
+                                              | IN_EXCL_UNLINK};
+
+static constexpr std::uint32_t entry_added_or_removed_events{IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO};
+
+//! Returns false, when no event has arrived within the timeout.
+static bool wait_for_events(int fd, std::chrono::milliseconds timeout);
+
+static bool is_within_directory(const fs::path& directory, const fs::path& path);
+static bool is_hidden(std::string_view file_name);
+static Tsepepe::BaseError make_error(const std::string& message, int error_number = errno);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+// The root is resolved, since the ASTs refer to the included files with the real paths.
+Tsepepe::FileWatcher::FileWatcher(fs::path root_) :
+    root{fs::canonical(root_)}, fd{::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+{
+    if (fd < 0)
+        throw make_error("Failed to initialize inotify");
+
+    try
+    {
+        watch_directory_tree(root);
+    } catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+}
+
+Tsepepe::FileWatcher::~FileWatcher()
+{
+    ::close(fd);
+}
+
+Tsepepe::FileChanges Tsepepe::FileWatcher::read_changes(std::chrono::milliseconds timeout)
+{
+    FileChanges result;
+    if (not wait_for_events(fd, timeout))
+        return result;
+
+    while (read_events(result))
+    {
+    }
+    return result;
+}
+
+bool Tsepepe::FileWatcher::is_watched(const fs::path& file) const
+{
+    return not is_hidden(file.filename().native()) and watched_directory_paths.contains(file.parent_path().native());
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+void Tsepepe::FileWatcher::watch_directory_tree(const fs::path& directory, FileChanges* changes)
+{
+    // The visitors are called from multiple threads.
+    std::mutex mutex;
+    std::optional<BaseError> error;
+
+    walk_codebase(
+        RootDirectory{directory},
+        [&](const fs::path& path) {
+            if (changes == nullptr)
+                return true;
+
+            std::lock_guard lock{mutex};
+            changes->files.insert(path);
+            return true;
+        },
+        [&](const fs::path& path) {
+            auto watch_descriptor{::inotify_add_watch(fd, path.c_str(), watched_events)};
+            auto error_number{errno};
+
+            std::lock_guard lock{mutex};
+            if (watch_descriptor >= 0)
+            {
+                watched_directories.insert_or_assign(watch_descriptor, path);
+                watched_directory_paths.insert(path.native());
+            }
+            // The directory might have been removed in the meantime, which is reported by the parent directory.
+            else if (error_number != ENOENT and not error)
+                error = make_error("Failed to watch directory: " + path.string(), error_number);
+            return watch_descriptor >= 0;
+        });
+
+    if (error)
+        throw *error;
+}
+
+void Tsepepe::FileWatcher::unwatch_directory_tree(const fs::path& directory)
+{
+    std::erase_if(watched_directories, [&](const auto& watch_descriptor_and_path) {
+        const auto& [watch_descriptor, path] = watch_descriptor_and_path;
+        if (not is_within_directory(directory, path))
+            return false;
+
+        // Fails for the removed directories, which are unwatched by the kernel already.
+        ::inotify_rm_watch(fd, watch_descriptor);
+        watched_directory_paths.erase(path.native());
+        return true;
+    });
+}
+
+bool Tsepepe::FileWatcher::read_events(FileChanges& changes)
+{
+    alignas(inotify_event) char buffer[64 * 1024];
+    auto count{::read(fd, buffer, sizeof(buffer))};
+    if (count < 0 and errno == EINTR)
+        return true;
+    if (count < 0 and (errno == EAGAIN or errno == EWOULDBLOCK))
+        return false;
+    if (count < 0)
+        throw make_error("Failed to read the file events");
+
+    for (ssize_t offset{0}; offset < count;)
+    {
+        const auto& event{*reinterpret_cast<const inotify_event*>(buffer + offset)};
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+
+        if (event.mask & IN_Q_OVERFLOW)
+        {
+            changes.is_overflowed = true;
+            continue;
+        }
+
+        auto it{watched_directories.find(event.wd)};
+        if (it == std::end(watched_directories))
+            continue;
+        if (event.mask & IN_IGNORED)
+        {
+            watched_directory_paths.erase(it->second.native());
+            watched_directories.erase(it);
+            continue;
+        }
+        if (event.len == 0 or is_hidden(event.name))
+            continue;
+
+        // Copied, since watching the new directories may invalidate the iterator.
+        auto directory{it->second};
+        auto path{directory / event.name};
+        if (event.mask & entry_added_or_removed_events)
+            changes.directories.insert(directory);
+
+        if (not(event.mask & IN_ISDIR))
+        {
+            changes.files.insert(std::move(path));
+        } else if (event.mask & (IN_CREATE | IN_MOVED_TO))
+        {
+            // E.g. a build directory, which would take lots of the watches, and report all the generated files.
+            if (not is_directory_skipped_by_codebase_walk(path))
+                watch_directory_tree(path, &changes);
+        } else if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+        {
+            unwatch_directory_tree(path);
+            changes.removed_directories.insert(std::move(path));
+        }
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static bool wait_for_events(int fd, std::chrono::milliseconds timeout)
+{
+    pollfd poll_fd{.fd = fd, .events = POLLIN, .revents = 0};
+    while (true)
+    {
+        auto result{::poll(&poll_fd, 1, static_cast<int>(timeout.count()))};
+        if (result >= 0)
+            return result > 0;
+        if (errno != EINTR)
+            throw make_error("Failed to wait for the file events");
+    }
+}
+
+static bool is_within_directory(const fs::path& directory, const fs::path& path)
+{
+    return std::mismatch(std::begin(directory), std::end(directory), std::begin(path), std::end(path)).first
+           == std::end(directory);
+}
+
+static bool is_hidden(std::string_view file_name)
+{
+    return file_name.starts_with('.');
+}
+
+static Tsepepe::BaseError make_error(const std::string& message, int error_number)
+{
+    return Tsepepe::BaseError{message + ": " + std::strerror(error_number)};
+}
@@ -9,12 +9,14 @@
 #include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/Tooling/Tooling.h>
 
+#include <set>
 #include <utility>
 
 #include "base_error.hpp"
 #include "libclang_utils/full_function_declaration_expander.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
 #include "string_utils.hpp"
-#include "temporary_file_maker.hpp"
+#include "trace.hpp"
 
 namespace fs = std::filesystem;
 using namespace clang;
@@ -36,10 +38,9 @@ AST_MATCHER_P(FunctionDecl, isWithinLines, LineRange, line_range)
 }
 
 Tsepepe::GenerateFunctionDefinitionsCodeActionLibclangBased::GenerateFunctionDefinitionsCodeActionLibclangBased(
-    std::shared_ptr<clang::tooling::CompilationDatabase> comp_db) :
+    std::shared_ptr<clang::tooling::CompilationDatabase> comp_db, std::shared_ptr<AstUnitCache> cache) :
     compilation_database{std::move(comp_db)},
-    tsepepe_temp_directory_tree{fs::temp_directory_path() / "tsepepe"},
-    this_code_action_directory_tree{fs::temp_directory_path() / "tsepepe" / "gen_func_def_code_action"}
+    ast_unit_cache{cache != nullptr ? std::move(cache) : std::make_shared<AstUnitCache>()}
 {
 }
 
@@ -48,19 +49,17 @@ std::string Tsepepe::GenerateFunctionDefinitionsCodeActionLibclangBased::apply(
 {
     validate_selected_range(params);
 
-    auto full_path_to_temp_file{
-        Tsepepe::make_temporary_source_file(params.source_file_path, "func_decls", params.source_file_content)};
+    auto source_file_path{Tsepepe::get_in_memory_source_file_path(params.source_file_path, "func_decls")};
+    auto ast_unit_ptr{ast_unit_cache->get(
+        *compilation_database, source_file_path, {{.path = source_file_path, .content = params.source_file_content}})};
+    auto& ast_unit{*ast_unit_ptr};
 
-    std::vector<std::unique_ptr<ASTUnit>> ast_units;
-    ClangTool tool{*compilation_database, {full_path_to_temp_file.string()}};
-    tool.buildASTs(ast_units);
-
-    auto& ast_unit{*ast_units.back()};
     auto matcher{ast_matchers::functionDecl(ast_matchers::unless(ast_matchers::isDefinition()),
-                                            isWithinFile(full_path_to_temp_file),
+                                            isWithinFile(source_file_path),
                                             isWithinLines({params.selected_line_begin, params.selected_line_end}))
                      .bind("function")};
-    auto matches{ast_matchers::match(matcher, ast_unit.getASTContext())};
+    auto matches{
+        traced("ast_matchers::match", [&]() { return ast_matchers::match(matcher, ast_unit.getASTContext()); })};
     if (matches.empty())
         return "";
 
@@ -84,6 +83,63 @@ std::string Tsepepe::GenerateFunctionDefinitionsCodeActionLibclangBased::apply(
     return result;
 }
 
+std::vector<Tsepepe::CodeInsertionByOffset> Tsepepe::GenerateFunctionDefinitionsCodeActionLibclangBased::apply(
+    GenerateMissingFunctionDefinitionsCodeActionParameters params)
+{
+    auto header_file_path{fs::absolute(params.header_file_path).lexically_normal()};
+    std::vector<UnsavedFile> unsaved_files{{.path = header_file_path, .content = params.header_file_content}};
+    auto ast_unit{ast_unit_cache->get(*compilation_database, params.paired_source_file_path, unsaved_files)};
+
+    const auto& source_manager{ast_unit->getSourceManager()};
+    auto header_file_entry{ast_unit->getFileManager().getFile(header_file_path.string())};
+    if (not header_file_entry or source_manager.translateFile(*header_file_entry).isInvalid())
+        throw Tsepepe::BaseError{"The source file: " + params.paired_source_file_path.string()
+                                 + " doesn't include the header: " + header_file_path.string()};
+
+    auto is_within_header{[&](const FunctionDecl* node) {
+        auto file_id{source_manager.getFileID(source_manager.getExpansionLoc(node->getLocation()))};
+        return source_manager.getFileEntryForID(file_id) == *header_file_entry;
+    }};
+
+    auto is_definition_missing{[](const FunctionDecl* node) {
+        // The skipped function bodies still make the definitions.
+        return node->getDefinition() == nullptr and not node->isPure() and not node->isTemplated()
+               and not node->isInlineSpecified() and not node->isConstexpr()
+               and node->getFriendObjectKind() == Decl::FOK_None;
+    }};
+
+    auto matcher{ast_matchers::functionDecl(ast_matchers::unless(ast_matchers::isDefinition()),
+                                            ast_matchers::unless(ast_matchers::isImplicit()))
+                     .bind("function")};
+    auto matches{
+        traced("ast_matchers::match", [&]() { return ast_matchers::match(matcher, ast_unit->getASTContext()); })};
+
+    std::vector<std::string> definitions;
+    std::set<const FunctionDecl*> redeclarations_visited;
+    for (const auto& match : matches)
+    {
+        auto node{match.getNodeAs<FunctionDecl>("function")};
+        if (node == nullptr or not is_within_header(node) or not is_definition_missing(node))
+            continue;
+        if (not redeclarations_visited.insert(node->getCanonicalDecl()).second)
+            continue;
+        definitions.emplace_back(Tsepepe::fully_expand_function_declaration(
+            node, source_manager, {.ignore_attribute_specifiers = true, .remove_scope_from_parameters = true}));
+    }
+
+    if (definitions.empty())
+        return {};
+
+    auto source_file_content{source_manager.getBufferData(source_manager.getMainFileID())};
+    std::string code;
+    if (not source_file_content.empty())
+        code = source_file_content.back() == '\n' ? "\n" : "\n\n";
+    code += Tsepepe::utils::join(definitions, "\n{\n}\n\n");
+    code += "\n{\n}\n";
+    auto offset{static_cast<unsigned>(source_file_content.size())};
+    return {CodeInsertionByOffset{.code = std::move(code), .offset = offset}};
+}
+
 void Tsepepe::GenerateFunctionDefinitionsCodeActionLibclangBased::validate_selected_range(
     const GenerateFunctionDefinitionsCodeActionParameters& params) const
 {
@@ -0,0 +1,239 @@
+/**
+ * @file	gitignore.cpp
+ * @brief	Implements the GitIgnore.
+ */
+
+#include "gitignore.hpp"
+
+#include <sstream>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+//! Matches the text against the glob pattern, with the .gitignore semantics: '*' and '?' do not match '/', and '**'
+//! matches any number of directories.
+static bool matches_glob(std::string_view pattern, std::string_view text);
+
+//! Returns std::nullopt, when the pattern ends within the character class.
+static std::optional<bool> matches_character_class(std::string_view& pattern, char c);
+
+static std::string_view trim_trailing_spaces(std::string_view line);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::GitIgnore::GitIgnore(const std::string& content,
+                              std::filesystem::path gitignore_directory,
+                              std::shared_ptr<const GitIgnore> parent_gitignore) :
+    directory{std::move(gitignore_directory)}, parent{std::move(parent_gitignore)}
+{
+    std::istringstream iss{content};
+    std::string line_storage;
+    while (std::getline(iss, line_storage))
+    {
+        std::string_view line{line_storage};
+        if (line.ends_with('\r'))
+            line.remove_suffix(1);
+
+        line = trim_trailing_spaces(line);
+        if (line.empty() or line.front() == '#')
+            continue;
+
+        Rule rule{.is_negated = false, .is_directory_only = false, .is_anchored = false};
+        if (line.front() == '!')
+        {
+            rule.is_negated = true;
+            line.remove_prefix(1);
+        }
+
+        if (line.ends_with('/'))
+        {
+            rule.is_directory_only = true;
+            line.remove_suffix(1);
+        }
+
+        // A slash at the beginning or in the middle of the pattern makes it relative to the .gitignore location.
+        if (line.find('/') != std::string_view::npos)
+        {
+            rule.is_anchored = true;
+            if (line.starts_with('/'))
+                line.remove_prefix(1);
+        }
+
+        if (line.empty())
+            continue;
+
+        rule.pattern = line;
+        rules.emplace_back(std::move(rule));
+    }
+}
+
+bool Tsepepe::GitIgnore::is_ignored(const fs::path& path, bool is_directory) const
+{
+    for (auto git_ignore{this}; git_ignore != nullptr; git_ignore = git_ignore->parent.get())
+        if (auto result{git_ignore->match(path, is_directory)})
+            return *result;
+    return false;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+std::optional<bool> Tsepepe::GitIgnore::match(const fs::path& path, bool is_directory) const
+{
+    auto relative_path{path.lexically_relative(directory).generic_string()};
+    if (relative_path.empty() or relative_path == "." or relative_path.starts_with(".."))
+        return std::nullopt;
+
+    auto file_name{path.filename().string()};
+
+    // The last matching rule wins, so that the negated rules can re-include the files excluded by the former ones.
+    for (auto it{std::rbegin(rules)}; it != std::rend(rules); ++it)
+    {
+        const auto& rule{*it};
+        if (rule.is_directory_only and not is_directory)
+            continue;
+
+        if (matches_glob(rule.pattern, rule.is_anchored ? relative_path : file_name))
+            return not rule.is_negated;
+    }
+    return std::nullopt;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static bool matches_glob(std::string_view pattern, std::string_view text)
+{
+    while (not pattern.empty())
+    {
+        if (pattern.starts_with("**"))
+        {
+            auto rest{pattern.substr(2)};
+            if (rest.empty())
+                return true;
+
+            if (rest.front() == '/')
+            {
+                rest.remove_prefix(1);
+                for (std::size_t i{0}; i <= text.size(); ++i)
+                    if ((i == 0 or text[i - 1] == '/') and matches_glob(rest, text.substr(i)))
+                        return true;
+                return false;
+            }
+
+            // Other consecutive asterisks are regular asterisks.
+            pattern.remove_prefix(1);
+            continue;
+        }
+
+        switch (pattern.front())
+        {
+        case '*':
+            pattern.remove_prefix(1);
+            for (std::size_t i{0}; i <= text.size(); ++i)
+            {
+                if (matches_glob(pattern, text.substr(i)))
+                    return true;
+                if (i < text.size() and text[i] == '/')
+                    return false;
+            }
+            return false;
+
+        case '?':
+            if (text.empty() or text.front() == '/')
+                return false;
+            pattern.remove_prefix(1);
+            text.remove_prefix(1);
+            break;
+
+        case '[':
+        {
+            if (text.empty() or text.front() == '/')
+                return false;
+
+            auto class_pattern{pattern.substr(1)};
+            auto matches{matches_character_class(class_pattern, text.front())};
+            if (not matches)
+            {
+                // Unterminated class: the bracket is matched literally.
+                if (text.front() != '[')
+                    return false;
+                pattern.remove_prefix(1);
+                text.remove_prefix(1);
+                break;
+            }
+
+            if (not *matches)
+                return false;
+            pattern = class_pattern;
+            text.remove_prefix(1);
+            break;
+        }
+
+        case '\\':
+            if (pattern.size() > 1)
+                pattern.remove_prefix(1);
+            [[fallthrough]];
+
+        default:
+            if (text.empty() or text.front() != pattern.front())
+                return false;
+            pattern.remove_prefix(1);
+            text.remove_prefix(1);
+        }
+    }
+    return text.empty();
+}
+
+static std::optional<bool> matches_character_class(std::string_view& pattern, char c)
+{
+    bool is_negated{false};
+    if (not pattern.empty() and (pattern.front() == '!' or pattern.front() == '^'))
+    {
+        is_negated = true;
+        pattern.remove_prefix(1);
+    }
+
+    bool matches{false};
+    bool is_first{true};
+    while (not pattern.empty())
+    {
+        // A closing bracket directly after the opening one belongs to the class.
+        if (pattern.front() == ']' and not is_first)
+        {
+            pattern.remove_prefix(1);
+            return matches != is_negated;
+        }
+        is_first = false;
+
+        auto low{pattern.front()};
+        pattern.remove_prefix(1);
+        if (low == '\\' and not pattern.empty())
+        {
+            low = pattern.front();
+            pattern.remove_prefix(1);
+        }
+
+        auto high{low};
+        if (pattern.size() > 1 and pattern.front() == '-' and pattern[1] != ']')
+        {
+            high = pattern[1];
+            pattern.remove_prefix(2);
+        }
+
+        if (low <= c and c <= high)
+            matches = true;
+    }
+    return std::nullopt;
+}
+
+static std::string_view trim_trailing_spaces(std::string_view line)
+{
+    while (line.ends_with(' ') and not line.ends_with("\\ "))
+        line.remove_suffix(1);
+    return line;
+}
@@ -5,9 +5,15 @@
 
 #include "implement_interface_code_action.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
+#include <set>
 
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/ASTMatchers/ASTMatchers.h>
@@ -18,12 +24,16 @@
 #include "code_insertions_applier.hpp"
 #include "codebase_grepper.hpp"
 #include "common_types.hpp"
-#include "directory_tree.hpp"
 #include "include_statement_place_resolver.hpp"
-#include "temporary_file_maker.hpp"
+#include "parallel_search.hpp"
+#include "trace.hpp"
 
 #include "libclang_utils/ast_record.hpp"
 #include "libclang_utils/base_specifier_resolver.hpp"
+#include "libclang_utils/class_indexer.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+#include "libclang_utils/match_queries.hpp"
 #include "libclang_utils/presumed_source_range.hpp"
 #include "libclang_utils/pure_virtual_functions_extractor.hpp"
 #include "libclang_utils/suitable_place_in_class_finder.hpp"
@@ -57,13 +67,20 @@ namespace Tsepepe
 struct ImplementIntefaceCodeActionLibclangBasedImpl
 {
     explicit ImplementIntefaceCodeActionLibclangBasedImpl(std::shared_ptr<CompilationDatabase> comp_db,
+                                                          std::shared_ptr<AstUnitCache> cache,
+                                                          ClassIndex* index,
                                                           ImplementInterfaceCodeActionParameters params) :
         compilation_database{std::move(comp_db)},
-        tsepepe_temp_directory_tree{fs::temp_directory_path() / "tsepepe"},
-        this_code_action_directory_tree{fs::temp_directory_path() / "tsepepe" / "impl_iface_code_action"},
+        ast_unit_cache{std::move(cache)},
+        class_index{index},
         parameters{std::move(params)},
+        // The interface lookup is independent of the implementor, so they are run at the same time. The resolution
+        // of the include statement place needs the source file content only, so it's done while the interface is
+        // still looked for.
+        interface_future{std::async(std::launch::async, [this]() { return find_interface(); })},
         implementor{find_implementor()},
-        interface_{find_interface()}
+        include_statement_place{Tsepepe::resolve_include_statement_place(parameters.source_file_content)},
+        interface_{interface_future.get()}
     {
     }
 
@@ -83,17 +100,28 @@ struct ImplementIntefaceCodeActionLibclangBasedImpl
   private:
     ClangClassRecord find_implementor()
     {
-        auto full_path_to_temp_file{
-            make_temporary_source_file(parameters.source_file_path, "implementor", parameters.source_file_content)};
-
-        ClangTool tool{*compilation_database, {full_path_to_temp_file.string()}};
-        tool.buildASTs(ast_units);
+        auto source_file_path{get_in_memory_source_file_path(parameters.source_file_path, "implementor")};
+        // The overrides are inserted after the last public method of the implementor, which may be defined inline, so
+        // the function bodies are parsed.
+        std::shared_ptr<ASTUnit> ast_unit_ptr;
+        if (ast_unit_cache)
+            ast_unit_ptr = ast_unit_cache->get(*compilation_database,
+                                               source_file_path,
+                                               {{.path = source_file_path, .content = parameters.source_file_content}},
+                                               /* skip_function_bodies= */ false);
+        else
+            ast_unit_ptr =
+                build_ast_from_memory(*compilation_database, source_file_path, parameters.source_file_content);
+        {
+            std::lock_guard lock{ast_units_mutex};
+            ast_units.push_back(ast_unit_ptr);
+        }
 
-        auto& ast_unit{*ast_units.back()};
+        auto& ast_unit{*ast_unit_ptr};
         auto class_matcher{
-            ast_matchers::cxxRecordDecl(ast_matchers::hasDefinition(), isWithinFile(full_path_to_temp_file))
-                .bind("class")};
-        auto matches{ast_matchers::match(class_matcher, ast_unit.getASTContext())};
+            ast_matchers::cxxRecordDecl(ast_matchers::hasDefinition(), isWithinFile(source_file_path)).bind("class")};
+        auto matches{traced("ast_matchers::match",
+                            [&]() { return ast_matchers::match(class_matcher, ast_unit.getASTContext()); })};
 
         const auto& source_manager{ast_unit.getSourceManager()};
         const CXXRecordDecl* result{nullptr};
@@ -125,34 +153,154 @@ struct ImplementIntefaceCodeActionLibclangBasedImpl
 
     ClangClassRecord find_interface()
     {
+        std::set<fs::path> searched_files;
+
+        if (class_index != nullptr)
+        {
+            // The index entries might be outdated, but the files pointed by them are parsed anyway, so the actual
+            // state of the file is checked. When the interface is not found that way, then the entire project is
+            // searched. A class with bases might have become abstract without its file being changed.
+            std::vector<fs::path> indexed_candidates;
+            for (const auto& entry : class_index->find(parameters.inteface_name))
+                if ((entry.is_abstract or entry.has_bases) and searched_files.insert(entry.path).second)
+                    indexed_candidates.push_back(entry.path);
+
+            if (auto result{find_interface_within_files(indexed_candidates)})
+                return *result;
+        }
+
         const auto& iface_name{parameters.inteface_name};
         std::string class_definition_regex{"\\b(struct|class)\\s+" + iface_name + "\\b"};
         auto file_matches{
             codebase_grep(RootDirectory(parameters.root_directory), EcmaScriptPattern{class_definition_regex})};
 
-        auto abstract_class_matcher{
-            ast_matchers::cxxRecordDecl(isAbstract(), ast_matchers::hasName(iface_name)).bind("abstract class")};
-
+        std::vector<fs::path> candidates;
         for (const auto& file_match : file_matches)
         {
-            build_and_append_ast_unit(file_match.path);
-            auto& ast_unit{*ast_units.back()};
-            auto match_result{ast_matchers::match(abstract_class_matcher, ast_unit.getASTContext())};
-            if (match_result.size() == 0)
-                continue;
-
-            const auto& first_match{match_result[0]};
-            return {.node = first_match.getNodeAs<CXXRecordDecl>("abstract class"),
-                    .source_manager = &ast_unit.getSourceManager()};
+            auto path{fs::absolute(file_match.path).lexically_normal()};
+            if (searched_files.insert(path).second)
+                candidates.push_back(std::move(path));
         }
 
+        if (auto result{find_interface_within_files(candidates)})
+            return *result;
+
         throw BaseError{"No interface with the specified name found under the project root directory!"};
     }
 
-    void build_and_append_ast_unit(const std::filesystem::path& path)
+    //! The files are parsed in parallel. The interface found within the file, which comes first, is taken, the same
+    //! as if the files were parsed one by one. A file, which fails to be parsed, is skipped; the failure is rethrown
+    //! only when the interface isn't found within any other file.
+    std::optional<ClangClassRecord> find_interface_within_files(const std::vector<fs::path>& paths)
+    {
+        std::optional<ClangClassRecord> result;
+        std::exception_ptr exception;
+        try
+        {
+            result = find_first_in_parallel(
+                paths, [this](const fs::path& path) { return find_interface_within_file(path); });
+        } catch (...)
+        {
+            // The files parsed successfully are indexed anyway.
+            exception = std::current_exception();
+        }
+
+        if (class_index != nullptr)
+        {
+            for (auto& parsed_file : parsed_files)
+                index_main_file(
+                    *class_index, parsed_file.path, parsed_file.stamp, std::move(parsed_file.class_definitions));
+            save_class_index();
+        }
+        parsed_files.clear();
+
+        if (exception)
+            std::rethrow_exception(exception);
+        return result;
+    }
+
+    //! Called from multiple threads at once. When the file is to be indexed, the class definitions are collected
+    //! within the same traversal of the AST, as the one looking for the interface.
+    std::optional<ClangClassRecord> find_interface_within_file(const fs::path& path)
+    {
+        std::optional<FileStamp> stamp;
+        if (class_index != nullptr and not class_index->is_up_to_date(path))
+            stamp = get_file_stamp(path);
+
+        auto& ast_unit{get_ast_unit(path)};
+
+        MatchQueries queries;
+        auto abstract_classes{queries.add(
+            ast_matchers::cxxRecordDecl(isAbstract(), ast_matchers::hasName(parameters.inteface_name))
+                .bind("abstract class"))};
+        std::optional<MatchQueries::QueryId> class_definitions;
+        if (stamp)
+            class_definitions = queries.add(get_class_definition_matcher());
+        queries.run(ast_unit.getASTContext());
+
+        if (class_definitions)
+        {
+            auto entries{
+                to_class_index_entries(queries.get_matches(*class_definitions), ast_unit.getSourceManager())};
+            std::lock_guard lock{ast_units_mutex};
+            parsed_files.emplace_back(
+                ParsedFile{.path = path, .stamp = *stamp, .class_definitions = std::move(entries)});
+        }
+
+        const auto& match_result{queries.get_matches(abstract_classes)};
+        if (match_result.empty())
+            return std::nullopt;
+
+        const auto& first_match{match_result[0]};
+        return ClangClassRecord{.node = first_match.getNodeAs<CXXRecordDecl>("abstract class"),
+                                .source_manager = &ast_unit.getSourceManager()};
+    }
+
+    void save_class_index() const
+    {
+        if (class_index == nullptr or not class_index->is_modified())
+            return;
+
+        // The index only speeds up the lookup, so failing to store it, e.g. because of a read-only project
+        // directory, shall not fail the code action.
+        try
+        {
+            // The stored index might have been updated in the meantime, e.g. by tsepepe_class_indexer.
+            if (auto stored_class_index{ClassIndex::load(class_index->get_project_root())})
+                class_index->merge(*stored_class_index);
+            class_index->save();
+        } catch (const std::exception&)
+        {
+        }
+    }
+
+    //! Called from multiple threads at once.
+    ASTUnit& get_ast_unit(const std::filesystem::path& path)
     {
-        ClangTool tool{*compilation_database, {path.string()}};
-        tool.buildASTs(ast_units);
+        std::shared_ptr<ASTUnit> ast_unit;
+        if (ast_unit_cache)
+        {
+            ast_unit = ast_unit_cache->get(*compilation_database, path);
+        } else
+        {
+            std::vector<std::unique_ptr<ASTUnit>> built_ast_units;
+            ClangTool tool{*compilation_database,
+                           {path.string()},
+                           std::make_shared<PCHContainerOperations>(),
+                           make_parsing_file_system()};
+            tool.appendArgumentsAdjuster(get_fast_parsing_arguments_adjuster());
+            {
+                TraceSpan span{"ClangTool::buildASTs", path.string()};
+                tool.buildASTs(built_ast_units);
+            }
+            if (built_ast_units.empty())
+                throw BaseError{"Failed to parse file: " + path.string()};
+            ast_unit = std::move(built_ast_units.back());
+        }
+
+        std::lock_guard lock{ast_units_mutex};
+        ast_units.push_back(ast_unit);
+        return *ast_unit;
     }
 
     CodeInsertionByOffset get_include_statement_code_insertion() const
@@ -161,8 +309,6 @@ struct ImplementIntefaceCodeActionLibclangBasedImpl
         if (is_include_already_in_place(interface_header_path))
             return {};
 
-        auto include_statement_place{Tsepepe::resolve_include_statement_place(parameters.source_file_content)};
-
         std::string code{include_statement_place.is_newline_needed ? "\n" : ""};
         code += "#include \"" + fs::path(interface_header_path).filename().string() + "\"\n";
         return {.code = std::move(code), .offset = include_statement_place.offset};
@@ -198,14 +344,30 @@ struct ImplementIntefaceCodeActionLibclangBasedImpl
     }
 
     std::shared_ptr<CompilationDatabase> compilation_database;
-    std::vector<std::unique_ptr<clang::ASTUnit>> ast_units;
+    std::shared_ptr<AstUnitCache> ast_unit_cache;
+    ClassIndex* class_index;
+
+    std::mutex ast_units_mutex;
+    //! Keeps the ASTs alive, until the code action is applied. The implementor and the interface are looked for at
+    //! the same time, so the vector is only appended to with the mutex locked, and is never read: each lookup uses its
+    //! own pointer to the AST, since an append from the other thread may reallocate the vector.
+    std::vector<std::shared_ptr<clang::ASTUnit>> ast_units;
+    struct ParsedFile
+    {
+        fs::path path;
+        FileStamp stamp;
+        std::vector<ClassIndexEntry> class_definitions;
+    };
 
-    DirectoryTree tsepepe_temp_directory_tree;
-    DirectoryTree this_code_action_directory_tree;
+    //! The class definitions found within the files parsed while looking for the interface, which are yet to be
+    //! indexed.
+    std::vector<ParsedFile> parsed_files;
 
     ImplementInterfaceCodeActionParameters parameters;
 
+    std::future<ClangClassRecord> interface_future;
     ClangClassRecord implementor;
+    IncludeStatementPlace include_statement_place;
     ClangClassRecord interface_;
 };
 } // namespace Tsepepe
@@ -214,17 +376,55 @@ struct ImplementIntefaceCodeActionLibclangBasedImpl
 // Public stuff
 // --------------------------------------------------------------------------------------------------------------------
 Tsepepe::ImplementIntefaceCodeActionLibclangBased::ImplementIntefaceCodeActionLibclangBased(
-    std::shared_ptr<clang::tooling::CompilationDatabase> comp_db) :
-    compilation_database(std::move(comp_db))
+    std::shared_ptr<clang::tooling::CompilationDatabase> comp_db, std::shared_ptr<AstUnitCache> cache) :
+    compilation_database(std::move(comp_db)), ast_unit_cache(std::move(cache))
 {
 }
 
 Tsepepe::NewFileContent
 Tsepepe::ImplementIntefaceCodeActionLibclangBased::apply(ImplementInterfaceCodeActionParameters params)
 {
-    return ImplementIntefaceCodeActionLibclangBasedImpl{compilation_database, std::move(params)}.apply();
+    auto class_index{get_class_index(params.root_directory)};
+    return ImplementIntefaceCodeActionLibclangBasedImpl{
+        compilation_database, ast_unit_cache, class_index, std::move(params)}
+        .apply();
+}
+
+void Tsepepe::ImplementIntefaceCodeActionLibclangBased::update_class_index(const std::filesystem::path& project_root,
+                                                                           const FileChanges& changes)
+{
+    auto it{class_indexes.find(fs::absolute(project_root).lexically_normal())};
+    if (it == std::end(class_indexes))
+        return;
+
+    auto& class_index{it->second};
+    auto is_removed{[&](const fs::path& path) {
+        if (changes.files.contains(path) and not fs::exists(path))
+            return true;
+        return std::ranges::any_of(changes.removed_directories, [&](const fs::path& directory) {
+            auto [directory_end, _] = std::mismatch(
+                std::begin(directory), std::end(directory), std::begin(path), std::end(path));
+            return directory_end == std::end(directory);
+        });
+    }};
+
+    for (const auto& path : class_index.get_indexed_files())
+        if (is_removed(path))
+            class_index.remove_file(path);
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 // Private implementations
 // --------------------------------------------------------------------------------------------------------------------
+Tsepepe::ClassIndex*
+Tsepepe::ImplementIntefaceCodeActionLibclangBased::get_class_index(const std::filesystem::path& project_root)
+{
+    auto key{fs::absolute(project_root).lexically_normal()};
+    if (auto it{class_indexes.find(key)}; it != std::end(class_indexes))
+        return &it->second;
+
+    auto class_index{ClassIndex::load(key)};
+    if (not class_index)
+        return nullptr;
+    return &class_indexes.emplace(std::move(key), std::move(*class_index)).first->second;
+}
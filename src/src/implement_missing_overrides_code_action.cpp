@@ -0,0 +1,345 @@
+/**
+ * @file	implement_missing_overrides_code_action.cpp
+ * @brief	Implements the Implement Missing Overrides code action.
+ */
+
+#include "implement_missing_overrides_code_action.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+
+#include <clang/AST/CXXInheritance.h>
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Lex/Lexer.h>
+
+#include "base_error.hpp"
+#include "codebase_grepper.hpp"
+#include "parallel_search.hpp"
+#include "trace.hpp"
+
+#include "libclang_utils/ast_record.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+#include "libclang_utils/pure_virtual_functions_extractor.hpp"
+#include "libclang_utils/suitable_place_in_class_finder.hpp"
+
+using namespace Tsepepe;
+using namespace clang;
+using namespace clang::tooling;
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private declarations and definitions
+// --------------------------------------------------------------------------------------------------------------------
+AST_MATCHER(CXXRecordDecl, isAbstract)
+{
+    return Node.hasDefinition() and Node.isAbstract();
+};
+
+namespace
+{
+
+class ImplementMissingOverridesCodeActionImpl
+{
+  public:
+    ImplementMissingOverridesCodeActionImpl(std::shared_ptr<CompilationDatabase>,
+                                            std::shared_ptr<AstUnitCache>,
+                                            unsigned max_workers_count,
+                                            ImplementMissingOverridesCodeActionParameters);
+
+    std::vector<FileCodeInsertions> apply();
+
+  private:
+    struct InterfaceRecord
+    {
+        //! Keeps the record alive.
+        std::shared_ptr<ASTUnit> ast_unit;
+        ClangClassRecord record;
+    };
+
+    InterfaceRecord find_interface() const;
+    std::optional<InterfaceRecord> find_interface_within_file(const fs::path&) const;
+    std::vector<fs::path> find_implementor_candidates() const;
+
+    //! Called from multiple threads at once.
+    FileCodeInsertions implement_missing_overrides_within_file(const fs::path&);
+
+    //! Returns std::nullopt, when the implementor doesn't miss any override of the interface functions.
+    std::optional<CodeInsertionByOffset> get_missing_overrides_insertion(const std::string& file_content,
+                                                                         const ClangClassRecord& implementor);
+
+    //! Called from multiple threads at once. The function bodies shall be parsed, when the source ranges of
+    //! the definitions are used, see: get_fast_parsing_arguments_adjuster().
+    std::shared_ptr<ASTUnit> get_ast_unit(const fs::path&, bool skip_function_bodies) const;
+
+    std::shared_ptr<CompilationDatabase> compilation_database;
+    std::shared_ptr<AstUnitCache> ast_unit_cache;
+    const unsigned max_workers_count;
+    ImplementMissingOverridesCodeActionParameters parameters;
+
+    //! The interface AST is shared by the implementors, which are processed in parallel, but the AST can't be
+    //! accessed from multiple threads at once.
+    std::mutex interface_mutex;
+    InterfaceRecord interface_;
+    //! Taken upfront, so that the implementors may be matched without locking the interface AST.
+    std::string interface_fully_qualified_name;
+};
+
+} // namespace
+
+//! Identifies the virtual function across the ASTs built from different files, which include the same header.
+static std::string get_virtual_function_key(const CXXMethodDecl*);
+
+static bool has_pure_virtual_functions_declared(const CXXRecordDecl*);
+
+//! Tells whether the class derives from another implementor of the interface, which gets the missing overrides instead.
+static bool is_derived_from_implementor(const CXXRecordDecl*, const std::string& interface_fully_qualified_name);
+
+//! Walks the bases recursively, the incomplete ones are skipped.
+static bool is_any_base_matching(const CXXRecordDecl*, const std::function<bool(const CXXRecordDecl*)>& predicate);
+
+//! Returns the keys of the pure virtual functions, which are not overridden by the class, or any of its bases.
+static std::set<std::string> find_pure_final_overriders(const CXXRecordDecl*);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::ImplementMissingOverridesCodeActionLibclangBased::ImplementMissingOverridesCodeActionLibclangBased(
+    std::shared_ptr<clang::tooling::CompilationDatabase> comp_db,
+    std::shared_ptr<AstUnitCache> cache,
+    unsigned max_workers_count_) :
+    compilation_database{std::move(comp_db)}, ast_unit_cache{std::move(cache)}, max_workers_count{max_workers_count_}
+{
+}
+
+std::vector<FileCodeInsertions>
+Tsepepe::ImplementMissingOverridesCodeActionLibclangBased::apply(ImplementMissingOverridesCodeActionParameters params)
+{
+    return ImplementMissingOverridesCodeActionImpl{
+        compilation_database, ast_unit_cache, max_workers_count, std::move(params)}
+        .apply();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+ImplementMissingOverridesCodeActionImpl::ImplementMissingOverridesCodeActionImpl(
+    std::shared_ptr<CompilationDatabase> comp_db,
+    std::shared_ptr<AstUnitCache> cache,
+    unsigned max_workers_count_,
+    ImplementMissingOverridesCodeActionParameters params) :
+    compilation_database{std::move(comp_db)},
+    ast_unit_cache{std::move(cache)},
+    max_workers_count{max_workers_count_},
+    parameters{std::move(params)},
+    interface_{find_interface()},
+    interface_fully_qualified_name{interface_.record.node->getQualifiedNameAsString()}
+{
+}
+
+std::vector<FileCodeInsertions> ImplementMissingOverridesCodeActionImpl::apply()
+{
+    auto results{transform_in_parallel(
+        find_implementor_candidates(),
+        [this](const fs::path& path) { return implement_missing_overrides_within_file(path); },
+        max_workers_count)};
+
+    auto [new_results_end_it, results_end_it] = std::ranges::remove_if(
+        results, [](const FileCodeInsertions& result) { return result.insertions.empty(); });
+    results.erase(new_results_end_it, results_end_it);
+    return results;
+}
+
+ImplementMissingOverridesCodeActionImpl::InterfaceRecord ImplementMissingOverridesCodeActionImpl::find_interface() const
+{
+    std::string class_definition_regex{"\\b(struct|class)\\s+" + parameters.interface_name + "\\b"};
+    auto file_matches{
+        codebase_grep(RootDirectory(parameters.root_directory), EcmaScriptPattern{class_definition_regex})};
+
+    std::vector<fs::path> candidates;
+    for (const auto& file_match : file_matches)
+    {
+        auto path{fs::absolute(file_match.path).lexically_normal()};
+        if (std::ranges::find(candidates, path) == std::end(candidates))
+            candidates.push_back(std::move(path));
+    }
+
+    auto result{find_first_in_parallel(
+        candidates, [this](const fs::path& path) { return find_interface_within_file(path); }, max_workers_count)};
+    if (not result)
+        throw BaseError{"No interface with the specified name found under the project root directory!"};
+    return std::move(*result);
+}
+
+std::optional<ImplementMissingOverridesCodeActionImpl::InterfaceRecord>
+ImplementMissingOverridesCodeActionImpl::find_interface_within_file(const fs::path& path) const
+{
+    auto abstract_class_matcher{
+        ast_matchers::cxxRecordDecl(isAbstract(), ast_matchers::hasName(parameters.interface_name))
+            .bind("abstract class")};
+
+    auto ast_unit{get_ast_unit(path, /* skip_function_bodies= */ true)};
+    auto match_result{traced("ast_matchers::match", [&]() {
+        return ast_matchers::match(abstract_class_matcher, ast_unit->getASTContext());
+    })};
+    if (match_result.empty())
+        return std::nullopt;
+
+    ClangClassRecord record{.node = match_result.front().getNodeAs<CXXRecordDecl>("abstract class"),
+                            .source_manager = &ast_unit->getSourceManager()};
+    return InterfaceRecord{.ast_unit = std::move(ast_unit), .record = record};
+}
+
+std::vector<fs::path> ImplementMissingOverridesCodeActionImpl::find_implementor_candidates() const
+{
+    auto file_matches{codebase_grep(RootDirectory(parameters.root_directory),
+                                    EcmaScriptPattern{"\\b" + parameters.interface_name + "\\b"})};
+
+    // The matches are sorted, so the matches within the same file are next to each other.
+    std::vector<fs::path> result;
+    for (const auto& file_match : file_matches)
+    {
+        auto path{fs::absolute(file_match.path).lexically_normal()};
+        if (result.empty() or result.back() != path)
+            result.push_back(std::move(path));
+    }
+    return result;
+}
+
+FileCodeInsertions
+ImplementMissingOverridesCodeActionImpl::implement_missing_overrides_within_file(const fs::path& path)
+{
+    // The overrides are inserted after the last public method, which may be defined inline, so the bodies are parsed.
+    // Thus, the file with the interface gets an AST of its own, as well.
+    auto ast_unit{get_ast_unit(path, /* skip_function_bodies= */ false)};
+    auto implementor_matcher{
+        ast_matchers::cxxRecordDecl(ast_matchers::hasDefinition(),
+                                    ast_matchers::isExpansionInMainFile(),
+                                    ast_matchers::unless(ast_matchers::isTemplateInstantiation()),
+                                    ast_matchers::isDerivedFrom("::" + interface_fully_qualified_name))
+            .bind("implementor")};
+    auto matches{traced("ast_matchers::match",
+                        [&]() { return ast_matchers::match(implementor_matcher, ast_unit->getASTContext()); })};
+
+    FileCodeInsertions result{.path = path};
+    if (matches.empty())
+        return result;
+
+    const auto& source_manager{ast_unit->getSourceManager()};
+    auto file_content{source_manager.getBufferData(source_manager.getMainFileID()).str()};
+    for (const auto& match : matches)
+    {
+        auto node{match.getNodeAs<CXXRecordDecl>("implementor")};
+        if (node == nullptr or has_pure_virtual_functions_declared(node)
+            or is_derived_from_implementor(node, interface_fully_qualified_name))
+            continue;
+
+        ClangClassRecord implementor{.node = node, .source_manager = &source_manager};
+        if (auto insertion{get_missing_overrides_insertion(file_content, implementor)})
+            result.insertions.push_back(std::move(*insertion));
+    }
+    return result;
+}
+
+std::optional<CodeInsertionByOffset>
+ImplementMissingOverridesCodeActionImpl::get_missing_overrides_insertion(const std::string& file_content,
+                                                                         const ClangClassRecord& implementor)
+{
+    auto missing_overrides{find_pure_final_overriders(implementor.node)};
+    if (missing_overrides.empty())
+        return std::nullopt;
+
+    OverrideDeclarations method_overrides;
+    {
+        std::lock_guard lock{interface_mutex};
+
+        method_overrides = Tsepepe::pure_virtual_functions_to_override_declarations(
+            interface_.record.node,
+            implementor.node->getQualifiedNameAsString(),
+            *interface_.record.source_manager,
+            [&](const CXXMethodDecl* method) { return missing_overrides.contains(get_virtual_function_key(method)); });
+    }
+    if (method_overrides.empty())
+        return std::nullopt;
+
+    auto indentation{
+        (Lexer::getIndentationForLine(implementor.node->getLocation(), *implementor.source_manager) + "    ").str()};
+    auto method_overrides_place{Tsepepe::find_suitable_place_in_class_for_public_method(
+        file_content, implementor.node, *implementor.source_manager)};
+
+    std::string code{method_overrides_place.is_public_section_needed ? "public:\n" : ""};
+    for (auto& override_ : method_overrides)
+    {
+        code += indentation;
+        code += std::move(override_);
+        code += '\n';
+    }
+    return CodeInsertionByOffset{.code = std::move(code), .offset = method_overrides_place.offset};
+}
+
+std::shared_ptr<ASTUnit> ImplementMissingOverridesCodeActionImpl::get_ast_unit(const fs::path& path,
+                                                                          bool skip_function_bodies) const
+{
+    if (ast_unit_cache)
+        return ast_unit_cache->get(*compilation_database, path, skip_function_bodies);
+    return build_ast_with_unsaved_files(
+        *compilation_database, path, {}, {.skip_function_bodies = skip_function_bodies});
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static std::string get_virtual_function_key(const CXXMethodDecl* method)
+{
+    return method->getQualifiedNameAsString() + ' ' + method->getType().getCanonicalType().getAsString();
+}
+
+static bool has_pure_virtual_functions_declared(const CXXRecordDecl* node)
+{
+    return std::any_of(
+        node->method_begin(), node->method_end(), [](const CXXMethodDecl* method) { return method->isPure(); });
+}
+
+static bool is_derived_from_implementor(const CXXRecordDecl* node, const std::string& interface_fully_qualified_name)
+{
+    auto is_interface{[&](const CXXRecordDecl* record) {
+        return record->getQualifiedNameAsString() == interface_fully_qualified_name;
+    }};
+    auto is_implementor{[&](const CXXRecordDecl* record) {
+        return not is_interface(record) and not has_pure_virtual_functions_declared(record)
+               and is_any_base_matching(record, is_interface);
+    }};
+    return is_any_base_matching(node, is_implementor);
+}
+
+static bool is_any_base_matching(const CXXRecordDecl* node, const std::function<bool(const CXXRecordDecl*)>& predicate)
+{
+    for (const auto& base : node->bases())
+    {
+        auto base_node{base.getType()->getAsCXXRecordDecl()};
+        if (base_node == nullptr or not base_node->hasDefinition())
+            continue;
+        base_node = base_node->getDefinition();
+        if (predicate(base_node) or is_any_base_matching(base_node, predicate))
+            return true;
+    }
+    return false;
+}
+
+static std::set<std::string> find_pure_final_overriders(const CXXRecordDecl* node)
+{
+    CXXFinalOverriderMap final_overriders;
+    node->getFinalOverriders(final_overriders);
+
+    std::set<std::string> result;
+    for (const auto& [method, overriding_methods] : final_overriders)
+        for (const auto& [subobject, overriders] : overriding_methods)
+            for (const auto& overrider : overriders)
+                if (overrider.Method->isPure())
+                    result.insert(get_virtual_function_key(overrider.Method));
+    return result;
+}
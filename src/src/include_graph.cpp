@@ -0,0 +1,72 @@
+/**
+ * @file	include_graph.cpp
+ * @brief	Implements the IncludeGraph.
+ */
+
+#include "include_graph.hpp"
+
+#include <filesystem>
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+void Tsepepe::IncludeGraph::set_included_files(const std::string& translation_unit,
+                                               const std::vector<std::string>& included_files)
+{
+    remove_translation_unit(translation_unit);
+
+    for (const auto& file : included_files)
+        translation_units_by_file[file].insert(translation_unit);
+    included_files_by_translation_unit.emplace(translation_unit, included_files);
+}
+
+void Tsepepe::IncludeGraph::remove_translation_unit(const std::string& translation_unit)
+{
+    auto it{included_files_by_translation_unit.find(translation_unit)};
+    if (it == std::end(included_files_by_translation_unit))
+        return;
+
+    for (const auto& file : it->second)
+    {
+        auto file_it{translation_units_by_file.find(file)};
+        if (file_it == std::end(translation_units_by_file))
+            continue;
+
+        file_it->second.erase(translation_unit);
+        if (file_it->second.empty())
+            translation_units_by_file.erase(file_it);
+    }
+    included_files_by_translation_unit.erase(it);
+}
+
+std::set<std::string> Tsepepe::IncludeGraph::get_dependent_translation_units(const std::string& path) const
+{
+    std::set<std::string> result;
+    if (auto it{translation_units_by_file.find(path)}; it != std::end(translation_units_by_file))
+        result = it->second;
+
+    // The files within the directory are the ones prefixed with the directory path and the separator.
+    auto directory_prefix{path};
+    if (not directory_prefix.ends_with(std::filesystem::path::preferred_separator))
+        directory_prefix += std::filesystem::path::preferred_separator;
+    for (auto it{translation_units_by_file.lower_bound(directory_prefix)};
+         it != std::end(translation_units_by_file) and it->first.starts_with(directory_prefix);
+         ++it)
+        result.insert(std::begin(it->second), std::end(it->second));
+
+    return result;
+}
+
+std::vector<std::string> Tsepepe::IncludeGraph::get_included_files(const std::string& translation_unit) const
+{
+    auto it{included_files_by_translation_unit.find(translation_unit)};
+    if (it == std::end(included_files_by_translation_unit))
+        return {};
+    return it->second;
+}
+
+void Tsepepe::IncludeGraph::clear()
+{
+    included_files_by_translation_unit.clear();
+    translation_units_by_file.clear();
+}
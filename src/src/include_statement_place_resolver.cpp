@@ -5,55 +5,83 @@
 
 #include "include_statement_place_resolver.hpp"
 
+#include <algorithm>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
 
 using namespace Tsepepe;
 
 // --------------------------------------------------------------------------------------------------------------------
 // Helper declaration
 // --------------------------------------------------------------------------------------------------------------------
-static std::optional<unsigned> find_last_local_include_statement_end_offset(const std::string& cpp_file_content);
-static std::optional<unsigned> find_last_global_include_statement_end_offset(const std::string& cpp_file_content);
+namespace
+{
 
-/** @brief Finds the include guard heading end offset.
- *  @returns  The offset of the beginning of the line just below the include guard heading.
- *
- *      #ifndef SOME_HEADER_HPP
- *      #define SOME_HEADER_HPP
- *      // <--- the function returns this file offset (the offset just below the heading of the include guard)
- *      // ...
+//! The places, where the include statement may be put, found within a single pass over the file content. Each offset
+//! is the offset of the beginning of the line just below the statement.
+struct IncludeStatementPlaceCandidates
+{
+    std::optional<IncludeStatementPlace> last_local_include_end;
+    std::optional<IncludeStatementPlace> last_global_include_end;
+
+    /** @brief The include guard heading end.
+     *
+     *      #ifndef SOME_HEADER_HPP
+     *      #define SOME_HEADER_HPP
+     *      // <--- this file offset (the offset just below the heading of the include guard)
+     *      // ...
+     *
+     *      #endif / * SOME_HEADER_HPP * /
+     */
+    std::optional<IncludeStatementPlace> include_guard_heading_end;
+    std::optional<IncludeStatementPlace> pragma_once_end;
+    std::optional<IncludeStatementPlace> header_comment_end;
+};
+
+//! A preprocessor directive, e.g. "# include <string>" is split into the name: "include", and the arguments:
+//! "<string>".
+struct Directive
+{
+    std::string_view name;
+    std::string_view arguments;
+};
+
+} // namespace
+
+/** @brief Walks the file content once, line by line, and finds all the candidates.
  *
- *      #endif / * SOME_HEADER_HPP * /
+ * The directives within the block comments are skipped. The header comment is the block comment at the very
+ * beginning of the file, preceded by whitespaces only.
  */
-static std::optional<unsigned> find_include_guard_heading_end_offset(const std::string& cpp_file_content);
-static std::optional<unsigned> find_pragma_once_end_offset(const std::string& cpp_file_content);
-static std::optional<unsigned> find_header_comment_end_offset(const std::string& cpp_file_content);
+static IncludeStatementPlaceCandidates find_include_statement_place_candidates(std::string_view cpp_file_content);
+
+static std::optional<IncludeStatementPlace> find_header_comment_end(std::string_view cpp_file_content);
+
+//! Returns the directive, when the line, without the leading block comment, if there is any, is a directive.
+static std::optional<Directive> parse_directive(std::string_view line);
+
+//! Tells whether the line, without the leading block comment, if there is any, ends within an unterminated block
+//! comment.
+static bool is_block_comment_left_open(std::string_view line);
+
+static std::string_view trim_front(std::string_view);
+static std::string_view take_identifier(std::string_view);
 
 // --------------------------------------------------------------------------------------------------------------------
 // Public stuff
 // --------------------------------------------------------------------------------------------------------------------
 Tsepepe::IncludeStatementPlace Tsepepe::resolve_include_statement_place(const std::string& cpp_file_content)
 {
-    if (auto maybe_last_local_include_end_offset{find_last_local_include_statement_end_offset(cpp_file_content)};
-        maybe_last_local_include_end_offset)
-        return {.offset = *maybe_last_local_include_end_offset};
-
-    if (auto maybe_last_global_include_end_offset{find_last_global_include_statement_end_offset(cpp_file_content)};
-        maybe_last_global_include_end_offset)
-        return {.offset = *maybe_last_global_include_end_offset, .is_newline_needed = true};
-
-    if (auto maybe_include_guard_heading_end_offset{find_include_guard_heading_end_offset(cpp_file_content)};
-        maybe_include_guard_heading_end_offset)
-        return {.offset = *maybe_include_guard_heading_end_offset, .is_newline_needed = true};
-
-    if (auto maybe_pragma_once_end_offset{find_pragma_once_end_offset(cpp_file_content)}; maybe_pragma_once_end_offset)
-        return {.offset = *maybe_pragma_once_end_offset, .is_newline_needed = true};
+    auto candidates{find_include_statement_place_candidates(cpp_file_content)};
 
-    if (auto maybe_header_comment_end_offset{find_header_comment_end_offset(cpp_file_content)};
-        maybe_header_comment_end_offset)
-        return {.offset = *maybe_header_comment_end_offset, .is_newline_needed = true};
+    for (const auto& candidate : {candidates.last_local_include_end,
+                                  candidates.last_global_include_end,
+                                  candidates.include_guard_heading_end,
+                                  candidates.pragma_once_end,
+                                  candidates.header_comment_end})
+        if (candidate)
+            return *candidate;
 
     // When no '#include' statement found, nor the comment header, or include guard, then the place is at the top of the
     // file.
@@ -63,71 +91,145 @@ Tsepepe::IncludeStatementPlace Tsepepe::resolve_include_statement_place(const st
 // --------------------------------------------------------------------------------------------------------------------
 // Helper definition
 // --------------------------------------------------------------------------------------------------------------------
-static std::optional<unsigned> find_last_local_include_statement_end_offset(const std::string& cpp_file_content)
+static IncludeStatementPlaceCandidates find_include_statement_place_candidates(std::string_view cpp_file_content)
 {
-    // FIXME: apply DRY "find_last_match()"
-    std::regex re{"\n?[ \t\f\v]*\".*\"\\s+edulcni#"};
-
-    auto beg{std::rbegin(cpp_file_content)};
-    auto end{std::rend(cpp_file_content)};
-    std::match_results<decltype(beg)> match;
-    if (not std::regex_search(beg, end, match, re))
-        return {};
-    return std::distance(std::begin(cpp_file_content), match[0].first.base());
+    IncludeStatementPlaceCandidates result{.header_comment_end = find_header_comment_end(cpp_file_content)};
+
+    bool is_within_block_comment{false};
+    bool is_previous_line_ifndef{false};
+
+    std::size_t line_begin{0};
+    while (line_begin < cpp_file_content.size())
+    {
+        auto line_end{std::min(cpp_file_content.find('\n', line_begin), cpp_file_content.size())};
+        auto is_last_line{line_end == cpp_file_content.size()};
+        auto next_line_begin{is_last_line ? line_end : line_end + 1};
+        auto line{cpp_file_content.substr(line_begin, line_end - line_begin)};
+
+        if (is_within_block_comment)
+        {
+            auto comment_end{line.find("*/")};
+            line = comment_end == std::string_view::npos ? std::string_view{} : line.substr(comment_end + 2);
+            is_within_block_comment = comment_end == std::string_view::npos;
+        }
+
+        auto directive{is_within_block_comment ? std::nullopt : parse_directive(line)};
+        auto is_ifndef{false};
+        if (directive)
+        {
+            // The include statement is put below the line. When the line is the last one, and it doesn't end with a
+            // newline, the newline has to be added before the include statement.
+            IncludeStatementPlace place_below{.offset = static_cast<unsigned>(next_line_begin),
+                                              .is_newline_needed = is_last_line};
+            auto arguments{directive->arguments};
+
+            if (directive->name == "include" and arguments.starts_with('"')
+                and arguments.find('"', 1) != std::string_view::npos)
+                result.last_local_include_end = place_below;
+            else if (directive->name == "include" and arguments.starts_with('<')
+                     and arguments.find('>', 1) != std::string_view::npos)
+                result.last_global_include_end = IncludeStatementPlace{.offset = place_below.offset,
+                                                                       .is_newline_needed = true};
+            else if (directive->name == "ifndef" and not take_identifier(arguments).empty())
+                is_ifndef = true;
+            else if (directive->name == "define" and is_previous_line_ifndef and not result.include_guard_heading_end)
+                result.include_guard_heading_end = IncludeStatementPlace{.offset = place_below.offset,
+                                                                         .is_newline_needed = true};
+            else if (directive->name == "pragma" and take_identifier(arguments) == "once"
+                     and not result.pragma_once_end)
+                result.pragma_once_end = IncludeStatementPlace{.offset = place_below.offset, .is_newline_needed = true};
+        }
+        is_previous_line_ifndef = is_ifndef;
+
+        if (not is_within_block_comment)
+            is_within_block_comment = is_block_comment_left_open(line);
+
+        line_begin = next_line_begin;
+    }
+
+    return result;
+}
+
+static std::optional<IncludeStatementPlace> find_header_comment_end(std::string_view cpp_file_content)
+{
+    auto content{trim_front(cpp_file_content)};
+    if (not content.starts_with("/*"))
+        return std::nullopt;
+
+    auto comment_end{content.find("*/", 2)};
+    if (comment_end == std::string_view::npos)
+        return std::nullopt;
+
+    auto offset{cpp_file_content.size() - content.size() + comment_end + 2};
+    while (offset < cpp_file_content.size() and (cpp_file_content[offset] == ' ' or cpp_file_content[offset] == '\t'))
+        ++offset;
+    if (offset < cpp_file_content.size() and cpp_file_content[offset] == '\n')
+        ++offset;
+
+    return IncludeStatementPlace{.offset = static_cast<unsigned>(offset), .is_newline_needed = true};
 }
 
-static std::optional<unsigned> find_last_global_include_statement_end_offset(const std::string& cpp_file_content)
+static std::optional<Directive> parse_directive(std::string_view line)
 {
-    // FIXME: apply DRY "find_last_match()"
-    std::regex re{"\n?[ \t\f\v]*>.*<\\s+edulcni#"};
-
-    auto beg{std::rbegin(cpp_file_content)};
-    auto end{std::rend(cpp_file_content)};
-    std::match_results<decltype(beg)> match;
-    if (not std::regex_search(beg, end, match, re))
-        return {};
-    return std::distance(std::begin(cpp_file_content), match[0].first.base());
+    line = trim_front(line);
+    // The block comments may precede the directive.
+    while (line.starts_with("/*"))
+    {
+        auto comment_end{line.find("*/", 2)};
+        if (comment_end == std::string_view::npos)
+            return std::nullopt;
+        line = trim_front(line.substr(comment_end + 2));
+    }
+
+    if (not line.starts_with('#'))
+        return std::nullopt;
+
+    line = trim_front(line.substr(1));
+    auto name{take_identifier(line)};
+    if (name.empty())
+        return std::nullopt;
+    return Directive{.name = name, .arguments = trim_front(line.substr(name.size()))};
 }
 
-static std::optional<unsigned> find_include_guard_heading_end_offset(const std::string& cpp_file_content)
+static bool is_block_comment_left_open(std::string_view line)
 {
-    // FIXME: apply DRY "find_first_match()"
-    std::regex re{"ifndef\\s+\\w+\n#define\\s+\\w+.*\n"};
-    std::smatch match;
-    auto is_match_found{std::regex_search(cpp_file_content, match, re)};
-    if (not is_match_found)
-        return {};
-
-    auto end{match[0].second};
-    return std::distance(std::begin(cpp_file_content), end);
+    for (std::size_t i{0}; i < line.size(); ++i)
+    {
+        if (line[i] == '"')
+        {
+            for (++i; i < line.size() and line[i] != '"'; ++i)
+                if (line[i] == '\\')
+                    ++i;
+        } else if (line[i] == '/' and i + 1 < line.size())
+        {
+            if (line[i + 1] == '/')
+                return false;
+            if (line[i + 1] != '*')
+                continue;
+
+            auto comment_end{line.find("*/", i + 2)};
+            if (comment_end == std::string_view::npos)
+                return true;
+            i = comment_end + 1;
+        }
+    }
+    return false;
 }
 
-static std::optional<unsigned> find_pragma_once_end_offset(const std::string& cpp_file_content)
+static std::string_view trim_front(std::string_view s)
 {
-    // FIXME: apply DRY "find_first_match()"
-    std::regex re{"#pragma\\s+once\n?"};
-    std::smatch match;
-    auto is_match_found{std::regex_search(cpp_file_content, match, re)};
-    if (not is_match_found)
-        return {};
-
-    auto end{match[0].second};
-    return std::distance(std::begin(cpp_file_content), end);
+    auto begin{s.find_first_not_of(" \t\f\v\r\n")};
+    return begin == std::string_view::npos ? std::string_view{} : s.substr(begin);
 }
 
-static std::optional<unsigned> find_header_comment_end_offset(const std::string& cpp_file_content)
+static std::string_view take_identifier(std::string_view s)
 {
-    std::regex re{"\\s*/\\*.*?\\*/[[:blank:]]*\n?", std::regex::extended};
-    std::smatch match;
-    auto is_match_found{std::regex_search(cpp_file_content, match, re)};
-    if (not is_match_found)
-        return {};
-
-    // Is at the beginning of the file?
-    if (match.position() == 0)
-    {
-        auto header_end_index{match[0].length()};
-        return header_end_index;
-    } else
-        return {};
+    auto is_identifier_char{[](char c) {
+        return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9') or c == '_';
+    }};
+
+    std::size_t size{0};
+    while (size < s.size() and is_identifier_char(s[size]))
+        ++size;
+    return s.substr(0, size);
 }
@@ -0,0 +1,133 @@
+/**
+ * @file	class_indexer.cpp
+ * @brief	Implements filling the class index from the Clang ASTs.
+ */
+
+#include "libclang_utils/class_indexer.hpp"
+
+#include <set>
+
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/Tooling.h>
+
+#include "codebase_grepper.hpp"
+#include "common_types.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+#include "trace.hpp"
+
+using namespace clang;
+using namespace clang::tooling;
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+std::vector<Tsepepe::ClassIndexEntry> Tsepepe::collect_class_definitions(ASTContext& context)
+{
+    MatchQueries queries;
+    auto class_definitions{queries.add(get_class_definition_matcher())};
+    queries.run(context);
+    return to_class_index_entries(queries.get_matches(class_definitions), context.getSourceManager());
+}
+
+clang::ast_matchers::DeclarationMatcher Tsepepe::get_class_definition_matcher()
+{
+    using namespace clang::ast_matchers;
+
+    // The implicit instantiations of class templates share the location with the template, so they are skipped, not
+    // to index the same definition multiple times.
+    return cxxRecordDecl(isDefinition(),
+                         isExpansionInMainFile(),
+                         unless(isImplicit()),
+                         unless(isLambda()),
+                         unless(classTemplateSpecializationDecl()))
+        .bind("class");
+}
+
+std::vector<Tsepepe::ClassIndexEntry> Tsepepe::to_class_index_entries(const MatchQueries::Matches& matches,
+                                                                      const SourceManager& source_manager)
+{
+    std::vector<ClassIndexEntry> result;
+    result.reserve(matches.size());
+    for (const auto& class_match : matches)
+    {
+        auto node{class_match.getNodeAs<CXXRecordDecl>("class")};
+        if (node == nullptr or node->getName().empty())
+            continue;
+
+        result.emplace_back(ClassIndexEntry{
+            .name = node->getNameAsString(),
+            .fully_qualified_name = node->getQualifiedNameAsString(),
+            .offset = source_manager.getFileOffset(source_manager.getExpansionLoc(node->getLocation())),
+            .is_abstract = node->isAbstract(),
+            .has_bases = node->getNumBases() != 0});
+    }
+    return result;
+}
+
+void Tsepepe::index_main_file(ClassIndex& index,
+                              const fs::path& main_file_path,
+                              FileStamp stamp,
+                              ASTContext& context)
+{
+    if (index.is_up_to_date(main_file_path))
+        return;
+
+    index_main_file(index, main_file_path, stamp, collect_class_definitions(context));
+}
+
+void Tsepepe::index_main_file(ClassIndex& index,
+                              const fs::path& main_file_path,
+                              FileStamp stamp,
+                              std::vector<ClassIndexEntry> class_definitions)
+{
+    if (index.is_up_to_date(main_file_path))
+        return;
+
+    index.update_file(main_file_path, stamp, std::move(class_definitions));
+}
+
+bool Tsepepe::index_file(ClassIndex& index, const CompilationDatabase& compilation_database, const fs::path& path)
+{
+    auto stamp{get_file_stamp(path)};
+    if (not stamp)
+        return false;
+
+    std::vector<std::unique_ptr<ASTUnit>> ast_units;
+    ClangTool tool{compilation_database,
+                   {path.string()},
+                   std::make_shared<PCHContainerOperations>(),
+                   make_parsing_file_system()};
+    tool.appendArgumentsAdjuster(get_fast_parsing_arguments_adjuster());
+    IgnoringDiagConsumer diagnostic_consumer;
+    tool.setDiagnosticConsumer(&diagnostic_consumer);
+    {
+        TraceSpan span{"ClangTool::buildASTs", path.string()};
+        tool.buildASTs(ast_units);
+    }
+    if (ast_units.empty())
+        return false;
+
+    index.update_file(path, *stamp, collect_class_definitions(ast_units.back()->getASTContext()));
+    return true;
+}
+
+void Tsepepe::update_class_index(ClassIndex& index, const CompilationDatabase& compilation_database)
+{
+    auto matches{codebase_grep(RootDirectory{index.get_project_root()},
+                               EcmaScriptPattern{"\\b(struct|class)\\s+\\w+"})};
+
+    std::set<fs::path> files_with_classes;
+    for (const auto& match : matches)
+        files_with_classes.insert(fs::absolute(match.path).lexically_normal());
+
+    for (const auto& indexed_file : index.get_indexed_files())
+        if (not files_with_classes.contains(indexed_file))
+            index.remove_file(indexed_file);
+
+    for (const auto& path : files_with_classes)
+        if (not index.is_up_to_date(path))
+            index_file(index, compilation_database, path);
+}
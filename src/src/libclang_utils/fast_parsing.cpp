@@ -0,0 +1,22 @@
+/**
+ * @file	fast_parsing.cpp
+ * @brief	Implements the fast parsing arguments adjuster.
+ */
+
+#include "libclang_utils/fast_parsing.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace clang::tooling;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+ArgumentsAdjuster Tsepepe::get_fast_parsing_arguments_adjuster(bool skip_function_bodies)
+{
+    std::vector<std::string> extra_arguments{"-w"};
+    if (skip_function_bodies)
+        extra_arguments.insert(std::end(extra_arguments), {"-Xclang", "-skip-function-bodies"});
+    return getInsertArgumentAdjuster(std::move(extra_arguments), ArgumentInsertPosition::END);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file	in_memory_source_file.cpp
+ * @brief	Implements parsing the unsaved content of a source file.
+ */
+
+#include "libclang_utils/in_memory_source_file.hpp"
+
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "base_error.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "trace.hpp"
+
+using namespace clang;
+using namespace clang::tooling;
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+namespace
+{
+
+//! The same as the one used by ClangTool::buildASTs(), but allows to precompile the preamble.
+class AstBuilderAction : public ToolAction
+{
+  public:
+    AstBuilderAction(std::vector<std::unique_ptr<ASTUnit>>& ast_units, Tsepepe::InMemoryAstBuildOptions);
+
+    bool runInvocation(std::shared_ptr<CompilerInvocation>,
+                       FileManager*,
+                       std::shared_ptr<PCHContainerOperations>,
+                       DiagnosticConsumer*) override;
+
+  private:
+    std::vector<std::unique_ptr<ASTUnit>>& ast_units;
+    const Tsepepe::InMemoryAstBuildOptions options;
+};
+
+} // namespace
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> Tsepepe::make_parsing_file_system()
+{
+    return llvm::vfs::createPhysicalFileSystem();
+}
+
+fs::path Tsepepe::get_in_memory_source_file_path(const fs::path& path, const std::string& id)
+{
+    auto result{fs::absolute(path).lexically_normal()};
+    if (fs::is_directory(result))
+        result /= ".tsepepe_" + id + "_temp.hpp";
+    return result;
+}
+
+std::unique_ptr<ASTUnit> Tsepepe::build_ast_from_memory(const CompilationDatabase& compilation_database,
+                                                        const fs::path& source_file_path,
+                                                        const std::string& content,
+                                                        InMemoryAstBuildOptions options)
+{
+    return build_ast_with_unsaved_files(
+        compilation_database, source_file_path, {{.path = source_file_path, .content = content}}, options);
+}
+
+std::unique_ptr<ASTUnit> Tsepepe::build_ast_with_unsaved_files(const CompilationDatabase& compilation_database,
+                                                               const fs::path& source_file_path,
+                                                               const std::vector<UnsavedFile>& unsaved_files,
+                                                               InMemoryAstBuildOptions options)
+{
+    // The in-memory file system needs the absolute paths.
+    auto path{fs::absolute(source_file_path).lexically_normal()};
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> in_memory_file_system{
+        new llvm::vfs::InMemoryFileSystem};
+    for (const auto& [unsaved_file_path, content] : unsaved_files)
+    {
+        auto absolute_path{fs::absolute(unsaved_file_path).lexically_normal().string()};
+        in_memory_file_system->addFile(absolute_path, 0, llvm::MemoryBuffer::getMemBufferCopy(content, absolute_path));
+    }
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> overlay_file_system{
+        new llvm::vfs::OverlayFileSystem{make_parsing_file_system()}};
+    overlay_file_system->pushOverlay(in_memory_file_system);
+
+    std::vector<std::unique_ptr<ASTUnit>> ast_units;
+    ClangTool tool{
+        compilation_database, {path.string()}, std::make_shared<PCHContainerOperations>(), overlay_file_system};
+    tool.appendArgumentsAdjuster(get_fast_parsing_arguments_adjuster(options.skip_function_bodies));
+    AstBuilderAction action{ast_units, options};
+    {
+        TraceSpan span{"build_ast_with_unsaved_files", path.string()};
+        tool.run(&action);
+    }
+
+    if (ast_units.empty())
+        throw BaseError{"Failed to parse file: " + path.string()};
+    return std::move(ast_units.back());
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+AstBuilderAction::AstBuilderAction(std::vector<std::unique_ptr<ASTUnit>>& ast_units_,
+                                   Tsepepe::InMemoryAstBuildOptions options_) :
+    ast_units{ast_units_}, options{options_}
+{
+}
+
+bool AstBuilderAction::runInvocation(std::shared_ptr<CompilerInvocation> invocation,
+                                     FileManager* files,
+                                     std::shared_ptr<PCHContainerOperations> pch_container_ops,
+                                     DiagnosticConsumer* diagnostic_consumer)
+{
+    auto diagnostics{CompilerInstance::createDiagnostics(
+        &invocation->getDiagnosticOpts(), diagnostic_consumer, /* ShouldOwnClient= */ false)};
+    // The preamble is built already with the first parse.
+    unsigned precompile_preamble_after_n_parses{options.precompile_preamble ? 1u : 0u};
+    auto ast_unit{ASTUnit::LoadFromCompilerInvocation(std::move(invocation),
+                                                      std::move(pch_container_ops),
+                                                      std::move(diagnostics),
+                                                      files,
+                                                      /* OnlyLocalDecls= */ false,
+                                                      CaptureDiagsKind::None,
+                                                      precompile_preamble_after_n_parses)};
+    if (ast_unit == nullptr)
+        return false;
+
+    ast_units.emplace_back(std::move(ast_unit));
+    return true;
+}
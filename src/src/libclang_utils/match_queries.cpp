@@ -0,0 +1,67 @@
+/**
+ * @file	match_queries.cpp
+ * @brief	Implements running multiple AST matchers within a single traversal of the AST.
+ */
+
+#include "libclang_utils/match_queries.hpp"
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+
+#include "trace.hpp"
+
+using namespace clang::ast_matchers;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private declarations
+// --------------------------------------------------------------------------------------------------------------------
+namespace
+{
+
+class MatchCollector : public MatchFinder::MatchCallback
+{
+  public:
+    explicit MatchCollector(Tsepepe::MatchQueries::Matches& matches_) : matches{matches_}
+    {
+    }
+
+    void run(const MatchFinder::MatchResult& result) override
+    {
+        matches.push_back(result.Nodes);
+    }
+
+  private:
+    Tsepepe::MatchQueries::Matches& matches;
+};
+
+} // namespace
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::MatchQueries::QueryId Tsepepe::MatchQueries::add(DeclarationMatcher matcher)
+{
+    matchers.push_back(std::move(matcher));
+    matches.emplace_back();
+    return matchers.size() - 1;
+}
+
+void Tsepepe::MatchQueries::run(clang::ASTContext& context)
+{
+    matches.assign(matchers.size(), {});
+
+    // The finder refers to the callbacks, so they must not be moved, once registered.
+    std::vector<MatchCollector> collectors;
+    collectors.reserve(matchers.size());
+
+    MatchFinder finder;
+    for (std::size_t i{0}; i < matchers.size(); ++i)
+        finder.addMatcher(matchers[i], &collectors.emplace_back(matches[i]));
+
+    TraceSpan span{"MatchFinder::matchAST"};
+    finder.matchAST(context);
+}
+
+const Tsepepe::MatchQueries::Matches& Tsepepe::MatchQueries::get_matches(QueryId id) const
+{
+    return matches.at(id);
+}
@@ -7,11 +7,12 @@
 #include "clang/Basic/LangOptions.h"
 
 #include <iostream>
-#include <regex>
 
 #include <clang/Basic/SourceManager.h>
 #include <clang/Lex/Lexer.h>
 
+#include "string_utils.hpp"
+
 using namespace clang;
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -35,30 +36,12 @@ std::string Tsepepe::source_range_content_to_string(const clang::SourceRange& so
                                                     const clang::SourceManager& source_manager,
                                                     const clang::LangOptions& lang_opts)
 {
-    auto is_space{[](unsigned char c) {
-        return std::isspace(c);
-    }};
-
-    auto strip{[&](std::string& s) {
-        auto first_non_ws_it{std::find_if_not(s.begin(), s.end(), is_space)};
-        s.erase(s.begin(), first_non_ws_it);
-        auto last_non_ws_it{std::find_if_not(s.rbegin(), s.rend(), is_space)};
-        s.erase(last_non_ws_it.base(), s.end());
-    }};
-
     auto begin{source_range.getBegin()};
     auto temp_end{source_range.getEnd()};
     auto end{Lexer::getLocForEndOfToken(temp_end, 0, source_manager, lang_opts)};
 
-    std::string result_raw(source_manager.getCharacterData(begin), source_manager.getCharacterData(end));
-    if (result_raw.empty())
-        return result_raw;
-
-    std::regex re{"\\s\\s+"};
-    auto result{std::regex_replace(result_raw, re, " ")};
-
-    strip(result);
-    return result;
+    std::string_view content(source_manager.getCharacterData(begin), source_manager.getCharacterData(end));
+    return Tsepepe::utils::strip_and_collapse_whitespaces(content);
 }
 
 void Tsepepe::dump_token(const clang::Token& token)
@@ -9,6 +9,7 @@
 #include "libclang_utils/pure_virtual_functions_extractor.hpp"
 
 #include "scope_remover.hpp"
+#include "trace.hpp"
 
 using namespace clang;
 using namespace Tsepepe;
@@ -23,8 +24,11 @@ using namespace Tsepepe;
 OverrideDeclarations
 Tsepepe::pure_virtual_functions_to_override_declarations(const clang::CXXRecordDecl* node,
                                                          std::string implementor_fully_qualified_name,
-                                                         const clang::SourceManager& source_manager)
+                                                         const clang::SourceManager& source_manager,
+                                                         const PureVirtualFunctionFilter& filter)
 {
+    TraceSpan span{"pure_virtual_functions_to_override_declarations"};
+
     OverrideDeclarations override_declarations;
     AllScopeRemover implementor_scopes_remover{FullyQualifiedName{implementor_fully_qualified_name}};
 
@@ -41,7 +45,7 @@ Tsepepe::pure_virtual_functions_to_override_declarations(const clang::CXXRecordD
 
     auto collect_override_declarations{[&](const clang::CXXRecordDecl* record) {
         for (auto method : record->methods())
-            if (method->isPure())
+            if (method->isPure() and (not filter or filter(method)))
                 append_override_declaration(method);
     }};
 
@@ -5,55 +5,145 @@
 
 #include "scope_remover.hpp"
 
-#include <regex>
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <optional>
 
-Tsepepe::ScopeRemover::ScopeRemover(FullyQualifiedName name_alias) : fully_qualified_name{std::move(name_alias.get())}
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static std::string normalize_fully_qualified_name(std::string);
+
+//! Removes the longest of the scopes, matching on the token boundary, wherever any of them is found. The scopes are
+//! the prefixes of the longest scope, of the ascending sizes.
+static std::string remove_scopes(const std::string& cpp_code,
+                                 const std::string& longest_scope,
+                                 const std::vector<std::size_t>& scope_sizes);
+
+//! Returns the size of the global scope qualifier "::", which precedes the position, 0, when there is none, or nothing,
+//! when the position isn't on the token boundary, i.e. it is within an identifier, or within a nested scope, like
+//! "Outer::<position>".
+static std::optional<std::size_t> get_preceding_global_scope_size(const std::string& cpp_code, std::size_t position);
+
+static bool is_identifier_char(char);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::ScopeRemover::ScopeRemover(FullyQualifiedName name_alias) :
+    fully_qualified_name{normalize_fully_qualified_name(std::move(name_alias.get()))}
 {
-    if (not fully_qualified_name.ends_with("::"))
-        fully_qualified_name.append("::");
 }
 
-std::string Tsepepe::ScopeRemover::remove_from(const std::string& cpp_code)
+std::string Tsepepe::ScopeRemover::remove_from(const std::string& cpp_code) const
 {
-    return std::regex_replace(cpp_code, std::regex{fully_qualified_name}, "");
+    return remove_scopes(cpp_code, fully_qualified_name, {fully_qualified_name.size()});
 }
 
 Tsepepe::AllScopeRemover::AllScopeRemover(FullyQualifiedName name_alias) :
-    nesting_scopes{make_nesting_scopes(name_alias.get())}
+    fully_qualified_name{normalize_fully_qualified_name(std::move(name_alias.get()))},
+    nesting_scope_sizes{get_nesting_scope_sizes(fully_qualified_name)}
 {
 }
 
-std::string Tsepepe::AllScopeRemover::remove_from(std::string cpp_code)
+std::string Tsepepe::AllScopeRemover::remove_from(const std::string& cpp_code) const
 {
-    for (const auto& scope : nesting_scopes)
-        cpp_code = ScopeRemover{FullyQualifiedName{scope}}.remove_from(cpp_code);
-    return cpp_code;
+    return remove_scopes(cpp_code, fully_qualified_name, nesting_scope_sizes);
 }
 
-std::vector<std::string> Tsepepe::AllScopeRemover::make_nesting_scopes(const std::string& fully_qualified_name)
+std::vector<std::size_t> Tsepepe::AllScopeRemover::get_nesting_scope_sizes(const std::string& fully_qualified_name)
 {
-    std::vector<std::string> result;
+    std::vector<std::size_t> result;
     result.reserve(4);
 
-    auto actual_begin{std::begin(fully_qualified_name)};
+    for (auto position{fully_qualified_name.find("::")}; position != std::string::npos;
+         position = fully_qualified_name.find("::", position + 2))
+        result.push_back(position + 2);
 
-    auto it{std::rbegin(fully_qualified_name)};
-    if (*it == ':')
-        ++it;
-    if (*it == ':')
-        ++it;
+    return result;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static std::string normalize_fully_qualified_name(std::string name)
+{
+    if (name.starts_with("::"))
+        name.erase(0, 2);
+    if (not name.ends_with("::"))
+        name.append("::");
+    return name;
+}
+
+static std::string remove_scopes(const std::string& cpp_code,
+                                 const std::string& longest_scope,
+                                 const std::vector<std::size_t>& scope_sizes)
+{
+    if (longest_scope.size() <= 2)
+        return cpp_code;
 
-    auto end{std::rend(fully_qualified_name)};
-    while (it != end)
+    std::string result;
+    result.reserve(cpp_code.size());
+
+    std::size_t copied_end{0};
+    std::size_t position{0};
+    while (position < cpp_code.size())
     {
-        result.emplace_back(std::string(actual_begin, it.base()) + "::");
-        it = std::find(it, end, ':');
-        if (it == end)
-            break;
-        // Skip the "::"
-        it += 2;
+        if (cpp_code[position] == longest_scope.front())
+        {
+            if (auto global_scope_size{get_preceding_global_scope_size(cpp_code, position)})
+            {
+                auto [_, longest_scope_mismatch_it] = std::mismatch(std::next(std::begin(cpp_code), position),
+                                                                    std::end(cpp_code),
+                                                                    std::begin(longest_scope),
+                                                                    std::end(longest_scope));
+                auto matched_size{static_cast<std::size_t>(longest_scope_mismatch_it - std::begin(longest_scope))};
+
+                auto scope_size_it{std::ranges::upper_bound(scope_sizes, matched_size)};
+                if (scope_size_it != std::begin(scope_sizes))
+                {
+                    result.append(cpp_code, copied_end, position - *global_scope_size - copied_end);
+                    position += *std::prev(scope_size_it);
+                    copied_end = position;
+                    continue;
+                }
+            }
+        }
+
+        // Identifiers are skipped as a whole, so that no scope is matched in the middle of one.
+        if (is_identifier_char(cpp_code[position]))
+            while (position < cpp_code.size() and is_identifier_char(cpp_code[position]))
+                ++position;
+        else
+            ++position;
     }
 
+    result.append(cpp_code, copied_end);
     return result;
 }
 
+static std::optional<std::size_t> get_preceding_global_scope_size(const std::string& cpp_code, std::size_t position)
+{
+    if (position == 0)
+        return 0;
+
+    auto previous_char{cpp_code[position - 1]};
+    if (is_identifier_char(previous_char))
+        return std::nullopt;
+    if (previous_char != ':' or position < 2 or cpp_code[position - 2] != ':')
+        return 0;
+
+    // "::" preceded by a name, or by a template argument list, qualifies the scope with an outer one.
+    if (position == 2)
+        return 2;
+    auto char_before_scope_qualifier{cpp_code[position - 3]};
+    if (is_identifier_char(char_before_scope_qualifier) or char_before_scope_qualifier == '>')
+        return std::nullopt;
+    return 2;
+}
+
+static bool is_identifier_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) or c == '_';
+}
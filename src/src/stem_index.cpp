@@ -0,0 +1,295 @@
+/**
+ * @file	stem_index.cpp
+ * @brief	Implements the StemIndex.
+ */
+
+#include "stem_index.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "base_error.hpp"
+#include "codebase_grepper.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+//! Increment, whenever the storage format changes, so that the indexes stored with the older versions are rebuilt.
+static constexpr unsigned storage_format_version{1};
+static constexpr const char* storage_format_header{"tsepepe-stem-index"};
+
+//! Strips the trailing separator as well, so that the directories are keyed the same way, as the parents of the files.
+static fs::path normalize(const fs::path&);
+
+static bool is_within_directory(const fs::path& directory, const fs::path& path);
+
+static std::string get_stem(const std::string& file_name);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::StemIndex::StemIndex(fs::path root) : project_root{normalize(root)}
+{
+}
+
+Tsepepe::StemIndex Tsepepe::StemIndex::build(const fs::path& project_root)
+{
+    StemIndex result{project_root};
+    result.index_directory(result.project_root, [](const fs::path&) { return true; });
+    return result;
+}
+
+std::optional<Tsepepe::StemIndex> Tsepepe::StemIndex::load(const fs::path& project_root)
+{
+    std::ifstream ifs{get_storage_path(project_root)};
+    if (not ifs)
+        return std::nullopt;
+
+    std::string header;
+    unsigned version{0};
+    ifs >> header >> version;
+    if (header != storage_format_header or version != storage_format_version)
+        return std::nullopt;
+
+    StemIndex result{project_root};
+    IndexedDirectory* current_directory{nullptr};
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::istringstream iss{line};
+        char kind;
+        iss >> kind;
+        iss.ignore(1);
+        if (kind == 'D')
+        {
+            FileStamp stamp;
+            iss >> stamp.modification_time >> stamp.size;
+            iss.ignore(1);
+
+            std::string relative_path;
+            std::getline(iss, relative_path);
+            if (not iss and not iss.eof())
+                return std::nullopt;
+
+            current_directory = &result.directories[normalize(result.project_root / relative_path)];
+            current_directory->stamp = stamp;
+        } else if (kind == 'F' and current_directory != nullptr)
+        {
+            std::string file_name;
+            std::getline(iss, file_name);
+            if (file_name.empty())
+                return std::nullopt;
+
+            current_directory->file_names.emplace_back(std::move(file_name));
+        } else
+        {
+            return std::nullopt;
+        }
+    }
+
+    for (const auto& [path, indexed_directory] : result.directories)
+        result.add_to_lookup(path, indexed_directory.file_names);
+    return result;
+}
+
+void Tsepepe::StemIndex::save() const
+{
+    auto storage_path{get_storage_path(project_root)};
+    fs::create_directories(storage_path.parent_path());
+
+    // Written to a temporary file first, so that a reader never observes a partially written index.
+    auto temporary_path{storage_path};
+    temporary_path += ".tmp";
+    {
+        std::ofstream ofs{temporary_path};
+        if (not ofs)
+            throw BaseError{"Failed to store the stem index under: " + temporary_path.string()};
+
+        ofs << storage_format_header << ' ' << storage_format_version << '\n';
+        for (const auto& [path, indexed_directory] : directories)
+        {
+            ofs << "D " << indexed_directory.stamp.modification_time << ' ' << indexed_directory.stamp.size << ' '
+                << path.lexically_relative(project_root).string() << '\n';
+            for (const auto& file_name : indexed_directory.file_names)
+                ofs << "F " << file_name << '\n';
+        }
+    }
+    fs::rename(temporary_path, storage_path);
+    modified = false;
+}
+
+fs::path Tsepepe::StemIndex::get_storage_path(const fs::path& project_root)
+{
+    return normalize(project_root) / ".tsepepe" / "stem_index";
+}
+
+void Tsepepe::StemIndex::refresh()
+{
+    // Only the directories are stamped, so no file is touched, unless it's added, removed or renamed.
+    std::vector<fs::path> changed_directories;
+    for (const auto& [path, indexed_directory] : directories)
+        if (get_file_stamp(path) != indexed_directory.stamp)
+            changed_directories.push_back(path);
+
+    refresh(std::move(changed_directories));
+}
+
+void Tsepepe::StemIndex::refresh(std::vector<fs::path> changed_directories)
+{
+    // The parent directories precede the subdirectories, so the new subdirectories are read together with the parents.
+    for (auto& path : changed_directories)
+        path = normalize(path);
+    std::ranges::sort(changed_directories);
+
+    for (const auto& path : changed_directories)
+    {
+        if (not directories.contains(path))
+            continue;
+
+        std::error_code ec;
+        if (not fs::is_directory(path, ec))
+        {
+            remove_directory(path);
+            continue;
+        }
+
+        std::mutex walked_subdirectories_mutex;
+        std::set<fs::path> walked_subdirectories;
+        index_directory(path, [&](const fs::path& subdirectory) {
+            {
+                std::lock_guard lock{walked_subdirectories_mutex};
+                walked_subdirectories.insert(subdirectory);
+            }
+            return not directories.contains(subdirectory);
+        });
+
+        // The subdirectories, which are no longer walked, have been removed, or are ignored now.
+        std::vector<fs::path> gone_subdirectories;
+        for (auto it{directories.upper_bound(path)};
+             it != std::end(directories) and is_within_directory(path, it->first);
+             ++it)
+            if (it->first.parent_path() == path and not walked_subdirectories.contains(it->first))
+                gone_subdirectories.push_back(it->first);
+        for (const auto& subdirectory : gone_subdirectories)
+            remove_directory(subdirectory);
+    }
+}
+
+std::vector<fs::path> Tsepepe::StemIndex::find(const std::string& stem) const
+{
+    auto it{paths_by_stem.find(stem)};
+    if (it == std::end(paths_by_stem))
+        return {};
+    return {std::begin(it->second), std::end(it->second)};
+}
+
+bool Tsepepe::StemIndex::is_modified() const
+{
+    return modified;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+void Tsepepe::StemIndex::index_directory(const fs::path& directory,
+                                         const std::function<bool(const fs::path&)>& is_subdirectory_read)
+{
+    // The visitors are called from multiple threads, so the index is updated only once the walk is finished.
+    std::mutex read_directories_mutex;
+    std::map<fs::path, IndexedDirectory> read_directories;
+
+    walk_codebase(
+        RootDirectory{directory},
+        [&](const fs::path& path) {
+            std::lock_guard lock{read_directories_mutex};
+            read_directories[path.parent_path()].file_names.emplace_back(path.filename().string());
+            return true;
+        },
+        [&](const fs::path& path) {
+            if (path != directory and not is_subdirectory_read(path))
+                return false;
+
+            // Stamped before the directory is read, so that the changes made in the meantime are detected.
+            auto stamp{get_file_stamp(path)};
+            std::lock_guard lock{read_directories_mutex};
+            read_directories[path].stamp = stamp.value_or(FileStamp{});
+            return true;
+        });
+
+    for (auto& [path, read_directory] : read_directories)
+        update_directory(path, std::move(read_directory));
+}
+
+void Tsepepe::StemIndex::update_directory(const fs::path& path, IndexedDirectory indexed_directory)
+{
+    auto [it, is_inserted] = directories.try_emplace(path);
+    if (not is_inserted)
+        remove_from_lookup(path, it->second.file_names);
+
+    std::ranges::sort(indexed_directory.file_names);
+    add_to_lookup(path, indexed_directory.file_names);
+    it->second = std::move(indexed_directory);
+    modified = true;
+}
+
+void Tsepepe::StemIndex::remove_directory(const fs::path& path)
+{
+    // The subdirectories directly follow the directory, within the ordered map.
+    auto it{directories.lower_bound(path)};
+    while (it != std::end(directories) and is_within_directory(path, it->first))
+    {
+        remove_from_lookup(it->first, it->second.file_names);
+        it = directories.erase(it);
+        modified = true;
+    }
+}
+
+void Tsepepe::StemIndex::add_to_lookup(const fs::path& directory, const std::vector<std::string>& file_names)
+{
+    for (const auto& file_name : file_names)
+        paths_by_stem[get_stem(file_name)].insert(directory / file_name);
+}
+
+void Tsepepe::StemIndex::remove_from_lookup(const fs::path& directory, const std::vector<std::string>& file_names)
+{
+    for (const auto& file_name : file_names)
+    {
+        auto it{paths_by_stem.find(get_stem(file_name))};
+        if (it == std::end(paths_by_stem))
+            continue;
+
+        it->second.erase(directory / file_name);
+        if (it->second.empty())
+            paths_by_stem.erase(it);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static fs::path normalize(const fs::path& path)
+{
+    auto result{fs::absolute(path).lexically_normal()};
+    if (not result.has_filename() and result.has_relative_path())
+        return result.parent_path();
+    return result;
+}
+
+static bool is_within_directory(const fs::path& directory, const fs::path& path)
+{
+    return std::mismatch(std::begin(directory), std::end(directory), std::begin(path), std::end(path)).first
+           == std::end(directory);
+}
+
+static std::string get_stem(const std::string& file_name)
+{
+    return fs::path{file_name}.stem().string();
+}
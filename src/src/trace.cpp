@@ -0,0 +1,181 @@
+/**
+ * @file	trace.cpp
+ * @brief	Implements recording of the Chrome trace events.
+ */
+
+#include "trace.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace fs = std::filesystem;
+namespace json = llvm::json;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+namespace
+{
+
+struct TraceEvent
+{
+    const char* name;
+    std::string detail;
+    std::int64_t begin_us;
+    std::int64_t duration_us;
+    unsigned thread_id;
+};
+
+//! Collects the events, and writes them to the trace file, when flushed, and on destruction.
+class Tracer
+{
+  public:
+    static Tracer& get();
+
+    ~Tracer();
+
+    bool is_enabled() const;
+    std::int64_t now_us() const;
+    void record(const char* name, std::string detail, std::int64_t begin_us);
+    void flush();
+
+  private:
+    Tracer();
+
+    //! The oldest events are dropped beyond that.
+    static constexpr std::size_t max_events_count{1 << 16};
+
+    void write();
+
+    fs::path trace_file_path;
+    std::chrono::steady_clock::time_point start;
+
+    std::mutex mutex;
+    std::deque<TraceEvent> events;
+    std::map<std::thread::id, unsigned> thread_ids;
+};
+
+} // namespace
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+bool Tsepepe::is_tracing_enabled() noexcept
+{
+    static const bool is_enabled{Tracer::get().is_enabled()};
+    return is_enabled;
+}
+
+void Tsepepe::flush_trace()
+{
+    if (is_tracing_enabled())
+        Tracer::get().flush();
+}
+
+Tsepepe::TraceSpan::TraceSpan(const char* name, std::string_view detail) : name{name}, begin_us{-1}
+{
+    if (not is_tracing_enabled())
+        return;
+    this->detail = detail;
+    begin_us = Tracer::get().now_us();
+}
+
+Tsepepe::TraceSpan::~TraceSpan()
+{
+    if (begin_us >= 0)
+        Tracer::get().record(name, std::move(detail), begin_us);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+Tracer& Tracer::get()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : start{std::chrono::steady_clock::now()}
+{
+    if (auto path{std::getenv(Tsepepe::trace_environment_variable)}; path != nullptr)
+        trace_file_path = path;
+}
+
+Tracer::~Tracer()
+{
+    if (is_enabled())
+        write();
+}
+
+bool Tracer::is_enabled() const
+{
+    return not trace_file_path.empty();
+}
+
+std::int64_t Tracer::now_us() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Tracer::record(const char* name, std::string detail, std::int64_t begin_us)
+{
+    auto end_us{now_us()};
+
+    std::lock_guard lock{mutex};
+    auto thread_id{thread_ids.try_emplace(std::this_thread::get_id(), thread_ids.size()).first->second};
+    if (events.size() == max_events_count)
+        events.pop_front();
+    events.push_back(TraceEvent{.name = name,
+                                .detail = std::move(detail),
+                                .begin_us = begin_us,
+                                .duration_us = end_us - begin_us,
+                                .thread_id = thread_id});
+}
+
+void Tracer::flush()
+{
+    if (is_enabled())
+        write();
+}
+
+//! Writes the complete events ("ph": "X"), in the JSON object format of the Chrome trace events. The whole file is
+//! written again, so that it's always a valid JSON.
+void Tracer::write()
+{
+    std::lock_guard lock{mutex};
+    std::error_code ec;
+    llvm::raw_fd_ostream os{trace_file_path.string(), ec};
+    // The tracing shall never break the tool, so the trace is dropped, when it can't be written.
+    if (ec)
+        return;
+
+    json::OStream out{os};
+    out.object([&]() {
+        out.attributeArray("traceEvents", [&]() {
+            for (const auto& event : events)
+                out.object([&]() {
+                    out.attribute("name", event.name);
+                    out.attribute("cat", "tsepepe");
+                    out.attribute("ph", "X");
+                    out.attribute("ts", event.begin_us);
+                    out.attribute("dur", event.duration_us);
+                    out.attribute("pid", static_cast<std::int64_t>(getpid()));
+                    out.attribute("tid", static_cast<std::int64_t>(event.thread_id));
+                    if (not event.detail.empty())
+                        out.attributeObject("args", [&]() { out.attribute("detail", event.detail); });
+                });
+        });
+        out.attribute("displayTimeUnit", "ms");
+    });
+}
@@ -0,0 +1,162 @@
+/**
+ * @file	unix_socket.cpp
+ * @brief	Implements the UnixSocket.
+ */
+
+#include "unix_socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "base_error.hpp"
+
+namespace fs = std::filesystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+static sockaddr_un make_address(const fs::path&);
+static Tsepepe::BaseError make_error(const std::string& message);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::UnixSocket Tsepepe::UnixSocket::listen(const fs::path& path)
+{
+    auto address{make_address(path)};
+    UnixSocket result{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (result.fd < 0)
+        throw make_error("Failed to create a socket");
+
+    fs::remove(path);
+
+    if (::bind(result.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        throw make_error("Failed to bind a socket to: " + path.string());
+    if (::listen(result.fd, SOMAXCONN) != 0)
+        throw make_error("Failed to listen on: " + path.string());
+    return result;
+}
+
+Tsepepe::UnixSocket Tsepepe::UnixSocket::connect(const fs::path& path)
+{
+    auto address{make_address(path)};
+    UnixSocket result{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (result.fd < 0)
+        throw make_error("Failed to create a socket");
+
+    if (::connect(result.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        throw make_error("Failed to connect to: " + path.string());
+    return result;
+}
+
+Tsepepe::UnixSocket::UnixSocket(UnixSocket&& other) noexcept :
+    fd{std::exchange(other.fd, -1)}, received{std::move(other.received)}
+{
+}
+
+Tsepepe::UnixSocket& Tsepepe::UnixSocket::operator=(UnixSocket&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = std::exchange(other.fd, -1);
+        received = std::move(other.received);
+    }
+    return *this;
+}
+
+Tsepepe::UnixSocket::~UnixSocket()
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+Tsepepe::UnixSocket Tsepepe::UnixSocket::accept()
+{
+    while (true)
+    {
+        UnixSocket connection{::accept(fd, nullptr, nullptr)};
+        if (connection.fd >= 0)
+            return connection;
+        if (errno != EINTR)
+            throw make_error("Failed to accept a connection");
+    }
+}
+
+std::optional<std::string> Tsepepe::UnixSocket::read_line()
+{
+    char buffer[4096];
+    std::string::size_type searched_count{0};
+
+    while (true)
+    {
+        if (auto line_end{received.find('\n', searched_count)}; line_end != std::string::npos)
+        {
+            std::string line{received.substr(0, line_end)};
+            received.erase(0, line_end + 1);
+            return line;
+        }
+        searched_count = received.size();
+
+        auto count{::read(fd, buffer, sizeof(buffer))};
+        if (count < 0 and errno == EINTR)
+            continue;
+        if (count < 0)
+            throw make_error("Failed to read from a socket");
+        if (count == 0)
+            return std::nullopt;
+
+        received.append(buffer, static_cast<std::size_t>(count));
+    }
+}
+
+void Tsepepe::UnixSocket::write_line(const std::string& line)
+{
+    auto data{line + '\n'};
+    const char* begin{data.data()};
+    auto remaining{data.size()};
+    while (remaining > 0)
+    {
+        // MSG_NOSIGNAL, so that a peer, which has gone away, does not kill the process with SIGPIPE.
+        auto count{::send(fd, begin, remaining, MSG_NOSIGNAL)};
+        if (count < 0 and errno == EINTR)
+            continue;
+        if (count < 0)
+            throw make_error("Failed to write to a socket");
+        begin += count;
+        remaining -= static_cast<std::size_t>(count);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+Tsepepe::UnixSocket::UnixSocket(int fd) : fd{fd}
+{
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static sockaddr_un make_address(const fs::path& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    const auto& native_path{path.native()};
+    if (native_path.size() >= sizeof(address.sun_path))
+        throw Tsepepe::BaseError{"Socket path too long: " + native_path};
+    std::memcpy(address.sun_path, native_path.c_str(), native_path.size() + 1);
+    return address;
+}
+
+static Tsepepe::BaseError make_error(const std::string& message)
+{
+    return Tsepepe::BaseError{message + ": " + std::strerror(errno)};
+}
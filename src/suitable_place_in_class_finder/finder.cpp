@@ -17,6 +17,8 @@
 #include "finder.hpp"
 
 #include "clang_ast_utils.hpp"
+#include "libclang_utils/fast_parsing.hpp"
+#include "trace.hpp"
 
 using namespace clang;
 using namespace clang::tooling;
@@ -121,6 +123,7 @@ class LineFinder : public ast::MatchFinder::MatchCallback
 
         auto get_line_nums_with_public_access_specifier_declarations{[&]() -> std::vector<unsigned> {
             std::string command{"rg --line-number \"public\\s*:\" " + header_file.string()};
+            Tsepepe::TraceSpan span{"ripgrep", command};
 
             using namespace boost::process;
             ipstream pipe_stream;
@@ -195,11 +198,16 @@ std::optional<std::string> Tsepepe::SuitablePlaceInClassFinder::find(const Input
     finder.addMatcher(class_matcher, &line_finder);
 
     ClangTool tool{*input.compilation_database_ptr, {input.header_file}};
+    // The ends of the inline method definitions are looked at, so the function bodies can't be skipped.
+    tool.appendArgumentsAdjuster(Tsepepe::get_fast_parsing_arguments_adjuster(/* skip_function_bodies= */ false));
 
     IgnoringDiagConsumer diagnostic_consumer;
     tool.setDiagnosticConsumer(&diagnostic_consumer);
 
-    tool.run(newFrontendActionFactory(&finder).get());
+    {
+        TraceSpan span{"ClangTool::run", input.header_file.string()};
+        tool.run(newFrontendActionFactory(&finder).get());
+    }
 
     return line_finder.get_result();
 }
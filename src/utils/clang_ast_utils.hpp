@@ -15,6 +15,7 @@ namespace Tsepepe::utils::clang_ast
 {
 
 //! Throws if no compilation database is found under the specified directory, or when the directory doesn't exist.
+//! The database is loaded through the binary cache, kept next to compile_commands.json.
 std::unique_ptr<clang::tooling::CompilationDatabase>
 parse_compilation_database(const std::filesystem::path& directory_with_compilation_database);
 
@@ -43,10 +44,6 @@ struct MatchValidator : MatchCounter
     };
 };
 
-std::string source_range_content_to_string(const clang::SourceRange& source_range,
-                                           const clang::SourceManager& source_manager,
-                                           const clang::LangOptions&);
-
 } // namespace Tsepepe::utils::clang_ast
 
 #endif /* CLANG_AST_UTILS_HPP */
@@ -0,0 +1,540 @@
+/**
+ * @file	compilation_database_cache.cpp
+ * @brief	Implements the binary cache of the JSON compilation database.
+ */
+
+#include "compilation_database_cache.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <clang/Tooling/JSONCompilationDatabase.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include "error.hpp"
+
+namespace stdfs = std::filesystem;
+using namespace clang::tooling;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper declarations
+// --------------------------------------------------------------------------------------------------------------------
+namespace
+{
+
+constexpr std::array<char, 8> cache_magic{'T', 'S', 'P', 'P', 'C', 'D', 'B', '\0'};
+constexpr std::uint32_t cache_version{1};
+
+//! Each section of the cache is aligned to that many bytes, so that it can be accessed in place, once mapped.
+constexpr std::size_t cache_alignment{8};
+
+struct JsonStamp
+{
+    std::int64_t modification_time;
+    std::uint64_t size;
+};
+
+//! The cache starts with the header, followed by the sections:
+//!     std::uint64_t string_offsets[strings_count + 1];
+//!     char string_data[string_offsets[strings_count]];
+//!     Command commands[commands_count];
+//!     std::uint32_t arguments[arguments_count];
+//!     Bucket buckets[buckets_count];
+struct Header
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t strings_count;
+    std::int64_t json_modification_time;
+    std::uint64_t json_size;
+    std::uint32_t commands_count;
+    std::uint32_t arguments_count;
+    std::uint32_t buckets_count;
+    std::uint32_t padding;
+};
+
+//! All the members, but the arguments, are the indexes of the strings. The arguments refer the arguments section,
+//! which contains the indexes of the strings.
+struct Command
+{
+    std::uint32_t directory;
+    std::uint32_t file;
+    std::uint32_t output;
+    //! The absolute, normalized path of the file, under which the command is looked up.
+    std::uint32_t file_key;
+    std::uint32_t arguments_begin;
+    std::uint32_t arguments_count;
+};
+
+//! The slot of the open addressing hash table, which maps the file keys to the commands. The commands for the same
+//! file are stored next to each other. Empty slots have no commands.
+struct Bucket
+{
+    std::uint32_t first_command;
+    std::uint32_t commands_count;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> and sizeof(Header) == 48);
+static_assert(std::is_trivially_copyable_v<Command> and sizeof(Command) == 24);
+static_assert(std::is_trivially_copyable_v<Bucket> and sizeof(Bucket) == 8);
+
+//! Reads the commands directly from the cache content.
+class MappedCompilationDatabase : public CompilationDatabase
+{
+  public:
+    //! Returns nullptr, when the content is not a valid cache built from the JSON compilation database with the stamp.
+    static std::unique_ptr<MappedCompilationDatabase> load(std::unique_ptr<llvm::MemoryBuffer>, const JsonStamp&);
+
+    std::vector<CompileCommand> getCompileCommands(llvm::StringRef file_path) const override;
+    std::vector<std::string> getAllFiles() const override;
+    std::vector<CompileCommand> getAllCompileCommands() const override;
+
+  private:
+    explicit MappedCompilationDatabase(std::unique_ptr<llvm::MemoryBuffer>);
+
+    llvm::StringRef get_string(std::uint32_t index) const;
+    CompileCommand make_compile_command(const Command&) const;
+
+    std::unique_ptr<llvm::MemoryBuffer> content;
+    std::span<const std::uint64_t> string_offsets;
+    const char* string_data;
+    std::span<const Command> commands;
+    std::span<const std::uint32_t> arguments;
+    std::span<const Bucket> buckets;
+};
+
+//! Infers the commands for the files, which are missing in the database, but builds the index of the files, which is
+//! needed for that, only once the first missing file is requested. That way, loading the database stays cheap.
+class LazilyInferringCompilationDatabase : public CompilationDatabase
+{
+  public:
+    explicit LazilyInferringCompilationDatabase(std::unique_ptr<CompilationDatabase>);
+
+    std::vector<CompileCommand> getCompileCommands(llvm::StringRef file_path) const override;
+    std::vector<std::string> getAllFiles() const override;
+    std::vector<CompileCommand> getAllCompileCommands() const override;
+
+  private:
+    const CompilationDatabase& get_inferring_database() const;
+
+    std::unique_ptr<CompilationDatabase> database;
+    mutable std::once_flag inferring_database_flag;
+    mutable std::unique_ptr<CompilationDatabase> inferring_database;
+};
+
+//! Allows to wrap the database, without taking the ownership of it.
+class CompilationDatabaseReference : public CompilationDatabase
+{
+  public:
+    explicit CompilationDatabaseReference(const CompilationDatabase&);
+
+    std::vector<CompileCommand> getCompileCommands(llvm::StringRef file_path) const override;
+    std::vector<std::string> getAllFiles() const override;
+    std::vector<CompileCommand> getAllCompileCommands() const override;
+
+  private:
+    const CompilationDatabase& database;
+};
+
+} // namespace
+
+static std::optional<JsonStamp> get_json_stamp(const stdfs::path&);
+
+static std::string serialize(const CompilationDatabase&, const JsonStamp&);
+
+//! Writes the file aside and renames it, so that the other processes never map a partially written cache.
+//! Returns false on failure.
+static bool save_atomically(const stdfs::path&, const std::string& content);
+
+//! Wraps the database the same way, as the JSON compilation database is wrapped, when loaded with
+//! clang::tooling::CompilationDatabase::loadFromDirectory().
+static std::unique_ptr<CompilationDatabase> wrap_as_json_compilation_database(std::unique_ptr<CompilationDatabase>);
+
+static std::string make_file_key(llvm::StringRef directory, llvm::StringRef file);
+
+//! The FNV-1a hash, which, in contrary to std::hash, is the same across the processes.
+static std::uint64_t hash(std::string_view);
+
+// --------------------------------------------------------------------------------------------------------------------
+// Public stuff
+// --------------------------------------------------------------------------------------------------------------------
+namespace Tsepepe::utils::clang_ast
+{
+
+std::unique_ptr<CompilationDatabase>
+load_cached_compilation_database(const stdfs::path& directory_with_compilation_database)
+{
+    auto json_path{directory_with_compilation_database / "compile_commands.json"};
+    auto cache_path{directory_with_compilation_database / compilation_database_cache_file_name};
+
+    auto json_stamp{get_json_stamp(json_path)};
+    if (not json_stamp)
+        throw Tsepepe::Error{"ERROR: Path : " + json_path.string() + " does not exist!"};
+
+    if (auto cache_content{
+            llvm::MemoryBuffer::getFile(cache_path.string(), /* IsText= */ false, /* RequiresNullTerminator= */ false)})
+        if (auto database{MappedCompilationDatabase::load(std::move(*cache_content), *json_stamp)})
+            return wrap_as_json_compilation_database(std::move(database));
+
+    std::string err;
+    auto json_database{
+        JSONCompilationDatabase::loadFromFile(json_path.string(), err, JSONCommandLineSyntax::AutoDetect)};
+    if (!json_database)
+        throw Tsepepe::Error{"ERROR: While parsing compilation database, from clang::tooling::CompilationDatabase: "
+                             + err};
+
+    // The content is used directly, so the database is available also when the cache can't be written.
+    auto content{serialize(*json_database, *json_stamp)};
+    save_atomically(cache_path, content);
+    auto database{MappedCompilationDatabase::load(llvm::MemoryBuffer::getMemBufferCopy(content, cache_path.string()),
+                                                  *json_stamp)};
+    if (database == nullptr)
+        throw Tsepepe::Error{"ERROR: Failed to build the compilation database cache: " + cache_path.string()};
+    return wrap_as_json_compilation_database(std::move(database));
+}
+
+} // namespace Tsepepe::utils::clang_ast
+
+// --------------------------------------------------------------------------------------------------------------------
+// Private definitions
+// --------------------------------------------------------------------------------------------------------------------
+std::unique_ptr<MappedCompilationDatabase> MappedCompilationDatabase::load(std::unique_ptr<llvm::MemoryBuffer> buffer,
+                                                                           const JsonStamp& json_stamp)
+{
+    auto data{buffer->getBufferStart()};
+    std::uint64_t size{buffer->getBufferSize()};
+    if (size < sizeof(Header) or reinterpret_cast<std::uintptr_t>(data) % cache_alignment != 0)
+        return nullptr;
+
+    const auto& header{*reinterpret_cast<const Header*>(data)};
+    if (header.magic != cache_magic or header.version != cache_version
+        or header.json_modification_time != json_stamp.modification_time or header.json_size != json_stamp.size
+        or not std::has_single_bit(header.buckets_count))
+        return nullptr;
+
+    // Checks that each section fits within the content, before it is accessed.
+    std::uint64_t offset{sizeof(Header)};
+    auto take_section{[&](std::uint64_t section_size) -> const char* {
+        if (section_size > size - offset)
+            return nullptr;
+        auto section{data + offset};
+        offset += section_size;
+        offset = std::min(size, (offset + cache_alignment - 1) / cache_alignment * cache_alignment);
+        return section;
+    }};
+
+    std::uint64_t strings_count{header.strings_count};
+    auto string_offsets{take_section((strings_count + 1) * sizeof(std::uint64_t))};
+    if (string_offsets == nullptr)
+        return nullptr;
+    auto string_offsets_span{
+        std::span{reinterpret_cast<const std::uint64_t*>(string_offsets), static_cast<std::size_t>(strings_count + 1)}};
+
+    auto string_data{take_section(string_offsets_span.back())};
+    auto commands{take_section(std::uint64_t{header.commands_count} * sizeof(Command))};
+    auto arguments{take_section(std::uint64_t{header.arguments_count} * sizeof(std::uint32_t))};
+    auto buckets{take_section(std::uint64_t{header.buckets_count} * sizeof(Bucket))};
+    if (string_data == nullptr or commands == nullptr or arguments == nullptr or buckets == nullptr or offset != size)
+        return nullptr;
+
+    std::unique_ptr<MappedCompilationDatabase> result{new MappedCompilationDatabase{std::move(buffer)}};
+    result->string_offsets = string_offsets_span;
+    result->string_data = string_data;
+    result->commands = {reinterpret_cast<const Command*>(commands), header.commands_count};
+    result->arguments = {reinterpret_cast<const std::uint32_t*>(arguments), header.arguments_count};
+    result->buckets = {reinterpret_cast<const Bucket*>(buckets), header.buckets_count};
+    return result;
+}
+
+MappedCompilationDatabase::MappedCompilationDatabase(std::unique_ptr<llvm::MemoryBuffer> content_) :
+    content{std::move(content_)}, string_data{nullptr}
+{
+}
+
+std::vector<CompileCommand> MappedCompilationDatabase::getCompileCommands(llvm::StringRef file_path) const
+{
+    auto file_key{make_file_key("", file_path)};
+
+    auto mask{buckets.size() - 1};
+    for (auto index{hash(file_key) & mask};; index = (index + 1) & mask)
+    {
+        const auto& bucket{buckets[index]};
+        if (bucket.commands_count == 0)
+            return {};
+
+        if (get_string(commands[bucket.first_command].file_key) != file_key)
+            continue;
+
+        std::vector<CompileCommand> result;
+        result.reserve(bucket.commands_count);
+        for (const auto& command : commands.subspan(bucket.first_command, bucket.commands_count))
+            result.emplace_back(make_compile_command(command));
+        return result;
+    }
+}
+
+std::vector<std::string> MappedCompilationDatabase::getAllFiles() const
+{
+    std::vector<std::string> result;
+    for (const auto& command : commands)
+    {
+        auto file_key{get_string(command.file_key)};
+        if (result.empty() or result.back() != file_key)
+            result.emplace_back(file_key.str());
+    }
+    return result;
+}
+
+std::vector<CompileCommand> MappedCompilationDatabase::getAllCompileCommands() const
+{
+    std::vector<CompileCommand> result;
+    result.reserve(commands.size());
+    for (const auto& command : commands)
+        result.emplace_back(make_compile_command(command));
+    return result;
+}
+
+llvm::StringRef MappedCompilationDatabase::get_string(std::uint32_t index) const
+{
+    auto begin{string_offsets[index]};
+    return {string_data + begin, static_cast<std::size_t>(string_offsets[index + 1] - begin)};
+}
+
+CompileCommand MappedCompilationDatabase::make_compile_command(const Command& command) const
+{
+    std::vector<std::string> command_line;
+    command_line.reserve(command.arguments_count);
+    for (auto argument : arguments.subspan(command.arguments_begin, command.arguments_count))
+        command_line.emplace_back(get_string(argument).str());
+
+    return CompileCommand{get_string(command.directory),
+                          get_string(command.file),
+                          std::move(command_line),
+                          get_string(command.output)};
+}
+
+LazilyInferringCompilationDatabase::LazilyInferringCompilationDatabase(std::unique_ptr<CompilationDatabase> database_) :
+    database{std::move(database_)}
+{
+}
+
+std::vector<CompileCommand> LazilyInferringCompilationDatabase::getCompileCommands(llvm::StringRef file_path) const
+{
+    auto result{database->getCompileCommands(file_path)};
+    if (not result.empty())
+        return result;
+    return get_inferring_database().getCompileCommands(file_path);
+}
+
+std::vector<std::string> LazilyInferringCompilationDatabase::getAllFiles() const
+{
+    return database->getAllFiles();
+}
+
+std::vector<CompileCommand> LazilyInferringCompilationDatabase::getAllCompileCommands() const
+{
+    return database->getAllCompileCommands();
+}
+
+const CompilationDatabase& LazilyInferringCompilationDatabase::get_inferring_database() const
+{
+    std::call_once(inferring_database_flag, [this]() {
+        inferring_database = inferMissingCompileCommands(std::make_unique<CompilationDatabaseReference>(*database));
+    });
+    return *inferring_database;
+}
+
+CompilationDatabaseReference::CompilationDatabaseReference(const CompilationDatabase& database_) : database{database_}
+{
+}
+
+std::vector<CompileCommand> CompilationDatabaseReference::getCompileCommands(llvm::StringRef file_path) const
+{
+    return database.getCompileCommands(file_path);
+}
+
+std::vector<std::string> CompilationDatabaseReference::getAllFiles() const
+{
+    return database.getAllFiles();
+}
+
+std::vector<CompileCommand> CompilationDatabaseReference::getAllCompileCommands() const
+{
+    return database.getAllCompileCommands();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Helper definitions
+// --------------------------------------------------------------------------------------------------------------------
+static std::optional<JsonStamp> get_json_stamp(const stdfs::path& path)
+{
+    struct stat status;
+    if (::stat(path.c_str(), &status) != 0)
+        return std::nullopt;
+
+    return JsonStamp{.modification_time =
+                         static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1'000'000'000 + status.st_mtim.tv_nsec,
+                     .size = static_cast<std::uint64_t>(status.st_size)};
+}
+
+static std::string serialize(const CompilationDatabase& database, const JsonStamp& json_stamp)
+{
+    std::vector<std::string_view> strings;
+    std::unordered_map<std::string_view, std::uint32_t> string_indexes;
+    // Keeps the interned strings alive, since the compile commands are returned by value.
+    auto all_compile_commands{database.getAllCompileCommands()};
+    std::vector<std::string> file_keys;
+    file_keys.reserve(all_compile_commands.size());
+    for (const auto& compile_command : all_compile_commands)
+        file_keys.emplace_back(make_file_key(compile_command.Directory, compile_command.Filename));
+
+    auto intern{[&](std::string_view string) {
+        auto [it, is_inserted] = string_indexes.try_emplace(string, static_cast<std::uint32_t>(strings.size()));
+        if (is_inserted)
+            strings.emplace_back(string);
+        return it->second;
+    }};
+
+    std::vector<Command> commands;
+    std::vector<std::uint32_t> arguments;
+    commands.reserve(all_compile_commands.size());
+    for (std::size_t i{0}; i < all_compile_commands.size(); ++i)
+    {
+        const auto& compile_command{all_compile_commands[i]};
+        Command command{.directory = intern(compile_command.Directory),
+                        .file = intern(compile_command.Filename),
+                        .output = intern(compile_command.Output),
+                        .file_key = intern(file_keys[i]),
+                        .arguments_begin = static_cast<std::uint32_t>(arguments.size()),
+                        .arguments_count = static_cast<std::uint32_t>(compile_command.CommandLine.size())};
+        for (const auto& argument : compile_command.CommandLine)
+            arguments.push_back(intern(argument));
+        commands.push_back(command);
+    }
+
+    // Groups the commands for the same file, keeping their order.
+    std::ranges::stable_sort(commands, {}, [&](const Command& command) { return strings[command.file_key]; });
+
+    std::vector<Bucket> buckets;
+    {
+        std::size_t files_count{0};
+        for (std::size_t i{0}; i < commands.size(); ++i)
+            if (i == 0 or commands[i].file_key != commands[i - 1].file_key)
+                ++files_count;
+
+        // Keeps the load factor at most 0.5, so that the probing sequences are short.
+        buckets.resize(std::bit_ceil(std::max<std::size_t>(1, files_count * 2)), Bucket{0, 0});
+        auto mask{buckets.size() - 1};
+        for (std::size_t i{0}; i < commands.size();)
+        {
+            auto end{i + 1};
+            while (end < commands.size() and commands[end].file_key == commands[i].file_key)
+                ++end;
+
+            auto index{hash(strings[commands[i].file_key]) & mask};
+            while (buckets[index].commands_count != 0)
+                index = (index + 1) & mask;
+            buckets[index] = Bucket{.first_command = static_cast<std::uint32_t>(i),
+                                    .commands_count = static_cast<std::uint32_t>(end - i)};
+            i = end;
+        }
+    }
+
+    std::string result;
+    auto append{[&result](const void* data, std::size_t size) {
+        result.append(static_cast<const char*>(data), size);
+        result.resize((result.size() + cache_alignment - 1) / cache_alignment * cache_alignment, '\0');
+    }};
+
+    Header header{.magic = cache_magic,
+                  .version = cache_version,
+                  .strings_count = static_cast<std::uint32_t>(strings.size()),
+                  .json_modification_time = json_stamp.modification_time,
+                  .json_size = json_stamp.size,
+                  .commands_count = static_cast<std::uint32_t>(commands.size()),
+                  .arguments_count = static_cast<std::uint32_t>(arguments.size()),
+                  .buckets_count = static_cast<std::uint32_t>(buckets.size()),
+                  .padding = 0};
+    append(&header, sizeof(header));
+
+    std::vector<std::uint64_t> string_offsets{0};
+    string_offsets.reserve(strings.size() + 1);
+    std::string string_data;
+    for (auto string : strings)
+    {
+        string_data.append(string);
+        string_offsets.push_back(string_data.size());
+    }
+    append(string_offsets.data(), string_offsets.size() * sizeof(std::uint64_t));
+    append(string_data.data(), string_data.size());
+    append(commands.data(), commands.size() * sizeof(Command));
+    append(arguments.data(), arguments.size() * sizeof(std::uint32_t));
+    append(buckets.data(), buckets.size() * sizeof(Bucket));
+    return result;
+}
+
+static bool save_atomically(const stdfs::path& path, const std::string& content)
+{
+    auto temporary_path{path};
+    temporary_path += ".tmp" + std::to_string(::getpid());
+
+    {
+        std::ofstream ofs{temporary_path, std::ios::binary};
+        ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (not ofs)
+        {
+            std::error_code ec;
+            stdfs::remove(temporary_path, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    stdfs::rename(temporary_path, path, ec);
+    if (ec)
+    {
+        stdfs::remove(temporary_path, ec);
+        return false;
+    }
+    return true;
+}
+
+static std::unique_ptr<CompilationDatabase> wrap_as_json_compilation_database(std::unique_ptr<CompilationDatabase> db)
+{
+    return inferTargetAndDriverMode(std::make_unique<LazilyInferringCompilationDatabase>(
+        expandResponseFiles(std::move(db), llvm::vfs::getRealFileSystem())));
+}
+
+static std::string make_file_key(llvm::StringRef directory, llvm::StringRef file)
+{
+    stdfs::path path{file.str()};
+    if (path.is_relative())
+        path = directory.empty() ? stdfs::absolute(path) : stdfs::path{directory.str()} / path;
+    return path.lexically_normal().string();
+}
+
+static std::uint64_t hash(std::string_view string)
+{
+    std::uint64_t result{14695981039346656037ull};
+    for (auto c : string)
+    {
+        result ^= static_cast<unsigned char>(c);
+        result *= 1099511628211ull;
+    }
+    return result;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file        compilation_database_cache.hpp
+ * @brief       Binary cache of the JSON compilation database.
+ */
+#ifndef COMPILATION_DATABASE_CACHE_HPP
+#define COMPILATION_DATABASE_CACHE_HPP
+
+#include <filesystem>
+#include <memory>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+namespace Tsepepe::utils::clang_ast
+{
+
+//! The name of the cache file, kept next to compile_commands.json.
+inline constexpr const char* compilation_database_cache_file_name{".tsepepe_compile_commands.cache"};
+
+/** @brief Loads compile_commands.json from the directory, through the binary cache.
+ *
+ * The cache is memory-mapped: the arguments and the paths are interned, and the commands are looked up by the file
+ * path through a hash table stored in the cache, so nothing is parsed on load, and getCompileCommands() takes
+ * constant time. The cache is built again, when the modification time or the size of compile_commands.json differs
+ * from the ones the cache has been built from. When the cache can't be written, the database is still returned.
+ *
+ * The commands for the files, which are missing in the database, are inferred from the similar files, the same way
+ * as clang::tooling::CompilationDatabase::loadFromDirectory() does it.
+ *
+ * Throws, when compile_commands.json doesn't exist, or can't be parsed.
+ */
+std::unique_ptr<clang::tooling::CompilationDatabase>
+load_cached_compilation_database(const std::filesystem::path& directory_with_compilation_database);
+
+} // namespace Tsepepe::utils::clang_ast
+
+#endif /* COMPILATION_DATABASE_CACHE_HPP */
@@ -4,32 +4,25 @@
  */
 
 #include "clang_ast_utils.hpp"
-#include "error.hpp"
+#include "compilation_database_cache.hpp"
 #include "filesystem_utils.hpp"
 
+#include "trace.hpp"
+
 namespace Tsepepe::utils::clang_ast
 {
 
 std::unique_ptr<clang::tooling::CompilationDatabase>
 parse_compilation_database(const std::filesystem::path& directory_with_compilation_database)
 {
+    TraceSpan span{"parse_compilation_database", directory_with_compilation_database.string()};
+
     using namespace Tsepepe::utils::fs;
     parse_and_validate_path(directory_with_compilation_database);
     auto comp_db_path{directory_with_compilation_database / "compile_commands.json"};
     parse_and_validate_path(comp_db_path);
 
-    std::string err;
-    auto r{clang::tooling::CompilationDatabase::loadFromDirectory(directory_with_compilation_database.string(), err)};
-    if (!r)
-    {
-        std::string msg;
-        msg.reserve(100 + err.size());
-        msg.append("ERROR: While parsing compilation database, from clang::tooling::CompilationDatabase: ");
-        msg.append(std::move(err));
-        throw Tsepepe::Error{std::move(msg)};
-    }
-
-    return r;
+    return load_cached_compilation_database(directory_with_compilation_database);
 }
 
 } // namespace Tsepepe::utils::clang_ast
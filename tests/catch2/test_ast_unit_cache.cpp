@@ -0,0 +1,246 @@
+/**
+ * @file	test_ast_unit_cache.cpp
+ * @brief	Tests the AstUnitCache.
+ */
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "ast_unit_cache.hpp"
+#include "directory_tree.hpp"
+
+using namespace Tsepepe;
+using namespace clang::ast_matchers;
+namespace fs = std::filesystem;
+
+static clang::tooling::CompilationDatabase& get_compilation_database()
+{
+    std::string err;
+    static std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database{
+        clang::tooling::CompilationDatabase::loadFromDirectory(COMPILATION_DATABASE_DIR, err)};
+    if (compilation_database == nullptr)
+        throw std::runtime_error{"Failed to load the compilation database: " + err};
+    return *compilation_database;
+}
+
+static std::size_t count_matches(clang::ASTUnit& ast_unit, const DeclarationMatcher& matcher)
+{
+    return match(matcher, ast_unit.getASTContext()).size();
+}
+
+//! The files modified right before the AST is built are never assumed to be up to date, since they might have been
+//! modified while being parsed, so the files are made older.
+static fs::path create_old_file(DirectoryTree& dir_tree, const fs::path& relative_path, const std::string& content)
+{
+    auto path{dir_tree.create_file(relative_path, content)};
+    fs::last_write_time(path, fs::last_write_time(path) - std::chrono::seconds{10});
+    return path;
+}
+
+TEST_CASE("ASTs are reused until the files change", "[AstUnitCache]")
+{
+    auto& compilation_database{get_compilation_database()};
+
+    DirectoryTree dir_tree{"temp_ast_unit_cache_reuse"};
+    create_old_file(dir_tree, "base.hpp", "struct Base {};\n");
+    auto derived_path{create_old_file(dir_tree, "derived.hpp", "#include \"base.hpp\"\n\nstruct Derived : Base {};\n")};
+    auto other_path{create_old_file(dir_tree, "other.hpp", "struct Other {};\n")};
+
+    AstUnitCache cache;
+    auto ast_unit{cache.get(compilation_database, derived_path)};
+    auto other_ast_unit{cache.get(compilation_database, other_path)};
+
+    SECTION("The AST of the unchanged file is reused")
+    {
+        REQUIRE(cache.get(compilation_database, derived_path) == ast_unit);
+
+        auto statistics{cache.get_statistics()};
+        REQUIRE(statistics.hits == 1);
+        REQUIRE(statistics.misses == 2);
+        REQUIRE(statistics.invalidations == 0);
+        REQUIRE(statistics.memory_usage > 0);
+    }
+
+    SECTION("The AST is built again, when an included file changes")
+    {
+        dir_tree.create_file("base.hpp", "struct Base { int changed; };\n");
+
+        REQUIRE(cache.get(compilation_database, derived_path) != ast_unit);
+        REQUIRE(cache.get(compilation_database, other_path) == other_ast_unit);
+
+        auto statistics{cache.get_statistics()};
+        REQUIRE(statistics.hits == 1);
+        REQUIRE(statistics.misses == 3);
+        REQUIRE(statistics.invalidations == 1);
+    }
+
+    SECTION("Only the ASTs depending on the evicted file are dropped")
+    {
+        cache.evict({dir_tree.get_root_absolute_path() / "base.hpp"});
+
+        REQUIRE(cache.get(compilation_database, derived_path) != ast_unit);
+        REQUIRE(cache.get(compilation_database, other_path) == other_ast_unit);
+        REQUIRE(cache.get_statistics().invalidations == 1);
+    }
+}
+
+TEST_CASE("Only the ASTs depending on the watched files alone are not checked for the changes", "[AstUnitCache]")
+{
+    auto& compilation_database{get_compilation_database()};
+
+    DirectoryTree dir_tree{"temp_ast_unit_cache_watched"};
+    create_old_file(dir_tree, "generated.hpp", "struct Generated {};\n");
+    auto derived_path{
+        create_old_file(dir_tree, "derived.hpp", "#include \"generated.hpp\"\n\nstruct Derived : Generated {};\n")};
+    auto other_path{create_old_file(dir_tree, "other.hpp", "struct Other {};\n")};
+
+    AstUnitCache cache;
+    cache.set_watched_file_predicate([](const fs::path& path) { return path.filename() != "generated.hpp"; });
+    auto ast_unit{cache.get(compilation_database, derived_path)};
+    auto other_ast_unit{cache.get(compilation_database, other_path)};
+
+    // The watched file changes are told with evict(), so the change of the other file goes unnoticed.
+    dir_tree.create_file("generated.hpp", "struct Generated { int changed; };\n");
+    dir_tree.create_file("other.hpp", "struct Other { int changed; };\n");
+
+    REQUIRE(cache.get(compilation_database, derived_path) != ast_unit);
+    REQUIRE(cache.get(compilation_database, other_path) == other_ast_unit);
+}
+
+TEST_CASE("The least recently used ASTs are dropped, when the memory budget is exceeded", "[AstUnitCache]")
+{
+    auto& compilation_database{get_compilation_database()};
+
+    DirectoryTree dir_tree{"temp_ast_unit_cache_budget"};
+    auto first_path{create_old_file(dir_tree, "first.hpp", "struct First {};\n")};
+    auto second_path{create_old_file(dir_tree, "second.hpp", "struct Second {};\n")};
+    auto third_path{create_old_file(dir_tree, "third.hpp", "struct Third {};\n")};
+
+    std::size_t ast_unit_memory_usage{0};
+    {
+        AstUnitCache unbounded_cache;
+        unbounded_cache.get(compilation_database, first_path);
+        ast_unit_memory_usage = unbounded_cache.get_statistics().memory_usage;
+    }
+
+    // The ASTs of the similar files take about the same memory, so only two of them fit.
+    AstUnitCache cache{ast_unit_memory_usage * 5 / 2};
+    auto first_ast_unit{cache.get(compilation_database, first_path)};
+    auto second_ast_unit{cache.get(compilation_database, second_path)};
+    REQUIRE(cache.get(compilation_database, first_path) == first_ast_unit);
+
+    cache.get(compilation_database, third_path);
+
+    auto statistics{cache.get_statistics()};
+    REQUIRE(statistics.evictions == 1);
+    REQUIRE(statistics.memory_usage <= ast_unit_memory_usage * 5 / 2);
+    REQUIRE(cache.get(compilation_database, first_path) == first_ast_unit);
+    REQUIRE(cache.get(compilation_database, second_path) != second_ast_unit);
+}
+
+TEST_CASE("ASTs built with the unsaved files are keyed by the unsaved content", "[AstUnitCache]")
+{
+    auto& compilation_database{get_compilation_database()};
+
+    DirectoryTree dir_tree{"temp_ast_unit_cache_unsaved"};
+    auto base_path{create_old_file(dir_tree, "base.hpp", "struct Base {};\n")};
+    auto derived_path{create_old_file(dir_tree, "derived.hpp", "#include \"base.hpp\"\n\nstruct Derived : Base {};\n")};
+
+    std::string first_content{"struct Base { virtual void run() = 0; };\n"};
+    std::string second_content{"struct Base { virtual void stop() = 0; };\n"};
+
+    AstUnitCache cache;
+    auto first_ast_unit{
+        cache.get(compilation_database, derived_path, {{.path = base_path, .content = first_content}})};
+    auto second_ast_unit{
+        cache.get(compilation_database, derived_path, {{.path = base_path, .content = second_content}})};
+
+    REQUIRE(first_ast_unit != second_ast_unit);
+    REQUIRE(count_matches(*first_ast_unit, cxxMethodDecl(hasName("run"))) == 1);
+    REQUIRE(count_matches(*second_ast_unit, cxxMethodDecl(hasName("stop"))) == 1);
+
+    // The content is compared, not only its address.
+    std::string first_content_copy{first_content};
+    REQUIRE(cache.get(compilation_database, derived_path, {{.path = base_path, .content = first_content_copy}})
+            == first_ast_unit);
+    REQUIRE(cache.get(compilation_database, derived_path) != first_ast_unit);
+
+    auto statistics{cache.get_statistics()};
+    REQUIRE(statistics.hits == 1);
+    REQUIRE(statistics.misses == 3);
+}
+
+TEST_CASE("ASTs of the edited files are reparsed with the preamble reused", "[AstUnitCache]")
+{
+    auto& compilation_database{get_compilation_database()};
+
+    DirectoryTree dir_tree{"temp_ast_unit_cache_reparse"};
+    dir_tree.create_file("base.hpp", "struct Base {};\n");
+    auto source_file_path{dir_tree.get_root_absolute_path() / "derived.hpp"};
+
+    std::string first_content{"#include \"base.hpp\"\n\nstruct Derived : Base {};\n"};
+
+    AstUnitCache cache;
+    auto first_ast_unit{
+        cache.get(compilation_database, source_file_path, {{.path = source_file_path, .content = first_content}})};
+    REQUIRE(count_matches(*first_ast_unit, cxxRecordDecl(hasName("Derived"), isDerivedFrom("Base"))) == 1);
+    auto first_ast_unit_address{first_ast_unit.get()};
+
+    SECTION("The content after the preamble is taken from the latest call")
+    {
+        first_ast_unit.reset();
+
+        std::string content{"#include \"base.hpp\"\n\nstruct Other : Base {};\nvoid fun(Base);\n"};
+        auto ast_unit{
+            cache.get(compilation_database, source_file_path, {{.path = source_file_path, .content = content}})};
+
+        REQUIRE(ast_unit.get() == first_ast_unit_address);
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Derived"))) == 0);
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Other"), isDerivedFrom("Base"))) == 1);
+        REQUIRE(count_matches(*ast_unit, functionDecl(hasName("fun"))) == 1);
+    }
+
+    SECTION("The AST still used elsewhere is not reparsed")
+    {
+        std::string content{"#include \"base.hpp\"\n\nstruct Other : Base {};\n"};
+        auto ast_unit{
+            cache.get(compilation_database, source_file_path, {{.path = source_file_path, .content = content}})};
+
+        REQUIRE(ast_unit.get() != first_ast_unit.get());
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Other"))) == 1);
+        REQUIRE(count_matches(*first_ast_unit, cxxRecordDecl(hasName("Derived"))) == 1);
+    }
+
+    SECTION("The changed preamble is taken into account")
+    {
+        first_ast_unit.reset();
+        dir_tree.create_file("other_base.hpp", "struct OtherBase {};\n");
+
+        std::string content{
+            "#include \"base.hpp\"\n#include \"other_base.hpp\"\n\nstruct Derived : Base, OtherBase {};\n"};
+        auto ast_unit{
+            cache.get(compilation_database, source_file_path, {{.path = source_file_path, .content = content}})};
+
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Derived"), isDerivedFrom("OtherBase"))) == 1);
+    }
+
+    SECTION("The changed included file is taken into account")
+    {
+        first_ast_unit.reset();
+        dir_tree.create_file("base.hpp", "struct Base {};\nstruct NewBase {};\n");
+
+        std::string content{"#include \"base.hpp\"\n\nstruct Derived : NewBase {};\n"};
+        auto ast_unit{
+            cache.get(compilation_database, source_file_path, {{.path = source_file_path, .content = content}})};
+
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Derived"), isDerivedFrom("NewBase"))) == 1);
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file	test_class_index.cpp
+ * @brief	Tests the persistent class index.
+ */
+#include <filesystem>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "class_index.hpp"
+#include "directory_tree.hpp"
+
+using namespace Tsepepe;
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Class index maps class names to the definitions", "[ClassIndex]")
+{
+    DirectoryTree dir_tree{"temp_class_index"};
+    auto iface_path{dir_tree.create_file("include/iface.hpp", "struct Iface { virtual void f() = 0; };")};
+    auto impl_path{dir_tree.create_file("src/impl.hpp", "namespace ns { struct Iface {}; struct Impl {}; }")};
+    auto root{dir_tree.get_root_absolute_path()};
+
+    ClassIndex index{root};
+    index.update_file(
+        iface_path,
+        *get_file_stamp(iface_path),
+        {ClassIndexEntry{.name = "Iface", .fully_qualified_name = "Iface", .offset = 7, .is_abstract = true}});
+    index.update_file(impl_path,
+                      *get_file_stamp(impl_path),
+                      {ClassIndexEntry{.name = "Iface",
+                                       .fully_qualified_name = "ns::Iface",
+                                       .offset = 22,
+                                       .is_abstract = false},
+                       ClassIndexEntry{.name = "Impl",
+                                       .fully_qualified_name = "ns::Impl",
+                                       .offset = 42,
+                                       .is_abstract = false,
+                                       .has_bases = true}});
+
+    std::vector<ClassIndexEntry> expected_ifaces{
+        {.name = "Iface", .fully_qualified_name = "Iface", .path = iface_path, .offset = 7, .is_abstract = true},
+        {.name = "Iface", .fully_qualified_name = "ns::Iface", .path = impl_path, .offset = 22, .is_abstract = false}};
+
+    SECTION("Finds all the classes with the name")
+    {
+        REQUIRE_THAT(index.find("Iface"), Catch::Matchers::UnorderedEquals(expected_ifaces));
+        REQUIRE(index.find("Yolo").empty());
+        REQUIRE(index.is_modified());
+    }
+
+    SECTION("Files are up to date until they change")
+    {
+        REQUIRE(index.is_up_to_date(iface_path));
+        REQUIRE(index.is_up_to_date(impl_path));
+
+        dir_tree.create_file("src/impl.hpp", "namespace ns { struct Impl {}; }");
+
+        REQUIRE(index.is_up_to_date(iface_path));
+        REQUIRE_FALSE(index.is_up_to_date(impl_path));
+        REQUIRE_FALSE(index.is_up_to_date(root / "src/not_indexed.hpp"));
+    }
+
+    SECTION("Updating a file replaces its definitions")
+    {
+        index.update_file(impl_path, *get_file_stamp(impl_path), {});
+
+        REQUIRE_THAT(index.find("Iface"), Catch::Matchers::Equals(std::vector{expected_ifaces[0]}));
+        REQUIRE(index.find("Impl").empty());
+    }
+
+    SECTION("Removed file is no longer indexed")
+    {
+        index.remove_file(iface_path);
+
+        REQUIRE_THAT(index.find("Iface"), Catch::Matchers::Equals(std::vector{expected_ifaces[1]}));
+        REQUIRE_THAT(index.get_indexed_files(), Catch::Matchers::Equals(std::vector{impl_path}));
+    }
+
+    SECTION("Index is stored and loaded")
+    {
+        REQUIRE_FALSE(ClassIndex::load(root));
+
+        index.save();
+        REQUIRE_FALSE(index.is_modified());
+        REQUIRE(fs::exists(root / ".tsepepe" / "class_index"));
+
+        auto loaded{ClassIndex::load(root)};
+        REQUIRE(loaded);
+        REQUIRE_FALSE(loaded->is_modified());
+        REQUIRE_THAT(loaded->find("Iface"), Catch::Matchers::UnorderedEquals(expected_ifaces));
+        REQUIRE(loaded->find("Impl").size() == 1);
+        REQUIRE(loaded->find("Impl").at(0).has_bases);
+        REQUIRE(loaded->is_up_to_date(iface_path));
+        REQUIRE(loaded->is_up_to_date(impl_path));
+    }
+
+    SECTION("Merging takes the files indexed, or updated, by the other index only")
+    {
+        auto other_path{dir_tree.create_file("src/other.hpp", "struct Other {};")};
+        dir_tree.create_file("src/impl.hpp", "namespace ns { struct Impl {}; }");
+
+        ClassIndex other{root};
+        other.update_file(
+            other_path,
+            *get_file_stamp(other_path),
+            {ClassIndexEntry{.name = "Other", .fully_qualified_name = "Other", .offset = 7, .is_abstract = false}});
+        other.update_file(impl_path,
+                          *get_file_stamp(impl_path),
+                          {ClassIndexEntry{.name = "Impl",
+                                           .fully_qualified_name = "ns::Impl",
+                                           .offset = 22,
+                                           .is_abstract = false}});
+        other.update_file(iface_path, FileStamp{}, {});
+
+        index.merge(other);
+
+        REQUIRE(index.find("Other").size() == 1);
+        REQUIRE(index.is_up_to_date(impl_path));
+        REQUIRE(index.find("Impl").at(0).offset == 22);
+        REQUIRE_THAT(index.find("Iface"), Catch::Matchers::Equals(std::vector{expected_ifaces[0]}));
+    }
+
+    SECTION("Index stored with another format version is not loaded")
+    {
+        dir_tree.create_file(".tsepepe/class_index", "tsepepe-class-index 0\n");
+        REQUIRE_FALSE(ClassIndex::load(root));
+    }
+}
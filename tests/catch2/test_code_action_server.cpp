@@ -0,0 +1,193 @@
+/**
+ * @file        test_code_action_server.cpp
+ * @brief       Tests the code action server, which is run by the daemon.
+ */
+#include <filesystem>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "base_error.hpp"
+#include "code_action_client.hpp"
+#include "code_action_protocol.hpp"
+#include "code_action_server.hpp"
+#include "unix_socket.hpp"
+
+static std::shared_ptr<clang::tooling::CompilationDatabase> load_test_compilation_database(const std::filesystem::path&)
+{
+    std::string err;
+    std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database{
+        clang::tooling::CompilationDatabase::loadFromDirectory(COMPILATION_DATABASE_DIR, err)};
+    if (compilation_database == nullptr)
+        throw std::runtime_error{"Failed to load the compilation database: " + err};
+    return compilation_database;
+}
+
+TEST_CASE("Code action requests and responses are serialized", "[CodeActionServer]")
+{
+    using namespace Tsepepe;
+
+    SECTION("Implement interface request")
+    {
+        CodeActionRequest request{.compilation_database_directory = "/some/build",
+                                  .parameters = ImplementInterfaceCodeActionParameters{
+                                      .root_directory = "/some",
+                                      .source_file_path = "/some/file.hpp",
+                                      .source_file_content = "struct Yolo\n{\n};\n",
+                                      .inteface_name = "Interface",
+                                      .cursor_position_line = 2}};
+
+        auto serialized{serialize(request)};
+        REQUIRE(serialized.find('\n') == std::string::npos);
+
+        auto deserialized{deserialize_code_action_request(serialized)};
+        REQUIRE(deserialized.compilation_database_directory == "/some/build");
+
+        auto params{std::get<ImplementInterfaceCodeActionParameters>(deserialized.parameters)};
+        REQUIRE(params.root_directory == "/some");
+        REQUIRE(params.source_file_path == "/some/file.hpp");
+        REQUIRE(params.source_file_content == "struct Yolo\n{\n};\n");
+        REQUIRE(params.inteface_name == "Interface");
+        REQUIRE(params.cursor_position_line == 2);
+    }
+
+    SECTION("Generate function definitions request")
+    {
+        CodeActionRequest request{.compilation_database_directory = "/some/build",
+                                  .parameters = GenerateFunctionDefinitionsCodeActionParameters{
+                                      .source_file_path = "/some/file.hpp",
+                                      .source_file_content = "void foo();\nvoid bar();\n",
+                                      .selected_line_begin = 1,
+                                      .selected_line_end = 2}};
+
+        auto params{std::get<GenerateFunctionDefinitionsCodeActionParameters>(
+            deserialize_code_action_request(serialize(request)).parameters)};
+        REQUIRE(params.source_file_path == "/some/file.hpp");
+        REQUIRE(params.source_file_content == "void foo();\nvoid bar();\n");
+        REQUIRE(params.selected_line_begin == 1);
+        REQUIRE(params.selected_line_end == 2);
+    }
+
+    SECTION("Responses")
+    {
+        auto result{deserialize_code_action_response(serialize(CodeActionResponse{.content = "void foo()\n{\n}\n"}))};
+        REQUIRE(result.content == "void foo()\n{\n}\n");
+        REQUIRE_FALSE(result.is_error);
+
+        auto error{deserialize_code_action_response(
+            serialize(CodeActionResponse{.content = "Something went wrong", .is_error = true}))};
+        REQUIRE(error.content == "Something went wrong");
+        REQUIRE(error.is_error);
+    }
+
+    SECTION("Malformed request")
+    {
+        REQUIRE_THROWS_AS(deserialize_code_action_request("{\"method\": "), BaseError);
+        REQUIRE_THROWS_AS(deserialize_code_action_request("{\"method\": \"yolo\"}"), BaseError);
+        REQUIRE_THROWS_AS(deserialize_code_action_request("{\"method\": \"implement_interface\", \"params\": {}}"),
+                          BaseError);
+    }
+}
+
+TEST_CASE("Code action server serves the code actions", "[CodeActionServer]")
+{
+    using namespace Tsepepe;
+
+    CodeActionServer server{load_test_compilation_database};
+
+    GenerateFunctionDefinitionsCodeActionParameters generate_definitions_params{
+        .source_file_path = std::filesystem::temp_directory_path(),
+        .source_file_content = "void foo(int a);\n",
+        .selected_line_begin = 1,
+        .selected_line_end = 1};
+    CodeActionRequest generate_definitions_request{.compilation_database_directory = COMPILATION_DATABASE_DIR,
+                                                   .parameters = generate_definitions_params};
+
+    SECTION("Single request")
+    {
+        auto response{deserialize_code_action_response(server.handle(serialize(generate_definitions_request)))};
+        REQUIRE_FALSE(response.is_error);
+        REQUIRE(response.content == "void foo(int a)\n{\n}\n");
+    }
+
+    SECTION("Error is reported within the response")
+    {
+        auto request{generate_definitions_request};
+        auto& params{std::get<GenerateFunctionDefinitionsCodeActionParameters>(request.parameters)};
+        params.selected_line_begin = 2;
+        params.selected_line_end = 1;
+
+        auto response{deserialize_code_action_response(server.handle(serialize(request)))};
+        REQUIRE(response.is_error);
+        REQUIRE(response.content == "Selected line range must have the end line be past the begin line!");
+        REQUIRE_FALSE(server.is_shutdown_requested());
+    }
+
+    SECTION("AST cache statistics are reported without the compilation database")
+    {
+        auto response{deserialize_code_action_response(
+            server.handle(serialize(CodeActionRequest{.parameters = StatisticsParameters{}})))};
+        REQUIRE_FALSE(response.is_error);
+        REQUIRE(response.content
+                == R"({"evictions":0,"hits":0,"invalidations":0,"memory_usage":0,"misses":0})");
+    }
+
+    SECTION("Multiple requests over a stream, until shutdown")
+    {
+        std::stringstream input;
+        input << serialize(generate_definitions_request) << '\n'
+              << serialize(generate_definitions_request) << '\n'
+              << serialize(CodeActionRequest{.parameters = ShutdownParameters{}}) << '\n'
+              << serialize(generate_definitions_request) << '\n';
+        std::stringstream output;
+
+        server.serve(input, output);
+
+        REQUIRE(server.is_shutdown_requested());
+
+        std::string line;
+        std::vector<CodeActionResponse> responses;
+        while (std::getline(output, line))
+            responses.emplace_back(deserialize_code_action_response(line));
+
+        REQUIRE(responses.size() == 3);
+        REQUIRE(responses[0].content == "void foo(int a)\n{\n}\n");
+        REQUIRE(responses[1].content == "void foo(int a)\n{\n}\n");
+        REQUIRE_FALSE(responses[2].is_error);
+    }
+
+    SECTION("Requests over a Unix domain socket")
+    {
+        auto socket_path{std::filesystem::temp_directory_path() / "tsepepe_test_daemon.sock"};
+        std::jthread server_thread{[&] { server.serve(socket_path); }};
+
+        // Retry until the server starts listening.
+        std::optional<CodeActionResponse> response;
+        while (not response)
+        {
+            try
+            {
+                response = send_code_action_request(socket_path, generate_definitions_request);
+            } catch (const BaseError&)
+            {
+                std::this_thread::yield();
+            }
+        }
+        REQUIRE(response->content == "void foo(int a)\n{\n}\n");
+
+        // The client goes away without reading the response, which fails to be written.
+        UnixSocket::connect(socket_path).write_line(serialize(generate_definitions_request));
+        REQUIRE(send_code_action_request(socket_path, generate_definitions_request).content
+                == "void foo(int a)\n{\n}\n");
+
+        send_code_action_request(socket_path, {.parameters = ShutdownParameters{}});
+        server_thread.join();
+
+        REQUIRE_FALSE(std::filesystem::exists(socket_path));
+    }
+}
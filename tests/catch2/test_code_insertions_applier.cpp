@@ -7,6 +7,7 @@
 
 #include "base_error.hpp"
 #include "code_insertions_applier.hpp"
+#include "directory_tree.hpp"
 
 using namespace Tsepepe;
 
@@ -90,3 +91,24 @@ TEST_CASE("Code insertions are applied", "[CodeInsertionApplier]")
                             "Code insertion: \"you. \", at offset 7, out of bounds");
     }
 }
+
+TEST_CASE("Code insertions are applied to the file on disk", "[CodeInsertionApplier]")
+{
+    DirectoryTree dir_tree{"temp_code_insertions_applier"};
+    auto path{dir_tree.create_file("file.hpp", "struct Foo\n{\n};\n")};
+
+    SECTION("Rewrites the file with the insertions applied")
+    {
+        apply_insertions_in_place({.path = path,
+                                   .insertions = {{.code = "    void foo();\n", .offset = 13},
+                                                  {.code = "#include <string>\n", .offset = 0}}});
+        REQUIRE(dir_tree.load_file("file.hpp") == "#include <string>\nstruct Foo\n{\n    void foo();\n};\n");
+    }
+
+    SECTION("Throws, when the file doesn't exist")
+    {
+        REQUIRE_THROWS_AS(
+            apply_insertions_in_place({.path = path.parent_path() / "missing.hpp", .insertions = {{.code = "x"}}}),
+            BaseError);
+    }
+}
@@ -2,7 +2,11 @@
  * @file	test_codebase_grepper.cpp
  * @brief	Tests grepping through the codebase.
  */
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <stdexcept>
+#include <thread>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
@@ -69,3 +73,100 @@ TEST_CASE("Finds strings within a project", "[CodebaseGrepper]")
         }
     }
 }
+
+TEST_CASE("Skips the files, which ripgrep would skip", "[CodebaseGrepper]")
+{
+    DirectoryTree dir_tree("temp");
+    auto root{dir_tree.get_root_absolute_path()};
+    dir_tree.create_file("src/symbol.cpp", "struct Symbol {};");
+    dir_tree.create_file("src/symbol.txt", "struct Symbol {};");
+    dir_tree.create_file("src/.hidden.hpp", "struct Symbol {};");
+    dir_tree.create_file(".hidden/symbol.hpp", "struct Symbol {};");
+    dir_tree.create_file("build/generated.hpp", "struct Symbol {};");
+    dir_tree.create_file("src/nested/generated.hpp", "struct Symbol {};");
+    dir_tree.create_file("src/nested/kept.hpp", "struct Symbol {};");
+    dir_tree.create_file("src/template.hpp.in", "struct Symbol {};");
+    dir_tree.create_file("src/binary.cpp", std::string{"struct Symbol {};\0", 18});
+    dir_tree.create_file(".gitignore", "build/\n*.hpp\n!kept.hpp\n");
+    dir_tree.create_file("src/nested/.gitignore", "!generated.hpp\n");
+
+    RootDirectory root_dir{root};
+    EcmaScriptPattern pattern{"\\b(struct|class)\\s+Symbol\\b"};
+
+    // Makes the directory the root of a git repository, so that the .gitignore files are respected.
+    dir_tree.create_file(".git/HEAD", "");
+
+    REQUIRE_THAT(codebase_grep(root_dir, pattern),
+                 Catch::Matchers::Equals(std::vector<GrepMatch>{
+                     {.path = root / "src/nested/generated.hpp", .line = 1, .column = 1},
+                     {.path = root / "src/nested/kept.hpp", .line = 1, .column = 1},
+                     {.path = root / "src/symbol.cpp", .line = 1, .column = 1},
+                     {.path = root / "src/template.hpp.in", .line = 1, .column = 1}}));
+}
+
+TEST_CASE("Respects the .gitignore rules of the parent directories, when walking a subdirectory", "[CodebaseGrepper]")
+{
+    DirectoryTree dir_tree("temp");
+    auto root{dir_tree.get_root_absolute_path()};
+    dir_tree.create_file("src/symbol.cpp", "struct Symbol {};");
+    dir_tree.create_file("src/generated.hpp", "struct Symbol {};");
+    dir_tree.create_file("src/build/symbol.cpp", "struct Symbol {};");
+    dir_tree.create_file(".gitignore", "generated.hpp\nbuild/\n");
+    dir_tree.create_file(".git/HEAD", "");
+
+    REQUIRE_THAT(codebase_grep(RootDirectory{root / "src"}, EcmaScriptPattern{"\\bSymbol\\b"}),
+                 Catch::Matchers::Equals(
+                     std::vector<GrepMatch>{{.path = root / "src/symbol.cpp", .line = 1, .column = 8}}));
+    REQUIRE(is_directory_skipped_by_codebase_walk(root / "src/build"));
+    REQUIRE(is_directory_skipped_by_codebase_walk(root / ".git"));
+    REQUIRE_FALSE(is_directory_skipped_by_codebase_walk(root / "src"));
+}
+
+TEST_CASE("Finds all the matches within a line", "[CodebaseGrepper]")
+{
+    DirectoryTree dir_tree("temp");
+    auto root{dir_tree.get_root_absolute_path()};
+    dir_tree.create_file("a.hpp", "\nstruct Symbol; class Symbol;\n\nstruct\nSymbol\n");
+
+    SECTION("Pattern, which can be searched over the entire file")
+    {
+        REQUIRE_THAT(codebase_grep(RootDirectory{root}, EcmaScriptPattern{"\\b(struct|class)\\s+Symbol\\b"}),
+                     Catch::Matchers::Equals(std::vector<GrepMatch>{
+                         {.path = root / "a.hpp", .line = 2, .column = 1},
+                         {.path = root / "a.hpp", .line = 2, .column = 16}}));
+    }
+
+    SECTION("Pattern without a literal, which every match contains")
+    {
+        // The matches do not overlap.
+        REQUIRE_THAT(codebase_grep(RootDirectory{root}, EcmaScriptPattern{"(Symbol;|ct\\s+S)"}),
+                     Catch::Matchers::Equals(std::vector<GrepMatch>{
+                         {.path = root / "a.hpp", .line = 2, .column = 5},
+                         {.path = root / "a.hpp", .line = 2, .column = 22}}));
+    }
+
+    SECTION("Pattern with line anchors")
+    {
+        REQUIRE_THAT(
+            codebase_grep(RootDirectory{root}, EcmaScriptPattern{"^Symbol$"}),
+            Catch::Matchers::Equals(std::vector<GrepMatch>{{.path = root / "a.hpp", .line = 5, .column = 1}}));
+    }
+}
+
+TEST_CASE("Exception thrown by a visitor stops the walk and is rethrown", "[CodebaseGrepper]")
+{
+    DirectoryTree dir_tree("temp");
+    auto root{dir_tree.get_root_absolute_path()};
+    for (unsigned i{0}; i < 64; ++i)
+        dir_tree.create_file("dir" + std::to_string(i % 8) + "/file" + std::to_string(i) + ".hpp", "");
+
+    std::atomic<unsigned> visited_files_count{0};
+    REQUIRE_THROWS_AS(walk_codebase(RootDirectory{root},
+                                    [&](const std::filesystem::path&) -> bool {
+                                        ++visited_files_count;
+                                        throw std::runtime_error{"Visitor failed"};
+                                    }),
+                      std::runtime_error);
+    // Each thread finishes the file it's visiting at most.
+    REQUIRE(visited_files_count <= std::max(1u, std::thread::hardware_concurrency()));
+}
@@ -0,0 +1,111 @@
+/**
+ * @file	test_compilation_database_cache.cpp
+ * @brief	Tests the binary cache of the JSON compilation database.
+ */
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "compilation_database_cache.hpp"
+#include "directory_tree.hpp"
+#include "error.hpp"
+
+using namespace Tsepepe;
+using namespace Tsepepe::utils::clang_ast;
+
+namespace fs = std::filesystem;
+
+static std::string make_compilation_database(const fs::path& root, const std::vector<std::string>& files)
+{
+    std::string result{"["};
+    for (const auto& file : files)
+    {
+        if (result.size() > 1)
+            result += ",";
+        result += R"({"directory": ")" + root.string() + R"(", "file": ")" + file + R"(", "arguments": ["clang++", )"
+                  R"("-DFILE_)" + std::to_string(result.size()) + R"(", "-c", ")" + file + R"("]})";
+    }
+    result += "]";
+    return result;
+}
+
+TEST_CASE("Compilation database is loaded through the binary cache", "[CompilationDatabaseCache]")
+{
+    DirectoryTree dir_tree{"temp_compilation_database_cache"};
+    auto root{dir_tree.get_root_absolute_path()};
+    dir_tree.create_file("compile_commands.json",
+                         make_compilation_database(root, {"src/a.cpp", (root / "src/b.cpp").string(), "c.cpp"}));
+    auto cache_path{root / compilation_database_cache_file_name};
+
+    auto database{load_cached_compilation_database(root)};
+
+    SECTION("The cache is written next to the JSON compilation database")
+    {
+        REQUIRE(fs::exists(cache_path));
+    }
+
+    SECTION("Commands are found by the absolute path of the file")
+    {
+        auto commands{database->getCompileCommands((root / "src" / "b.cpp").string())};
+
+        REQUIRE(commands.size() == 1);
+        REQUIRE(commands[0].Directory == root.string());
+        REQUIRE(commands[0].Filename == (root / "src/b.cpp").string());
+        REQUIRE(commands[0].CommandLine.size() == 4);
+        REQUIRE(commands[0].CommandLine.back() == (root / "src/b.cpp").string());
+    }
+
+    SECTION("Files specified relatively to the directory are found by the absolute path")
+    {
+        auto commands{database->getCompileCommands((root / "src" / "a.cpp").string())};
+
+        REQUIRE(commands.size() == 1);
+        REQUIRE(commands[0].Filename == "src/a.cpp");
+    }
+
+    SECTION("All files and commands are listed")
+    {
+        REQUIRE(database->getAllFiles().size() == 3);
+        REQUIRE(database->getAllCompileCommands().size() == 3);
+    }
+
+    SECTION("Commands are the same, when loaded from the cache")
+    {
+        auto reloaded_database{load_cached_compilation_database(root)};
+
+        auto path{(root / "c.cpp").string()};
+        REQUIRE(reloaded_database->getCompileCommands(path)[0].CommandLine
+                == database->getCompileCommands(path)[0].CommandLine);
+    }
+
+    SECTION("Commands for the missing files are inferred")
+    {
+        REQUIRE_FALSE(database->getCompileCommands((root / "src" / "a.hpp").string()).empty());
+    }
+
+    SECTION("The cache is built again, when the JSON compilation database changes")
+    {
+        dir_tree.create_file("compile_commands.json", make_compilation_database(root, {"src/d.cpp"}));
+
+        auto rebuilt_database{load_cached_compilation_database(root)};
+
+        REQUIRE(rebuilt_database->getAllFiles() == std::vector<std::string>{(root / "src/d.cpp").string()});
+    }
+
+    SECTION("The corrupted cache is built again")
+    {
+        dir_tree.create_file(compilation_database_cache_file_name, "garbage");
+
+        auto rebuilt_database{load_cached_compilation_database(root)};
+
+        REQUIRE(rebuilt_database->getAllFiles().size() == 3);
+        REQUIRE(fs::file_size(cache_path) > 7);
+    }
+
+    SECTION("Throws, when there is no JSON compilation database")
+    {
+        REQUIRE_THROWS_AS(load_cached_compilation_database(root / "src"), Tsepepe::Error);
+    }
+}
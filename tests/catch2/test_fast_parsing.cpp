@@ -0,0 +1,75 @@
+/**
+ * @file	test_fast_parsing.cpp
+ * @brief	Tests the fast parsing mode.
+ */
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "directory_tree.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+
+TEST_CASE("Function bodies are skipped in the fast parsing mode", "[FastParsing]")
+{
+    using namespace Tsepepe;
+    using namespace clang::ast_matchers;
+
+    std::string err;
+    static std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database{
+        clang::tooling::CompilationDatabase::loadFromDirectory(COMPILATION_DATABASE_DIR, err)};
+    if (compilation_database == nullptr)
+        throw std::runtime_error{"Failed to load the compilation database: " + err};
+
+    DirectoryTree dir_tree{"temp_fast_parsing"};
+    dir_tree.create_file("base.hpp",
+                         "struct Base\n"
+                         "{\n"
+                         "    virtual void pure() = 0;\n"
+                         "    int inline_fun() { return 1; }\n"
+                         "};\n");
+    auto source_file_path{dir_tree.get_root_absolute_path() / "derived.hpp"};
+    std::string content{"#include \"base.hpp\"\n"
+                        "constexpr int constexpr_fun() { return 2; }\n"
+                        "inline auto deduced_fun() { return 3; }\n"
+                        "struct Derived : Base\n"
+                        "{\n"
+                        "    void fun(int a) { a += constexpr_fun(); }\n"
+                        "};\n"};
+
+    auto count_matches{[](clang::ASTUnit& ast_unit, const auto& matcher) {
+        return match(matcher, ast_unit.getASTContext()).size();
+    }};
+
+    auto ast_unit{build_ast_from_memory(*compilation_database, source_file_path, content)};
+    auto fast_ast_unit{
+        build_ast_from_memory(*compilation_database, source_file_path, content, {.skip_function_bodies = true})};
+
+    SECTION("The bodies are skipped, but the functions are still definitions")
+    {
+        for (auto name : {"inline_fun", "fun"})
+        {
+            REQUIRE(count_matches(*ast_unit, functionDecl(hasName(name), hasBody(compoundStmt()))) == 1);
+            REQUIRE(count_matches(*fast_ast_unit, functionDecl(hasName(name), hasBody(compoundStmt()))) == 0);
+            REQUIRE(count_matches(*fast_ast_unit, functionDecl(hasName(name), isDefinition())) == 1);
+        }
+    }
+
+    SECTION("The bodies of the constexpr functions, and the ones with the deduced return type, are kept")
+    {
+        for (auto name : {"constexpr_fun", "deduced_fun"})
+            REQUIRE(count_matches(*fast_ast_unit, functionDecl(hasName(name), hasBody(compoundStmt()))) == 1);
+    }
+
+    SECTION("The declarations are the same")
+    {
+        auto matcher{cxxRecordDecl(hasName("Derived"),
+                                   isDerivedFrom("Base"),
+                                   hasMethod(cxxMethodDecl(hasName("fun"), hasParameter(0, hasName("a")))))};
+        REQUIRE(count_matches(*fast_ast_unit, matcher) == 1);
+        REQUIRE(count_matches(*fast_ast_unit, cxxMethodDecl(hasName("pure"), isPure())) == 1);
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * @file	test_file_grepper.cpp
+ * @brief	Tests grepping the file content.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "file_grepper.hpp"
+
+using namespace Tsepepe;
+
+TEST_CASE("Finds the lines with a match within the file content", "[FileGrepper]")
+{
+    std::string content{"struct Yolo\n{\n    void foo();\n    void bar(); void baz();\n};\n\nvoid foo()\n{\n}"};
+
+    SECTION("No match")
+    {
+        REQUIRE(grep_file(content, RustRegexPattern{"class"}).empty());
+    }
+
+    SECTION("Each line is reported once")
+    {
+        REQUIRE_THAT(grep_file(content, RustRegexPattern{"void\\s+\\w+\\(\\)"}),
+                     Catch::Matchers::Equals(FileGrepMatches{3, 4, 7}));
+    }
+
+    SECTION("Matches the last line without the trailing newline")
+    {
+        REQUIRE_THAT(grep_file(content, RustRegexPattern{"^}$"}), Catch::Matchers::Equals(FileGrepMatches{9}));
+    }
+
+    SECTION("Without multiline mode a match does not span multiple lines")
+    {
+        REQUIRE(grep_file(content, RustRegexPattern{"foo\\(\\)\\s+\\{"}).empty());
+    }
+
+    SECTION("With multiline mode, all the lines spanned by the match are reported")
+    {
+        REQUIRE_THAT(grep_file(content, RustRegexPattern{"foo\\(\\)\\s+\\{\\s+}"}, {.enable_multiline_regex = 1}),
+                     Catch::Matchers::Equals(FileGrepMatches{7, 8, 9}));
+    }
+
+    SECTION("With multiline mode, line anchors match at line boundaries")
+    {
+        REQUIRE_THAT(grep_file(content, RustRegexPattern{"^\\{$"}, {.enable_multiline_regex = 1}),
+                     Catch::Matchers::Equals(FileGrepMatches{2, 8}));
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file	test_file_watcher.cpp
+ * @brief	Tests the inotify based file watcher.
+ */
+#include <chrono>
+#include <filesystem>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "directory_tree.hpp"
+#include "file_watcher.hpp"
+
+using namespace Tsepepe;
+
+namespace fs = std::filesystem;
+
+static constexpr std::chrono::milliseconds timeout{1000};
+
+TEST_CASE("File watcher reports the changed files in a batch", "[FileWatcher]")
+{
+    DirectoryTree dir_tree{"temp_file_watcher"};
+    auto header_path{dir_tree.create_file("include/foo.hpp", "")};
+    auto source_path{dir_tree.create_file("src/foo.cpp", "")};
+    dir_tree.create_file(".hidden/foo.hpp", "");
+    auto root{fs::canonical(dir_tree.get_root_absolute_path())};
+    header_path = root / "include/foo.hpp";
+    source_path = root / "src/foo.cpp";
+
+    FileWatcher watcher{root};
+
+    SECTION("No changes when nothing has happened")
+    {
+        REQUIRE(watcher.read_changes().empty());
+    }
+
+    SECTION("Modified and added files are reported together")
+    {
+        dir_tree.create_file("include/foo.hpp", "struct Foo {};");
+        auto added_path{dir_tree.create_file("src/bar.cpp", "")};
+        dir_tree.create_file("src/foo.cpp", "#include \"foo.hpp\"");
+
+        auto changes{watcher.read_changes(timeout)};
+
+        REQUIRE(changes.files == std::set{header_path, root / "src/bar.cpp", source_path});
+        REQUIRE(changes.directories == std::set{root / "src"});
+        REQUIRE(changes.removed_directories.empty());
+        REQUIRE_FALSE(changes.is_overflowed);
+        REQUIRE(watcher.read_changes().empty());
+    }
+
+    SECTION("Files within the new directories are reported and watched")
+    {
+        dir_tree.create_file("lib/nested/baz.hpp", "");
+        auto changes{watcher.read_changes(timeout)};
+        REQUIRE(changes.files.contains(root / "lib/nested/baz.hpp"));
+        REQUIRE(changes.directories.contains(root));
+
+        dir_tree.create_file("lib/nested/baz.hpp", "struct Baz {};");
+        REQUIRE(watcher.read_changes(timeout).files == std::set{root / "lib/nested/baz.hpp"});
+    }
+
+    SECTION("Removed directories are reported")
+    {
+        fs::remove_all(root / "src");
+
+        auto changes{watcher.read_changes(timeout)};
+
+        REQUIRE(changes.removed_directories == std::set{root / "src"});
+        REQUIRE(changes.directories.contains(root));
+    }
+
+    SECTION("New directories ignored by git are not watched")
+    {
+        dir_tree.create_file(".git/HEAD", "");
+        dir_tree.create_file(".gitignore", "build/\n");
+        dir_tree.create_file("build/generated.hpp", "");
+
+        auto changes{watcher.read_changes(timeout)};
+        REQUIRE(changes.directories.contains(root));
+        REQUIRE(changes.files.empty());
+
+        dir_tree.create_file("build/generated.hpp", "struct Generated {};");
+        REQUIRE(watcher.read_changes(std::chrono::milliseconds{100}).empty());
+    }
+
+    SECTION("Tells whether the changes of a file are reported")
+    {
+        REQUIRE(watcher.is_watched(header_path));
+        REQUIRE(watcher.is_watched(root / "src/not_yet_created.cpp"));
+        REQUIRE_FALSE(watcher.is_watched(root / ".hidden/foo.hpp"));
+        REQUIRE_FALSE(watcher.is_watched(root / "include/.foo.hpp.swp"));
+        REQUIRE_FALSE(watcher.is_watched(root.parent_path() / "foo.hpp"));
+
+        fs::remove_all(root / "src");
+        watcher.read_changes(timeout);
+        REQUIRE_FALSE(watcher.is_watched(source_path));
+    }
+
+    SECTION("Hidden files are not reported")
+    {
+        dir_tree.create_file(".hidden/foo.hpp", "struct Foo {};");
+        dir_tree.create_file("include/.foo.hpp.swp", "");
+        REQUIRE(watcher.read_changes(std::chrono::milliseconds{100}).empty());
+    }
+}
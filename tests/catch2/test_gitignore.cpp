@@ -0,0 +1,88 @@
+/**
+ * @file	test_gitignore.cpp
+ * @brief	Tests matching the paths against the .gitignore rules.
+ */
+#include <memory>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "gitignore.hpp"
+
+using namespace Tsepepe;
+
+TEST_CASE("Paths are matched against the .gitignore rules", "[GitIgnore]")
+{
+    SECTION("Rules without a slash match the file name at any depth")
+    {
+        GitIgnore gitignore{"*.o\nbuild\n", "/project"};
+
+        REQUIRE(gitignore.is_ignored("/project/main.o", false));
+        REQUIRE(gitignore.is_ignored("/project/src/deep/main.o", false));
+        REQUIRE(gitignore.is_ignored("/project/src/build", true));
+        REQUIRE(gitignore.is_ignored("/project/build", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/main.cpp", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/builder", true));
+    }
+
+    SECTION("Rules with a slash are relative to the .gitignore location")
+    {
+        GitIgnore gitignore{"/build\nsrc/*.hpp\n", "/project"};
+
+        REQUIRE(gitignore.is_ignored("/project/build", true));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/src/build", true));
+        REQUIRE(gitignore.is_ignored("/project/src/a.hpp", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/src/nested/a.hpp", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/other/src/a.hpp", false));
+    }
+
+    SECTION("Double asterisk matches any number of directories")
+    {
+        GitIgnore gitignore{"**/generated\nsrc/**/*.inl\n", "/project"};
+
+        REQUIRE(gitignore.is_ignored("/project/generated", true));
+        REQUIRE(gitignore.is_ignored("/project/a/b/generated", true));
+        REQUIRE(gitignore.is_ignored("/project/src/a.inl", false));
+        REQUIRE(gitignore.is_ignored("/project/src/a/b/c.inl", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/a.inl", false));
+    }
+
+    SECTION("Rules with a trailing slash match only directories")
+    {
+        GitIgnore gitignore{"out/\n", "/project"};
+
+        REQUIRE(gitignore.is_ignored("/project/out", true));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/out", false));
+    }
+
+    SECTION("Last matching rule wins")
+    {
+        GitIgnore gitignore{"*.hpp\n!keep.hpp\n", "/project"};
+
+        REQUIRE(gitignore.is_ignored("/project/a.hpp", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/keep.hpp", false));
+    }
+
+    SECTION("Comments, blank lines and character classes")
+    {
+        GitIgnore gitignore{"# *.cpp\n\n  \n*.[oa]\nfile[!0-9].txt  \n\\#hash\n", "/project"};
+
+        REQUIRE_FALSE(gitignore.is_ignored("/project/main.cpp", false));
+        REQUIRE(gitignore.is_ignored("/project/main.o", false));
+        REQUIRE(gitignore.is_ignored("/project/libmain.a", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/main.so", false));
+        REQUIRE(gitignore.is_ignored("/project/filex.txt", false));
+        REQUIRE_FALSE(gitignore.is_ignored("/project/file1.txt", false));
+        REQUIRE(gitignore.is_ignored("/project/#hash", false));
+    }
+
+    SECTION("Rules from the nested .gitignore file take precedence over the parent ones")
+    {
+        auto parent{std::make_shared<const GitIgnore>("*.hpp\n", "/project")};
+        GitIgnore nested{"!*.hpp\n*.cpp\n", "/project/src", parent};
+
+        REQUIRE_FALSE(nested.is_ignored("/project/src/a.hpp", false));
+        REQUIRE(nested.is_ignored("/project/src/a.cpp", false));
+        REQUIRE(nested.is_ignored("/project/a.hpp", false));
+        REQUIRE_FALSE(nested.is_ignored("/project/a.cpp", false));
+    }
+}
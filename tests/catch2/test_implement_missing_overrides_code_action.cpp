@@ -0,0 +1,206 @@
+/**
+ * @file        test_implement_missing_overrides_code_action.cpp
+ * @brief       Tests the implement missing overrides code action.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "ast_unit_cache.hpp"
+#include "base_error.hpp"
+#include "code_insertions_applier.hpp"
+#include "directory_tree.hpp"
+#include "implement_missing_overrides_code_action.hpp"
+
+using namespace Tsepepe;
+namespace fs = std::filesystem;
+
+TEST_CASE("Missing overrides are implemented in all the implementors", "[ImplementMissingOverridesCodeAction]")
+{
+    DirectoryTree directory_tree{"temp_implement_missing_overrides"};
+    auto root{directory_tree.get_root_absolute_path()};
+
+    std::string error_message;
+    std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database{
+        clang::tooling::CompilationDatabase::loadFromDirectory(
+            COMPILATION_DATABASE_DIR, // Supplied within CMakeLists.txt
+            error_message)};
+    if (compilation_database == nullptr)
+        throw std::runtime_error{"Failed to load compilation database from: " COMPILATION_DATABASE_DIR ": "
+                                 + error_message};
+
+    ImplementMissingOverridesCodeActionLibclangBased code_action{compilation_database};
+
+    directory_tree.create_file("include/runnable.hpp",
+                               "namespace Tasks\n"
+                               "{\n"
+                               "struct Runnable\n"
+                               "{\n"
+                               "    virtual void run() = 0;\n"
+                               "    virtual int stop(unsigned timeout_ms) = 0;\n"
+                               "};\n"
+                               "} // namespace Tasks\n");
+
+    SECTION("Declares the missing overrides in each implementor")
+    {
+        std::string maker_content{"#include \"runnable.hpp\"\n"
+                                  "\n"
+                                  "struct Maker : Tasks::Runnable\n"
+                                  "{\n"
+                                  "    void run() override;\n"
+                                  "};\n"};
+        std::string runner_content{"#include \"../include/runnable.hpp\"\n"
+                                   "\n"
+                                   "namespace Tasks\n"
+                                   "{\n"
+                                   "class Runner : public Runnable\n"
+                                   "{\n"
+                                   "  public:\n"
+                                   "    Runner();\n"
+                                   "\n"
+                                   "  private:\n"
+                                   "    int state;\n"
+                                   "};\n"
+                                   "} // namespace Tasks\n"};
+        auto maker_path{directory_tree.create_file("include/maker.hpp", maker_content)};
+        auto runner_path{directory_tree.create_file("src/runner.hpp", runner_content)};
+        directory_tree.create_file("include/done.hpp",
+                                   "#include \"runnable.hpp\"\n"
+                                   "\n"
+                                   "struct Done : Tasks::Runnable\n"
+                                   "{\n"
+                                   "    void run() override;\n"
+                                   "    int stop(unsigned) override;\n"
+                                   "};\n");
+
+        auto result{code_action.apply({.root_directory = root, .interface_name = "Runnable"})};
+
+        REQUIRE(result.size() == 2);
+        REQUIRE(result[0].path == maker_path);
+        REQUIRE(apply_insertions(maker_content, result[0].insertions)
+                == "#include \"runnable.hpp\"\n"
+                   "\n"
+                   "struct Maker : Tasks::Runnable\n"
+                   "{\n"
+                   "    void run() override;\n"
+                   "    int stop(unsigned int timeout_ms) override;\n"
+                   "};\n");
+        REQUIRE(result[1].path == runner_path);
+        REQUIRE(apply_insertions(runner_content, result[1].insertions)
+                == "#include \"../include/runnable.hpp\"\n"
+                   "\n"
+                   "namespace Tasks\n"
+                   "{\n"
+                   "class Runner : public Runnable\n"
+                   "{\n"
+                   "  public:\n"
+                   "    Runner();\n"
+                   "    void run() override;\n"
+                   "    int stop(unsigned int timeout_ms) override;\n"
+                   "\n"
+                   "  private:\n"
+                   "    int state;\n"
+                   "};\n"
+                   "} // namespace Tasks\n");
+    }
+
+    SECTION("Declares the overrides only in the base implementor, when the implementors derive from each other")
+    {
+        auto maker_path{directory_tree.create_file("include/maker.hpp",
+                                                   "#include \"runnable.hpp\"\n"
+                                                   "\n"
+                                                   "struct Maker : Tasks::Runnable\n"
+                                                   "{\n"
+                                                   "    void run() override;\n"
+                                                   "};\n")};
+        directory_tree.create_file("include/fast_maker.hpp",
+                                   "#include \"maker.hpp\"\n"
+                                   "\n"
+                                   "// Implements Tasks::Runnable through Maker.\n"
+                                   "struct FastMaker : Maker\n"
+                                   "{\n"
+                                   "};\n");
+
+        auto result{code_action.apply({.root_directory = root, .interface_name = "Runnable"})};
+
+        REQUIRE(result.size() == 1);
+        REQUIRE(result[0].path == maker_path);
+        REQUIRE(result[0].insertions.size() == 1);
+        REQUIRE(result[0].insertions[0].code == "    int stop(unsigned int timeout_ms) override;\n");
+    }
+
+    SECTION("Skips the classes, which declare the pure virtual functions on their own, but not the derived ones")
+    {
+        directory_tree.create_file("include/pausable.hpp",
+                                   "#include \"runnable.hpp\"\n"
+                                   "\n"
+                                   "struct Pausable : Tasks::Runnable\n"
+                                   "{\n"
+                                   "    virtual void pause() = 0;\n"
+                                   "};\n");
+        auto pausable_maker_path{directory_tree.create_file("include/pausable_maker.hpp",
+                                                            "#include \"pausable.hpp\"\n"
+                                                            "\n"
+                                                            "// Implements Tasks::Runnable through Pausable.\n"
+                                                            "struct PausableMaker : Pausable\n"
+                                                            "{\n"
+                                                            "    void pause() override;\n"
+                                                            "    void run() override;\n"
+                                                            "};\n")};
+
+        auto result{code_action.apply({.root_directory = root, .interface_name = "Runnable"})};
+
+        REQUIRE(result.size() == 1);
+        REQUIRE(result[0].path == pausable_maker_path);
+        REQUIRE(result[0].insertions.size() == 1);
+        REQUIRE(result[0].insertions[0].code == "    int stop(unsigned int timeout_ms) override;\n");
+    }
+
+    SECTION("Declares the missing overrides after the last public method, which is defined inline")
+    {
+        std::string worker_content{"#include \"runnable.hpp\"\n"
+                                   "\n"
+                                   "class Worker : public Tasks::Runnable\n"
+                                   "{\n"
+                                   "  public:\n"
+                                   "    bool is_busy() const\n"
+                                   "    {\n"
+                                   "        return busy;\n"
+                                   "    }\n"
+                                   "\n"
+                                   "  private:\n"
+                                   "    bool busy;\n"
+                                   "};\n"};
+        auto worker_path{directory_tree.create_file("include/worker.hpp", worker_content)};
+        std::string expected_worker_content{"#include \"runnable.hpp\"\n"
+                                            "\n"
+                                            "class Worker : public Tasks::Runnable\n"
+                                            "{\n"
+                                            "  public:\n"
+                                            "    bool is_busy() const\n"
+                                            "    {\n"
+                                            "        return busy;\n"
+                                            "    }\n"
+                                            "    void run() override;\n"
+                                            "    int stop(unsigned int timeout_ms) override;\n"
+                                            "\n"
+                                            "  private:\n"
+                                            "    bool busy;\n"
+                                            "};\n"};
+
+        // Both with, and without, the cache, which skips the function bodies by default.
+        ImplementMissingOverridesCodeActionLibclangBased cached_code_action{compilation_database,
+                                                                           std::make_shared<AstUnitCache>()};
+        for (auto* action : {&code_action, &cached_code_action})
+        {
+            auto result{action->apply({.root_directory = root, .interface_name = "Runnable"})};
+
+            REQUIRE(result.size() == 1);
+            REQUIRE(result[0].path == worker_path);
+            REQUIRE(apply_insertions(worker_content, result[0].insertions) == expected_worker_content);
+        }
+    }
+
+    SECTION("Error when interface not found")
+    {
+        REQUIRE_THROWS_AS(code_action.apply({.root_directory = root, .interface_name = "Missing"}), BaseError);
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file	test_in_memory_source_file.cpp
+ * @brief	Tests parsing the source file content from memory.
+ */
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "directory_tree.hpp"
+#include "libclang_utils/in_memory_source_file.hpp"
+
+TEST_CASE("AST is built from the source file content kept in memory", "[InMemorySourceFile]")
+{
+    using namespace Tsepepe;
+    using namespace clang::ast_matchers;
+    namespace fs = std::filesystem;
+
+    std::string err;
+    static std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database{
+        clang::tooling::CompilationDatabase::loadFromDirectory(COMPILATION_DATABASE_DIR, err)};
+    if (compilation_database == nullptr)
+        throw std::runtime_error{"Failed to load the compilation database: " + err};
+
+    DirectoryTree dir_tree{"temp_in_memory_source_file"};
+    dir_tree.create_file("base.hpp", "struct Base {};\n");
+    auto root{dir_tree.get_root_absolute_path()};
+    auto source_file_path{root / "derived.hpp"};
+    std::string content{"#include \"base.hpp\"\nstruct Derived : Base {};\n"};
+
+    auto count_matches{[](clang::ASTUnit& ast_unit, const auto& matcher) {
+        return match(matcher, ast_unit.getASTContext()).size();
+    }};
+
+    SECTION("The file is not written to disk, while the included files are read from disk")
+    {
+        auto ast_unit{build_ast_from_memory(*compilation_database, source_file_path, content)};
+
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Derived"), isDerivedFrom("Base"))) == 1);
+        REQUIRE_FALSE(fs::exists(source_file_path));
+        REQUIRE(std::distance(fs::directory_iterator{root}, fs::directory_iterator{}) == 1);
+    }
+
+    SECTION("The content overrides the one on disk")
+    {
+        dir_tree.create_file("derived.hpp", "struct Old {};\n");
+
+        auto ast_unit{build_ast_from_memory(*compilation_database, source_file_path, content)};
+
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Derived"))) == 1);
+        REQUIRE(count_matches(*ast_unit, cxxRecordDecl(hasName("Old"))) == 0);
+        REQUIRE(dir_tree.load_file("derived.hpp") == "struct Old {};\n");
+    }
+
+    SECTION("For a directory, the file within the directory is assumed")
+    {
+        REQUIRE(get_in_memory_source_file_path(root, "some_id") == root / ".tsepepe_some_id_temp.hpp");
+        REQUIRE(get_in_memory_source_file_path(source_file_path, "some_id") == source_file_path);
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file	test_include_graph.cpp
+ * @brief	Tests the include graph.
+ */
+#include <set>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "include_graph.hpp"
+
+using namespace Tsepepe;
+
+TEST_CASE("Include graph tells which translation units depend on a file", "[IncludeGraph]")
+{
+    IncludeGraph graph;
+    graph.set_included_files("/project/src/runner.cpp",
+                             {"/project/src/runner.cpp", "/project/include/runner.hpp", "/project/include/task.hpp"});
+    graph.set_included_files("/project/src/maker.cpp",
+                             {"/project/src/maker.cpp", "/project/include/maker.hpp", "/project/include/task.hpp"});
+    graph.set_included_files("/project/include/task.hpp", {"/project/include/task.hpp"});
+
+    SECTION("Translation units including the header, directly or not, and the one built from it")
+    {
+        REQUIRE(graph.get_dependent_translation_units("/project/include/task.hpp")
+                == std::set<std::string>{
+                    "/project/include/task.hpp", "/project/src/maker.cpp", "/project/src/runner.cpp"});
+        REQUIRE(graph.get_dependent_translation_units("/project/include/runner.hpp")
+                == std::set<std::string>{"/project/src/runner.cpp"});
+        REQUIRE(graph.get_dependent_translation_units("/project/include/unrelated.hpp").empty());
+    }
+
+    SECTION("Translation units depending on any file within a directory")
+    {
+        REQUIRE(graph.get_dependent_translation_units("/project/src")
+                == std::set<std::string>{"/project/src/maker.cpp", "/project/src/runner.cpp"});
+        REQUIRE(graph.get_dependent_translation_units("/project/sr").empty());
+    }
+
+    SECTION("Included files are replaced")
+    {
+        graph.set_included_files("/project/src/runner.cpp",
+                                 {"/project/src/runner.cpp", "/project/include/runner.hpp"});
+
+        REQUIRE(graph.get_dependent_translation_units("/project/include/task.hpp")
+                == std::set<std::string>{"/project/include/task.hpp", "/project/src/maker.cpp"});
+        REQUIRE(graph.get_included_files("/project/src/runner.cpp").size() == 2);
+    }
+
+    SECTION("Removed translation unit no longer depends on anything")
+    {
+        graph.remove_translation_unit("/project/src/maker.cpp");
+
+        REQUIRE(graph.get_dependent_translation_units("/project/include/maker.hpp").empty());
+        REQUIRE(graph.get_included_files("/project/src/maker.cpp").empty());
+        REQUIRE(graph.get_dependent_translation_units("/project/include/task.hpp")
+                == std::set<std::string>{"/project/include/task.hpp", "/project/src/runner.cpp"});
+    }
+}
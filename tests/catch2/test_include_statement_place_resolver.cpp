@@ -182,6 +182,28 @@ TEST_CASE("A new include place is resolved", "[IncludeStatementPlaceResolver]")
                                         "\n"
                                         "#endif /* MASTAA */\n",
                  .expected_result = {.offset = 275, .is_newline_needed = false}},
+        TestData{.description = "Skips the include statements within the block comments",
+                 .header_file_content = "#include <string>\n"
+                                        "/*\n"
+                                        "#include \"temp/yolo.hpp\"\n"
+                                        "*/\n"
+                                        "/* #include \"temp/dummy.hpp\" */\n"
+                                        "class Gimme\n"
+                                        "{\n"
+                                        "};\n",
+                 .expected_result = {.offset = 18, .is_newline_needed = true}},
+        TestData{.description = "Resolves to the line with the last include, with spaces around the hash",
+                 .header_file_content = "#pragma once\n"
+                                        "\n"
+                                        "  #  include \"temp/yolo.hpp\" // Yolo.\n"
+                                        "\n"
+                                        "class Gimme;\n",
+                 .expected_result = {.offset = 52, .is_newline_needed = false}},
+        TestData{.description =
+                     "Needs a newline, when the last include is in the last line, without a trailing newline",
+                 .header_file_content = "#include \"temp/yolo.hpp\"\n"
+                                        "#include \"temp/dummy.hpp\"",
+                 .expected_result = {.offset = 50, .is_newline_needed = true}},
     }));
 
     INFO(description);
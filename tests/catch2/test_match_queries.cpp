@@ -0,0 +1,76 @@
+/**
+ * @file        test_match_queries.cpp
+ * @brief       Tests running multiple matchers within a single traversal of the AST.
+ */
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Tooling/Tooling.h>
+
+#include "libclang_utils/match_queries.hpp"
+
+using namespace Tsepepe;
+using namespace clang::ast_matchers;
+
+static std::vector<std::string> get_names(const MatchQueries::Matches& matches, const std::string& id)
+{
+    std::vector<std::string> result;
+    for (const auto& match : matches)
+        result.push_back(match.getNodeAs<clang::NamedDecl>(id)->getNameAsString());
+    return result;
+}
+
+TEST_CASE("Multiple matchers are run within a single traversal of the AST", "[MatchQueries]")
+{
+    auto ast_unit{clang::tooling::buildASTFromCodeWithArgs("struct Interface\n"
+                                                           "{\n"
+                                                           "    virtual void run() = 0;\n"
+                                                           "};\n"
+                                                           "struct Runner : Interface\n"
+                                                           "{\n"
+                                                           "    void run() override;\n"
+                                                           "    void stop();\n"
+                                                           "};\n"
+                                                           "void free_function();\n",
+                                                           {"-std=gnu++20"})};
+    auto& context{ast_unit->getASTContext()};
+
+    MatchQueries queries;
+    auto classes{queries.add(cxxRecordDecl(isDefinition(), unless(isImplicit())).bind("class"))};
+    auto methods{queries.add(cxxMethodDecl(unless(isImplicit())).bind("method"))};
+    auto functions{queries.add(functionDecl(unless(cxxMethodDecl())).bind("function"))};
+    auto enums{queries.add(enumDecl().bind("enum"))};
+
+    queries.run(context);
+
+    SECTION("The matches of each matcher are collected separately")
+    {
+        REQUIRE(get_names(queries.get_matches(classes), "class") == std::vector<std::string>{"Interface", "Runner"});
+        REQUIRE(get_names(queries.get_matches(methods), "method")
+                == std::vector<std::string>{"run", "run", "stop"});
+        REQUIRE(get_names(queries.get_matches(functions), "function") == std::vector<std::string>{"free_function"});
+        REQUIRE(queries.get_matches(enums).empty());
+    }
+
+    SECTION("The matches are the same as the ones found with separate traversals")
+    {
+        auto separately_matched_methods{match(cxxMethodDecl(unless(isImplicit())).bind("method"), context)};
+
+        REQUIRE(queries.get_matches(methods).size() == separately_matched_methods.size());
+        for (std::size_t i{0}; i < separately_matched_methods.size(); ++i)
+            REQUIRE(queries.get_matches(methods)[i].getNodeAs<clang::CXXMethodDecl>("method")
+                    == separately_matched_methods[i].getNodeAs<clang::CXXMethodDecl>("method"));
+    }
+
+    SECTION("The matches from the previous run are discarded")
+    {
+        queries.run(context);
+
+        REQUIRE(queries.get_matches(classes).size() == 2);
+        REQUIRE(queries.get_matches(functions).size() == 1);
+    }
+}
@@ -11,6 +11,8 @@
 #include <clang/Tooling/CompilationDatabase.h>
 
 #include "base_error.hpp"
+#include "code_insertions_applier.hpp"
+#include "directory_tree.hpp"
 #include "generate_function_definitions_code_action.hpp"
 
 namespace MultipleFunctionDefinitionsGeneratorTest
@@ -278,3 +280,120 @@ TEST_CASE("Multiple function definitions are generated at once", "[FunctionDefin
         }
     }
 }
+
+TEST_CASE("Missing function definitions are generated for the entire header", "[FunctionDefinitionGenerator]")
+{
+    using namespace Tsepepe;
+    namespace fs = std::filesystem;
+
+    std::string err;
+    static std::shared_ptr<clang::tooling::CompilationDatabase> compilation_database{
+        clang::tooling::CompilationDatabase::loadFromDirectory(COMPILATION_DATABASE_DIR, err)};
+    if (compilation_database == nullptr)
+        throw std::runtime_error{"Failed to load the compilation database: " + err};
+
+    DirectoryTree dir_tree{"temp_missing_function_definitions"};
+    auto root{dir_tree.get_root_absolute_path()};
+    auto header_file_path{root / "boo.hpp"};
+    // The header on disk is outdated, the content in memory is used instead.
+    dir_tree.create_file("boo.hpp", "struct Boo {};\n");
+
+    std::string header_file_content{"#include <string>\n"
+                                    "\n"
+                                    "class Boo\n"
+                                    "{\n"
+                                    "  public:\n"
+                                    "    explicit Boo(int);\n"
+                                    "    virtual ~Boo();\n"
+                                    "\n"
+                                    "    std::string name() const;\n"
+                                    "    int defined_inline() { return 0; }\n"
+                                    "    virtual void pure() = 0;\n"
+                                    "    template<typename T> void templated(T);\n"
+                                    "    static int count;\n"
+                                    "\n"
+                                    "  private:\n"
+                                    "    friend bool operator==(const Boo&, const Boo&);\n"
+                                    "};\n"
+                                    "\n"
+                                    "namespace detail\n"
+                                    "{\n"
+                                    "void free_function(const Boo&);\n"
+                                    "void free_function(const Boo&);\n"
+                                    "inline void inline_function();\n"
+                                    "constexpr int constexpr_function();\n"
+                                    "}\n"};
+
+    auto apply{[&]() {
+        return GenerateFunctionDefinitionsCodeActionLibclangBased{compilation_database}.apply(
+            GenerateMissingFunctionDefinitionsCodeActionParameters{.header_file_path = header_file_path,
+                                                                   .header_file_content = header_file_content,
+                                                                   .paired_source_file_path = root / "boo.cpp"});
+    }};
+
+    SECTION("Appends the definitions of the functions, not defined within the source file")
+    {
+        std::string source_file_content{"#include \"boo.hpp\"\n"
+                                        "\n"
+                                        "Boo::~Boo()\n"
+                                        "{\n"
+                                        "}\n"};
+        dir_tree.create_file("boo.cpp", source_file_content);
+
+        auto insertions{apply()};
+
+        REQUIRE(insertions.size() == 1);
+        REQUIRE(apply_insertions(source_file_content, insertions)
+                == source_file_content
+                       + "\n"
+                         "Boo::Boo(int)\n"
+                         "{\n"
+                         "}\n"
+                         "\n"
+                         "std::string Boo::name() const\n"
+                         "{\n"
+                         "}\n"
+                         "\n"
+                         "void detail::free_function(const Boo &)\n"
+                         "{\n"
+                         "}\n");
+    }
+
+    SECTION("Separates the definitions with an empty line, when the source file doesn't end with a newline")
+    {
+        dir_tree.create_file("boo.cpp",
+                             "#include \"boo.hpp\"\n"
+                             "Boo::Boo(int) {}\n"
+                             "Boo::~Boo() {}\n"
+                             "void detail::free_function(const Boo&) {}");
+
+        auto insertions{apply()};
+
+        REQUIRE(insertions.size() == 1);
+        REQUIRE(insertions.front().code
+                == "\n"
+                   "\n"
+                   "std::string Boo::name() const\n"
+                   "{\n"
+                   "}\n");
+    }
+
+    SECTION("Results with no insertions, when all the functions are defined")
+    {
+        dir_tree.create_file("boo.cpp",
+                             "#include \"boo.hpp\"\n"
+                             "Boo::Boo(int) {}\n"
+                             "Boo::~Boo() {}\n"
+                             "std::string Boo::name() const { return {}; }\n"
+                             "void detail::free_function(const Boo&) {}\n");
+
+        REQUIRE(apply().empty());
+    }
+
+    SECTION("Throws, when the source file doesn't include the header")
+    {
+        dir_tree.create_file("boo.cpp", "int main() {}\n");
+
+        REQUIRE_THROWS_AS(apply(), BaseError);
+    }
+}
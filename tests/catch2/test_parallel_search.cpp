@@ -0,0 +1,161 @@
+/**
+ * @file	test_parallel_search.cpp
+ * @brief	Tests the parallel search.
+ */
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "parallel_search.hpp"
+
+using namespace Tsepepe;
+
+TEST_CASE("Finds the result for the input with the lowest index", "[ParallelSearch]")
+{
+    std::vector<unsigned> inputs(64);
+    std::iota(std::begin(inputs), std::end(inputs), 0);
+
+    auto find_multiple_of{[&](unsigned divisor, unsigned workers_count) {
+        return find_first_in_parallel(
+            inputs,
+            [divisor](unsigned input) -> std::optional<unsigned> {
+                // The later inputs finish sooner, so that they are found first.
+                std::this_thread::sleep_for(std::chrono::microseconds{64 - input});
+                if (input != 0 and input % divisor == 0)
+                    return input;
+                return std::nullopt;
+            },
+            workers_count);
+    }};
+
+    SECTION("With a single worker")
+    {
+        REQUIRE(find_multiple_of(7, 1) == 7u);
+    }
+
+    SECTION("With multiple workers")
+    {
+        for (unsigned i{0}; i < 16; ++i)
+            REQUIRE(find_multiple_of(7, 8) == 7u);
+    }
+
+    SECTION("No result")
+    {
+        REQUIRE_FALSE(find_multiple_of(100, 8));
+    }
+
+    SECTION("No inputs")
+    {
+        REQUIRE_FALSE(find_first_in_parallel(std::vector<unsigned>{}, [](unsigned) { return std::optional{1}; }));
+    }
+}
+
+TEST_CASE("Jobs for the inputs past the found one are not started", "[ParallelSearch]")
+{
+    std::vector<unsigned> inputs(1000);
+    std::iota(std::begin(inputs), std::end(inputs), 0);
+    std::atomic<unsigned> started_jobs_count{0};
+
+    auto result{find_first_in_parallel(
+        inputs,
+        [&](unsigned input) -> std::optional<unsigned> {
+            ++started_jobs_count;
+            if (input == 3)
+                return input;
+            return std::nullopt;
+        },
+        4)};
+
+    REQUIRE(result == 3u);
+    REQUIRE(started_jobs_count < 1000);
+}
+
+TEST_CASE("Throwing inputs are skipped, and the exception is rethrown, when nothing is found", "[ParallelSearch]")
+{
+    std::vector<unsigned> inputs{0, 1, 2, 3, 4, 5, 6, 7};
+
+    auto search{[&](unsigned throwing_input, std::optional<unsigned> found_input) {
+        return find_first_in_parallel(
+            inputs,
+            [=](unsigned input) -> std::optional<unsigned> {
+                if (input == throwing_input)
+                    throw std::runtime_error{"Failed"};
+                if (input == found_input)
+                    return input;
+                return std::nullopt;
+            },
+            4);
+    }};
+
+    REQUIRE(search(2, 5) == 5u);
+    REQUIRE(search(5, 2) == 2u);
+    REQUIRE_THROWS_AS(search(2, std::nullopt), std::runtime_error);
+}
+
+TEST_CASE("Results of all the inputs are returned in the order of the inputs", "[ParallelSearch]")
+{
+    std::vector<unsigned> inputs(64);
+    std::iota(std::begin(inputs), std::end(inputs), 0);
+    std::atomic<unsigned> started_jobs_count{0};
+
+    auto square{[&](unsigned workers_count) {
+        return transform_in_parallel(
+            inputs,
+            [&](unsigned input) {
+                ++started_jobs_count;
+                // The later inputs finish sooner.
+                std::this_thread::sleep_for(std::chrono::microseconds{64 - input});
+                return input * input;
+            },
+            workers_count);
+    }};
+
+    std::vector<unsigned> expected_result;
+    for (auto input : inputs)
+        expected_result.push_back(input * input);
+
+    SECTION("With a single worker")
+    {
+        REQUIRE(square(1) == expected_result);
+    }
+
+    SECTION("With multiple workers")
+    {
+        for (unsigned i{0}; i < 16; ++i)
+            REQUIRE(square(8) == expected_result);
+        REQUIRE(started_jobs_count == 16 * 64);
+    }
+
+    SECTION("No inputs")
+    {
+        REQUIRE(transform_in_parallel(std::vector<unsigned>{}, [](unsigned input) { return input; }).empty());
+    }
+}
+
+TEST_CASE("All the jobs are run, and the exception for the lowest input is rethrown", "[ParallelSearch]")
+{
+    std::vector<unsigned> inputs{0, 1, 2, 3, 4, 5, 6, 7};
+    std::atomic<unsigned> started_jobs_count{0};
+
+    auto do_transform{[&]() {
+        return transform_in_parallel(
+            inputs,
+            [&](unsigned input) {
+                ++started_jobs_count;
+                if (input == 2)
+                    throw std::runtime_error{"Failed at 2"};
+                if (input == 5)
+                    throw std::logic_error{"Failed at 5"};
+                return input;
+            },
+            4);
+    }};
+
+    REQUIRE_THROWS_AS(do_transform(), std::runtime_error);
+    REQUIRE(started_jobs_count == 8);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file        test_scope_remover.cpp
+ * @brief       Tests removing the scopes from the C++ code.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "scope_remover.hpp"
+
+using namespace Tsepepe;
+
+TEST_CASE("Scope is removed from the C++ code", "[ScopeRemover]")
+{
+    SECTION("Removes the scope from all the names")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace"}};
+        REQUIRE(remover.remove_from("Namespace::Struct Namespace::foo(const Namespace::Type&);")
+                == "Struct foo(const Type&);");
+    }
+
+    SECTION("Removes the scope specified with the trailing scope resolution operator")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace::"}};
+        REQUIRE(remover.remove_from("Namespace::Struct Namespace::foo();") == "Struct foo();");
+    }
+
+    SECTION("Removes the nested scope")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace::Class"}};
+        REQUIRE(remover.remove_from("void foo(Namespace::Class::Nested, Namespace::Other);")
+                == "void foo(Nested, Namespace::Other);");
+    }
+
+    SECTION("Doesn't remove the scope from within an identifier")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace"}};
+        REQUIRE(remover.remove_from("MyNamespace::Struct Namespace_::foo();")
+                == "MyNamespace::Struct Namespace_::foo();");
+    }
+
+    SECTION("Doesn't remove the scope, which is nested within another scope")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace"}};
+        REQUIRE(remover.remove_from("Outer::Namespace::Struct Template<int>::Namespace::Type Namespace::Namespace::X")
+                == "Outer::Namespace::Struct Template<int>::Namespace::Type Namespace::X");
+    }
+
+    SECTION("Removes the global scope qualifier together with the scope")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace"}};
+        REQUIRE(remover.remove_from("::Namespace::Struct foo(std::vector<::Namespace::Type>);")
+                == "Struct foo(std::vector<Type>);");
+    }
+
+    SECTION("Matches the characters, which are special within a regex, literally")
+    {
+        ScopeRemover remover{FullyQualifiedName{"Namespace::Template<int*>"}};
+        REQUIRE(remover.remove_from("Namespace::Template<int*>::Type Namespace::Template<intt>::Type")
+                == "Type Namespace::Template<intt>::Type");
+    }
+}
+
+TEST_CASE("All nesting scopes are removed from the C++ code", "[AllScopeRemover]")
+{
+    AllScopeRemover remover{FullyQualifiedName{"Namespace::Scope1::Scope2"}};
+
+    SECTION("Removes each of the nesting scopes")
+    {
+        REQUIRE(remover.remove_from("Namespace::A(Namespace::Scope1::B, Namespace::Scope1::Scope2::C)") == "A(B, C)");
+    }
+
+    SECTION("Removes the longest matching scope")
+    {
+        REQUIRE(remover.remove_from("Namespace::Scope1::Other::D Namespace::Scope1::Scope2::Scope3::E")
+                == "Other::D Scope3::E");
+    }
+
+    SECTION("Doesn't remove the scopes on other than the token boundaries")
+    {
+        REQUIRE(remover.remove_from("MyNamespace::A Other::Namespace::B Namespace::Scope1x::C")
+                == "MyNamespace::A Other::Namespace::B Scope1x::C");
+    }
+
+    SECTION("Leaves the code unchanged, when there is no scope to remove")
+    {
+        REQUIRE(remover.remove_from("void foo(int a, std::string b);") == "void foo(int a, std::string b);");
+    }
+}
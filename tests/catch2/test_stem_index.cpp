@@ -0,0 +1,112 @@
+/**
+ * @file	test_stem_index.cpp
+ * @brief	Tests the persistent stem index.
+ */
+#include <chrono>
+#include <filesystem>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "directory_tree.hpp"
+#include "stem_index.hpp"
+
+using namespace Tsepepe;
+
+namespace fs = std::filesystem;
+
+//! The file systems may store the modification times with a coarser resolution, than the time the test takes.
+static void mark_directory_changed(const fs::path& directory)
+{
+    fs::last_write_time(directory, fs::last_write_time(directory) + std::chrono::seconds{1});
+}
+
+TEST_CASE("Stem index maps the stems to the C++ files", "[StemIndex]")
+{
+    DirectoryTree dir_tree{"temp_stem_index"};
+    auto header_path{dir_tree.create_file("include/foo.hpp", "")};
+    auto source_path{dir_tree.create_file("src/foo.cpp", "")};
+    auto nested_header_path{dir_tree.create_file("src/detail/foo.h", "")};
+    auto bar_path{dir_tree.create_file("src/bar.cpp", "")};
+    dir_tree.create_file("src/foo.txt", "");
+    dir_tree.create_file(".hidden/foo.hpp", "");
+    auto root{dir_tree.get_root_absolute_path()};
+
+    auto index{StemIndex::build(root)};
+
+    SECTION("Finds the C++ files with the stem")
+    {
+        REQUIRE_THAT(index.find("foo"),
+                     Catch::Matchers::Equals(std::vector{header_path, nested_header_path, source_path}));
+        REQUIRE_THAT(index.find("bar"), Catch::Matchers::Equals(std::vector{bar_path}));
+        REQUIRE(index.find("baz").empty());
+        REQUIRE(index.is_modified());
+    }
+
+    SECTION("Refreshed index contains the added and the renamed files")
+    {
+        auto added_path{dir_tree.create_file("include/bar.hpp", "")};
+        auto renamed_path{root / "src/baz.cpp"};
+        fs::rename(bar_path, renamed_path);
+        mark_directory_changed(root / "include");
+        mark_directory_changed(root / "src");
+
+        index.refresh();
+
+        REQUIRE_THAT(index.find("bar"), Catch::Matchers::Equals(std::vector{added_path}));
+        REQUIRE_THAT(index.find("baz"), Catch::Matchers::Equals(std::vector{renamed_path}));
+    }
+
+    SECTION("Refreshed index contains the files from the new directories, but not from the removed ones")
+    {
+        auto added_path{dir_tree.create_file("lib/nested/foo.cc", "")};
+        fs::remove_all(root / "src");
+        mark_directory_changed(root);
+
+        index.refresh();
+
+        REQUIRE_THAT(index.find("foo"), Catch::Matchers::Equals(std::vector{header_path, added_path}));
+        REQUIRE(index.find("bar").empty());
+    }
+
+    SECTION("Only the directories known to have changed are read again")
+    {
+        auto added_path{dir_tree.create_file("include/bar.hpp", "")};
+        dir_tree.create_file("src/baz.cpp", "");
+        fs::remove_all(root / "src/detail");
+
+        index.refresh({root / "include", root / "src/detail"});
+
+        REQUIRE_THAT(index.find("bar"), Catch::Matchers::Equals(std::vector{added_path, bar_path}));
+        REQUIRE_THAT(index.find("foo"), Catch::Matchers::Equals(std::vector{header_path, source_path}));
+        REQUIRE(index.find("baz").empty());
+    }
+
+    SECTION("Index is stored and loaded")
+    {
+        REQUIRE_FALSE(StemIndex::load(root));
+
+        index.save();
+        REQUIRE_FALSE(index.is_modified());
+        REQUIRE(fs::exists(root / ".tsepepe" / "stem_index"));
+
+        auto loaded{StemIndex::load(root)};
+        REQUIRE(loaded);
+        REQUIRE_THAT(loaded->find("foo"),
+                     Catch::Matchers::Equals(std::vector{header_path, nested_header_path, source_path}));
+
+        // Creating the '.tsepepe' directory changes the project root, which is then read again, but only once.
+        loaded->refresh();
+        loaded->save();
+        auto reloaded{StemIndex::load(root)};
+        REQUIRE(reloaded);
+        reloaded->refresh();
+        REQUIRE_FALSE(reloaded->is_modified());
+    }
+
+    SECTION("Index stored with another format version is not loaded")
+    {
+        dir_tree.create_file(".tsepepe/stem_index", "tsepepe-stem-index 0\n");
+        REQUIRE_FALSE(StemIndex::load(root));
+    }
+}
@@ -0,0 +1,39 @@
+/**
+ * @file        test_string_utils.cpp
+ * @brief       Tests the string utilities.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "string_utils.hpp"
+
+using namespace Tsepepe::utils;
+
+TEST_CASE("Whitespaces are stripped and collapsed", "[StringUtils]")
+{
+    SECTION("Strips the whitespaces from both ends")
+    {
+        REQUIRE(strip_and_collapse_whitespaces(" \t\n void foo(); \r\n") == "void foo();");
+    }
+
+    SECTION("Collapses the runs of multiple whitespaces to a single space")
+    {
+        REQUIRE(strip_and_collapse_whitespaces("virtual   void\n    foo(int  a,\n\t\tint b)  = 0")
+                == "virtual void foo(int a, int b) = 0");
+    }
+
+    SECTION("Keeps a single whitespace as it is")
+    {
+        REQUIRE(strip_and_collapse_whitespaces("void\nfoo(int\ta)") == "void\nfoo(int\ta)");
+    }
+
+    SECTION("Results with an empty string, when there are only whitespaces")
+    {
+        REQUIRE(strip_and_collapse_whitespaces("") == "");
+        REQUIRE(strip_and_collapse_whitespaces(" \n\t ") == "");
+    }
+
+    SECTION("Keeps the string without whitespaces as it is")
+    {
+        REQUIRE(strip_and_collapse_whitespaces("foo()") == "foo()");
+    }
+}
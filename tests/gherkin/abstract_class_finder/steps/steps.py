@@ -1,7 +1,8 @@
+import json
 import os
 import subprocess
 from behave import given, when, then
-from hamcrest import assert_that, equal_to, empty, not_
+from hamcrest import assert_that, equal_to, empty, has_item, not_
 import helpers.utils as utils
 from helpers.tool_result import ToolResult
 
@@ -52,6 +53,43 @@ def step_impl(context, class_name: str):
     )
 
 
+@when('Abstract class "{class_name}" is tried to be found, with tracing to "{trace_path}"')
+def step_impl(context, class_name: str, trace_path: str):
+    tool_path = utils.get_tool_path(context)
+    root = context.working_directory
+    cmd = [tool_path, root, root, class_name]
+    env = dict(os.environ, TSEPEPE_TRACE=os.path.join(root, trace_path))
+    cmd_result = subprocess.run(cmd, capture_output=True, env=env)
+    context.result = ToolResult(
+        cmd_result.stdout, cmd_result.stderr, cmd_result.returncode
+    )
+
+
+@when('Abstract class "{class_name}" is tried to be found, with the class index')
+def step_impl(context, class_name: str):
+    tool_path = utils.get_tool_path(context)
+    root = context.working_directory
+    cmd = [tool_path, "--index", root, root, class_name]
+    cmd_result = subprocess.run(cmd, capture_output=True)
+    context.result = ToolResult(
+        cmd_result.stdout, cmd_result.stderr, cmd_result.returncode
+    )
+
+
+@when(
+    'Abstract class "{class_name}" is tried to be found, with the class index, and tracing to "{trace_path}"'
+)
+def step_impl(context, class_name: str, trace_path: str):
+    tool_path = utils.get_tool_path(context)
+    root = context.working_directory
+    cmd = [tool_path, "--index", root, root, class_name]
+    env = dict(os.environ, TSEPEPE_TRACE=os.path.join(root, trace_path))
+    cmd_result = subprocess.run(cmd, capture_output=True, env=env)
+    context.result = ToolResult(
+        cmd_result.stdout, cmd_result.stderr, cmd_result.returncode
+    )
+
+
 @then('Path "{path}" is returned')
 def step_impl(context, path):
     stdout = utils.get_result(context).stdout.strip()
@@ -71,3 +109,25 @@ def step_impl(context):
     result = utils.get_result(context)
     assert_that(result.return_code, not_(equal_to(0)))
     assert_that(result.stderr, not_(empty()))
+
+
+@then('Trace "{trace_path}" contains spans "{span_names}"')
+def step_impl(context, trace_path: str, span_names: str):
+    with open(os.path.join(context.working_directory, trace_path)) as f:
+        trace = json.load(f)
+    recorded_span_names = [event["name"] for event in trace["traceEvents"]]
+    for name in span_names.split(", "):
+        assert_that(recorded_span_names, has_item(name))
+
+
+@then('Trace "{trace_path}" doesn\'t contain span "{span_name}"')
+def step_impl(context, trace_path: str, span_name: str):
+    with open(os.path.join(context.working_directory, trace_path)) as f:
+        trace = json.load(f)
+    recorded_span_names = [event["name"] for event in trace["traceEvents"]]
+    assert_that(recorded_span_names, not_(has_item(span_name)))
+
+
+@then('File "{path}" exists')
+def step_impl(context, path: str):
+    assert_that(os.path.exists(os.path.join(context.working_directory, path)))
@@ -73,3 +73,55 @@ Feature: Header file with abstract class definition is found
       | __pycache__/yolo.hpp      |
       | build/makapaka/yolo.hpp   |
       | build_host/masta/yolo.hpp |
+
+  Scenario: Records the processing phases, when tracing is enabled
+    Given Header file "some/dir2/the_class.hpp" with content
+      """
+      struct TheClass
+      {
+          virtual void run(unsigned int time_ms) = 0;
+          virtual ~TheClass() = default;
+      };
+      """
+    When Abstract class "TheClass" is tried to be found, with tracing to "trace.json"
+    Then Path "some/dir2/the_class.hpp" is returned
+    And Trace "trace.json" contains spans "parse_compilation_database, ripgrep, ClangTool::run"
+
+  Scenario: Indexes the project, when the class index is requested
+    Given Header file "some/dir2/the_class.hpp" with content
+      """
+      struct TheClass
+      {
+          virtual void run(unsigned int time_ms) = 0;
+          virtual ~TheClass() = default;
+      };
+      """
+    When Abstract class "TheClass" is tried to be found, with the class index
+    Then Path "some/dir2/the_class.hpp" is returned
+    And No error is raised
+    And File ".tsepepe/class_index" exists
+
+  Scenario: The indexed files are not parsed again, until they change
+    Given Header file "some/dir2/the_class.hpp" with content
+      """
+      struct TheClass
+      {
+          void run(unsigned int time_ms);
+      };
+      """
+    When Abstract class "TheClass" is tried to be found, with the class index
+    Then No match is found
+    When Abstract class "TheClass" is tried to be found, with the class index, and tracing to "trace.json"
+    Then No match is found
+    And Trace "trace.json" doesn't contain span "ClangTool::buildASTs"
+    Given Header file "some/dir2/the_class.hpp" with content
+      """
+      struct TheClass
+      {
+          virtual void run(unsigned int time_ms) = 0;
+          virtual ~TheClass() = default;
+      };
+      """
+    When Abstract class "TheClass" is tried to be found, with the class index
+    Then Path "some/dir2/the_class.hpp" is returned
+    And No error is raised
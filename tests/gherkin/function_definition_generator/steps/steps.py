@@ -1,3 +1,4 @@
+import json
 import os
 import subprocess
 from behave.runner import Context
@@ -28,6 +29,14 @@ def step_impl(context: Context, filename: str):
     context.created_files.append(file)
 
 
+@given('Source file called "{filename}" with content')
+def step_impl(context: Context, filename: str):
+    path = os.path.join(os.getcwd(), filename)
+    file = File(path, context.text + "\n")
+    file.create()
+    context.created_files.append(file)
+
+
 @when("Function definition is generated from declaration at line {line}")
 def step_impl(context, line: int):
     if len(context.created_files) == 0:
@@ -71,6 +80,50 @@ def step_impl(context, filename: str, line: int):
     )
 
 
+@when('Function definitions are generated in batch mode for "{filename}"')
+def step_impl(context, filename: str):
+    tool_path = get_tool_path(context)
+    file_path = os.path.join(os.getcwd(), filename)
+    file_content = get_file_content(file_path)
+    cmd = [
+        tool_path,
+        "--batch",
+        context.comp_db.path,
+        os.getcwd(),
+        file_path,
+        file_content,
+    ]
+    cmd_result = subprocess.run(cmd, capture_output=True)
+    context.result = ToolResult(
+        cmd_result.stdout, cmd_result.stderr, cmd_result.returncode
+    )
+
+
+@then('Definitions are inserted into "{filename}" at its end')
+def step_impl(context: Context, filename: str):
+    path = os.path.join(os.getcwd(), filename)
+    result = json.loads(get_result(context).stdout)
+    assert_that(result["file"], equal_to(path))
+    assert_that(
+        result["insertions"],
+        equal_to(
+            [
+                {
+                    "offset": len(get_file_content(path)),
+                    "code": context.text + "\n",
+                }
+            ]
+        ),
+    )
+
+
+@then('No definitions are inserted into "{filename}"')
+def step_impl(context: Context, filename: str):
+    result = json.loads(get_result(context).stdout)
+    assert_that(result["file"], equal_to(os.path.join(os.getcwd(), filename)))
+    assert_that(result["insertions"], empty())
+
+
 @then("Stdout contains")
 def step_impl(context: Context):
     expected_stdout = context.text + "\n{\n}\n"
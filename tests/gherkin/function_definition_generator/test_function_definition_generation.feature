@@ -460,3 +460,67 @@ Feature: Generates function definitions
         When Function definition is generated from declaration at line 1
         Then Error is raised
 
+
+    Scenario: Generates definitions for the entire header, in batch mode
+        Given Header file called "batch.hpp" with content
+        """
+        class Batch
+        {
+          public:
+            Batch();
+            int get() const;
+            void set(int value);
+            virtual void pure() = 0;
+        };
+        """
+        And Source file called "batch.cpp" with content
+        """
+        #include "batch.hpp"
+
+        Batch::Batch()
+        {
+        }
+        """
+        When Function definitions are generated in batch mode for "batch.hpp"
+        Then Definitions are inserted into "batch.cpp" at its end
+        """
+
+        int Batch::get() const
+        {
+        }
+
+        void Batch::set(int value)
+        {
+        }
+        """
+        And No errors are emitted
+
+
+    Scenario: Generates no definitions in batch mode, when all the functions are defined
+        Given Header file called "batch_defined.hpp" with content
+        """
+        struct BatchDefined
+        {
+            void foo();
+        };
+        """
+        And Source file called "batch_defined.cpp" with content
+        """
+        #include "batch_defined.hpp"
+        void BatchDefined::foo() {}
+        """
+        When Function definitions are generated in batch mode for "batch_defined.hpp"
+        Then No definitions are inserted into "batch_defined.cpp"
+        And No errors are emitted
+
+
+    Scenario: Raises error in batch mode, if no paired source file found
+        Given Header file called "batch_unpaired.hpp" with content
+        """
+        struct BatchUnpaired
+        {
+            void foo();
+        };
+        """
+        When Function definitions are generated in batch mode for "batch_unpaired.hpp"
+        Then Error is raised
@@ -28,6 +28,36 @@ def step_impl(context, path: str):
     )
 
 
+@when("Paired file for {path} is searched, with at most {count} match")
+def step_impl(context, path: str, count: str):
+    tool_path = get_tool_path(context)
+    project_root_dir = context.working_directory
+    cmd = [tool_path, "--max-count", count, project_root_dir, path]
+    cmd_result = subprocess.run(cmd, capture_output=True)
+    context.result = ToolResult(
+        cmd_result.stdout, cmd_result.stderr, cmd_result.returncode
+    )
+
+
+@when("Paired file for {path} is searched, with the stem index")
+def step_impl(context, path: str):
+    tool_path = get_tool_path(context)
+    project_root_dir = context.working_directory
+    cmd = [tool_path, "--index", project_root_dir, path]
+    cmd_result = subprocess.run(cmd, capture_output=True)
+    context.result = ToolResult(
+        cmd_result.stdout, cmd_result.stderr, cmd_result.returncode
+    )
+
+
+@then("Finding result is either {path1} or {path2}")
+def step_impl(context, path1: str, path2: str):
+    full_path1 = os.path.join(context.working_directory, path1)
+    full_path2 = os.path.join(context.working_directory, path2)
+    stdout = get_result(context).stdout.rstrip()
+    assert_that(stdout, any_of(full_path1, full_path2))
+
+
 @then("Finding result is {path}")
 def step_impl(context, path: str):
     expected_stdout = os.path.join(context.working_directory, path)
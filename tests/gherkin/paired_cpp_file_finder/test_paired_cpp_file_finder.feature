@@ -70,3 +70,30 @@ Feature: Finds paired C++ file
         Given C++ file under path dir/file.cpp
         When Paired file for dir/file.cpp is searched
         Then No paired file found error is raised
+
+
+  Scenario: Skips the hidden directories
+
+    Given C++ file under path dir/file.cpp
+    And C++ file under path .hidden/file.hpp
+    And C++ file under path dir_other/file.hpp
+    When Paired file for dir/file.cpp is searched
+    Then Finding result is dir_other/file.hpp
+
+  Scenario: Stops, once the maximum number of the paired files is found
+
+    Given C++ file under path dir/file.cpp
+    And C++ file under path dir_other1/file.hpp
+    And C++ file under path dir_other2/file.hxx
+    When Paired file for dir/file.cpp is searched, with at most 1 match
+    Then Finding result is either dir_other1/file.hpp or dir_other2/file.hxx
+
+  Scenario: Finds the paired files added after the stem index is built
+
+    Given C++ file under path dir/file.cpp
+    And C++ file under path dir_other1/file.hpp
+    When Paired file for dir/file.cpp is searched, with the stem index
+    Then Finding result is dir_other1/file.hpp
+    Given C++ file under path dir_other2/file.hxx
+    When Paired file for dir/file.cpp is searched
+    Then Finding results are dir_other1/file.hpp and dir_other2/file.hxx